@@ -0,0 +1,338 @@
+//
+//  AddressClassifier.cpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+#include <array>
+#include <cassert>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+ #include <immintrin.h>
+ #define CXXNETADDR_HAS_AVX2_GATHER 1
+#else
+ #define CXXNETADDR_HAS_AVX2_GATHER 0
+#endif
+
+#include "CxxUtilities.hpp"
+#include "AddressClassifier.hpp"
+
+namespace
+{
+using Category = AddressClassifier::Category;
+using Categories = AddressClassifier::Categories;
+
+//===============================================================
+// IANA IPv4 Special-Purpose Address Registry. The globally reachable
+// blocks within the IETF protocol assignments exclude ietfProtocol.
+struct IPv4Rule { std::uint32_t prefix; unsigned length; Categories categories; Categories excludes = AddressClassifier::none; };
+
+constexpr std::uint32_t v4(std::uint8_t o1, std::uint8_t o2, std::uint8_t o3, std::uint8_t o4) {
+    return (std::uint32_t(o1) << 24) | (std::uint32_t(o2) << 16) | (std::uint32_t(o3) << 8) | o4;
+}
+
+constexpr IPv4Rule kIPv4Registry[] = {
+    {v4(0, 0, 0, 0),         8,  Category::unspecified},
+    {v4(10, 0, 0, 0),        8,  Category::privateUse},
+    {v4(100, 64, 0, 0),      10, Category::sharedAddressSpace},
+    {v4(127, 0, 0, 0),       8,  Category::loopback},
+    {v4(169, 254, 0, 0),     16, Category::linkLocal},
+    {v4(172, 16, 0, 0),      12, Category::privateUse},
+    {v4(192, 0, 0, 0),       24, Category::ietfProtocol},
+    {v4(192, 0, 0, 9),       32, Category::protocolAnycast, Category::ietfProtocol},
+    {v4(192, 0, 0, 10),      32, Category::protocolAnycast, Category::ietfProtocol},
+    {v4(192, 0, 0, 170),     31, Category::nat64},
+    {v4(192, 0, 2, 0),       24, Category::documentation},
+    {v4(192, 31, 196, 0),    24, Category::as112},
+    {v4(192, 88, 99, 0),     24, Category::sixToFour},
+    {v4(192, 168, 0, 0),     16, Category::privateUse},
+    {v4(192, 175, 48, 0),    24, Category::as112},
+    {v4(198, 18, 0, 0),      15, Category::benchmarking},
+    {v4(198, 51, 100, 0),    24, Category::documentation},
+    {v4(203, 0, 113, 0),     24, Category::documentation},
+    {v4(224, 0, 0, 0),       4,  Category::multicast},
+    {v4(240, 0, 0, 0),       4,  Category::reserved},
+    {v4(255, 255, 255, 255), 32, Category::limitedBroadcast},
+};
+
+//===============================================================
+// 16-8-8 multibit trie. An entry either holds the categories of all
+// addresses below it or, if kChildFlag is set, the index of a 256
+// entry chunk of the next level.
+constexpr std::uint32_t kChildFlag = 1u << 31;
+
+class IPv4Table
+{
+public:
+    IPv4Table() {
+        root.fill(AddressClassifier::none);
+
+        // exclusions last, so that they apply regardless of the order of the rules
+        for (auto const& rule : kIPv4Registry) {
+            paint(rule.prefix, rule.length, [c = rule.categories] (std::uint32_t& entry) { entry |= c; });
+        }
+
+        for (auto const& rule : kIPv4Registry) {
+            paint(rule.prefix, rule.length, [c = rule.excludes] (std::uint32_t& entry) { entry &= ~c; });
+        }
+    }
+
+    Categories lookup(std::uint32_t addr) const noexcept {
+        auto entry = root[addr >> 16];
+
+        if ((entry & kChildFlag) != 0) {
+            entry = chunks[((entry & ~kChildFlag) << 8) | ((addr >> 8) & 0xff)];
+
+            if ((entry & kChildFlag) != 0) {
+                entry = chunks[((entry & ~kChildFlag) << 8) | (addr & 0xff)];
+            }
+        }
+
+        return entry;
+    }
+
+    std::uint32_t const* level1() const noexcept { return root.data(); }
+
+private:
+    // applies fn to the categories of all leaves below an entry
+    template <typename Fn>
+    void apply(std::uint32_t& entry, Fn const& fn) {
+        if ((entry & kChildFlag) == 0) {
+            fn(entry);
+            return;
+        }
+
+        auto const base = (entry & ~kChildFlag) << 8;
+        for (std::uint32_t i = 0; i < 256; ++i) {
+            apply(chunks[base + i], fn);
+        }
+    }
+
+    // Turns a leaf into a chunk of the next level. Takes an index rather than
+    // a reference as growing the chunks may reallocate them.
+    std::uint32_t expand(bool inRoot, std::size_t idx) {
+        auto entry = inRoot ? root[idx] : chunks[idx];
+
+        if ((entry & kChildFlag) == 0) {
+            auto const index = static_cast<std::uint32_t>(chunks.size() >> 8);
+            chunks.resize(chunks.size() + 256, entry);
+            entry = kChildFlag | index;
+            (inRoot ? root[idx] : chunks[idx]) = entry;
+        }
+
+        return (entry & ~kChildFlag) << 8;
+    }
+
+    template <typename Fn>
+    void paint(std::uint32_t prefix, unsigned length, Fn const& fn) {
+        auto const span = [] (unsigned bits, unsigned len) { return std::uint32_t(1) << (bits - len); };
+
+        if (length <= 16) {
+            for (std::uint32_t i = 0; i < span(16, length); ++i) {
+                apply(root[(prefix >> 16) + i], fn);
+            }
+            return;
+        }
+
+        auto const l2 = expand(true, prefix >> 16);
+
+        if (length <= 24) {
+            for (std::uint32_t i = 0; i < span(24, length); ++i) {
+                apply(chunks[l2 + ((prefix >> 8) & 0xff) + i], fn);
+            }
+            return;
+        }
+
+        auto const l3 = expand(false, l2 + ((prefix >> 8) & 0xff));
+
+        for (std::uint32_t i = 0; i < span(32, length); ++i) {
+            apply(chunks[l3 + (prefix & 0xff) + i], fn);
+        }
+    }
+
+    std::array<std::uint32_t, 1u << 16> root;
+    std::vector<std::uint32_t> chunks;
+};
+
+IPv4Table const& ipv4Table() {
+    static IPv4Table const table;
+    return table;
+}
+
+//===============================================================
+// IANA IPv6 Special-Purpose Address Registry (plus the multicast,
+// link-local, ULA and deprecated site-local blocks of RFC 4291/4193). As
+// for IPv4, the globally reachable blocks exclude ietfProtocol.
+struct IPv6Rule { std::uint64_t hi, lo; unsigned length; Categories categories; Categories excludes = AddressClassifier::none; };
+
+constexpr IPv6Rule kIPv6Registry[] = {
+    {0x0000000000000000ull, 0x0000000000000000ull, 128, Category::unspecified},
+    {0x0000000000000000ull, 0x0000000000000001ull, 128, Category::loopback},
+    {0x0000000000000000ull, 0x0000ffff00000000ull, 96,  Category::ipv4Mapped},
+    {0x0064ff9b00000000ull, 0x0000000000000000ull, 96,  Category::nat64},
+    {0x0064ff9b00010000ull, 0x0000000000000000ull, 48,  Category::nat64},
+    {0x0100000000000000ull, 0x0000000000000000ull, 64,  Category::discardOnly},
+    {0x2001000000000000ull, 0x0000000000000000ull, 23,  Category::ietfProtocol},
+    {0x2001000000000000ull, 0x0000000000000000ull, 32,  Category::teredo, Category::ietfProtocol},
+    {0x2001000100000000ull, 0x0000000000000001ull, 128, Category::protocolAnycast, Category::ietfProtocol},
+    {0x2001000100000000ull, 0x0000000000000002ull, 128, Category::protocolAnycast, Category::ietfProtocol},
+    {0x2001000100000000ull, 0x0000000000000003ull, 128, Category::protocolAnycast, Category::ietfProtocol},
+    {0x2001000200000000ull, 0x0000000000000000ull, 48,  Category::benchmarking},
+    {0x2001000300000000ull, 0x0000000000000000ull, 32,  Category::amt, Category::ietfProtocol},
+    {0x2001000401120000ull, 0x0000000000000000ull, 48,  Category::as112, Category::ietfProtocol},
+    {0x2001001000000000ull, 0x0000000000000000ull, 28,  Category::reserved},
+    {0x2001002000000000ull, 0x0000000000000000ull, 28,  Category::orchidV2, Category::ietfProtocol},
+    {0x2001003000000000ull, 0x0000000000000000ull, 28,  Category::droneRemoteID, Category::ietfProtocol},
+    {0x20010db800000000ull, 0x0000000000000000ull, 32,  Category::documentation},
+    {0x2002000000000000ull, 0x0000000000000000ull, 16,  Category::sixToFour},
+    {0x3fff000000000000ull, 0x0000000000000000ull, 20,  Category::documentation},
+    {0xfc00000000000000ull, 0x0000000000000000ull, 7,   Category::privateUse},
+    {0xfe80000000000000ull, 0x0000000000000000ull, 10,  Category::linkLocal},
+    {0xfec0000000000000ull, 0x0000000000000000ull, 10,  Category::reserved},
+    {0xff00000000000000ull, 0x0000000000000000ull, 8,   Category::multicast},
+};
+
+struct CompiledIPv6Rule { std::uint64_t hi, lo, maskHi, maskLo; Categories categories, excludes; };
+
+// Rules bucketed by the first octet of the address. Rules of length <= 8
+// match a whole bucket and are folded into the bucket's base categories.
+class IPv6Table
+{
+public:
+    IPv6Table() {
+        base.fill(AddressClassifier::none);
+
+        for (auto const& rule : kIPv6Registry) {
+            auto const maskHi = rule.length >= 64 ? ~std::uint64_t(0) : ~(~std::uint64_t(0) >> rule.length);
+            auto const maskLo = rule.length <= 64 ? 0 : (rule.length == 128 ? ~std::uint64_t(0) : ~(~std::uint64_t(0) >> (rule.length - 64)));
+            auto const first = static_cast<std::size_t>(rule.hi >> 56);
+
+            if (rule.length <= 8) {
+                for (std::size_t i = 0; i < (std::size_t(1) << (8 - rule.length)); ++i) {
+                    base[first + i] |= rule.categories;
+                }
+            } else {
+                buckets[first].push_back({rule.hi, rule.lo, maskHi, maskLo, rule.categories, rule.excludes});
+            }
+        }
+    }
+
+    Categories lookup(std::uint64_t hi, std::uint64_t lo) const noexcept {
+        auto const first = static_cast<std::size_t>(hi >> 56);
+        auto result = base[first];
+        Categories excluded = AddressClassifier::none;
+
+        for (auto const& rule : buckets[first]) {
+            if ((hi & rule.maskHi) == rule.hi && (lo & rule.maskLo) == rule.lo) {
+                result |= rule.categories;
+                excluded |= rule.excludes;
+            }
+        }
+
+        return result & ~excluded;
+    }
+
+private:
+    std::array<Categories, 256> base;
+    std::array<std::vector<CompiledIPv6Rule>, 256> buckets;
+};
+
+IPv6Table const& ipv6Table() {
+    static IPv6Table const table;
+    return table;
+}
+
+std::uint64_t load64(std::uint8_t const* p) noexcept {
+    std::uint64_t v = 0;
+    for (int i = 0; i < 8; ++i) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+#if CXXNETADDR_HAS_AVX2_GATHER
+__attribute__((target("avx2")))
+void classifyIPv4AVX2(IPv4Table const& table, std::uint32_t const* in, Categories* out, std::size_t n) noexcept {
+    auto const* root = reinterpret_cast<int const*>(table.level1());
+    auto const childFlag = _mm256_set1_epi32(static_cast<int>(kChildFlag));
+    std::size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        auto const addrs = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(in + i));
+        auto const entries = _mm256_i32gather_epi32(root, _mm256_srli_epi32(addrs, 16), 4);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), entries);
+
+        // only the few /16s with longer prefixes need to descend the trie
+        if (! _mm256_testz_si256(entries, childFlag)) {
+            for (std::size_t l = 0; l < 8; ++l) {
+                if ((out[i + l] & kChildFlag) != 0) {
+                    out[i + l] = table.lookup(in[i + l]);
+                }
+            }
+        }
+    }
+
+    for (; i < n; ++i) {
+        out[i] = table.lookup(in[i]);
+    }
+}
+#endif
+}
+
+//===============================================================
+AddressClassifier::Categories AddressClassifier::classifyIPv4(std::uint32_t saddr) noexcept {
+    return ipv4Table().lookup(saddr);
+}
+
+AddressClassifier::Categories AddressClassifier::classifyIPv6(::in6_addr const& addr) noexcept {
+    auto const hi = load64(addr.s6_addr);
+    auto const lo = load64(addr.s6_addr + 8);
+    auto result = ipv6Table().lookup(hi, lo);
+
+    if ((result & ipv4Mapped) != 0) {
+        result |= classifyIPv4(static_cast<std::uint32_t>(lo));
+    }
+
+    return result;
+}
+
+AddressClassifier::Categories AddressClassifier::classify(NetworkAddress const& addr) noexcept {
+    switch (addr.family()) {
+    case NetworkAddress::Family::ipv4: return classifyIPv4(cxxutils::byteswap(addr.get_sin_addr().s_addr));
+    case NetworkAddress::Family::ipv6: return classifyIPv6(addr.get_sin6_addr());
+    default: break;
+    }
+
+    return none;
+}
+
+void AddressClassifier::classifyIPv4(std::span<std::uint32_t const> saddrs, std::span<Categories> out) noexcept {
+    assert(saddrs.size() == out.size());
+    auto const& table = ipv4Table();
+
+   #if CXXNETADDR_HAS_AVX2_GATHER
+    static auto const hasAVX2 = __builtin_cpu_supports("avx2");
+
+    if (hasAVX2) {
+        classifyIPv4AVX2(table, saddrs.data(), out.data(), saddrs.size());
+        return;
+    }
+   #endif
+
+    for (std::size_t i = 0; i < saddrs.size(); ++i) {
+        out[i] = table.lookup(saddrs[i]);
+    }
+}
+
+void AddressClassifier::classify(std::span<NetworkAddress const> addrs, std::span<Categories> out) noexcept {
+    assert(addrs.size() == out.size());
+
+    for (std::size_t i = 0; i < addrs.size(); ++i) {
+        out[i] = classify(addrs[i]);
+    }
+}
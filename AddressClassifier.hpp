@@ -0,0 +1,128 @@
+//
+//  AddressClassifier.hpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+#pragma once
+#include <cstdint>
+#include <span>
+
+#include <netinet/in.h>
+
+#include "NetworkAddress.hpp"
+
+/**
+ * @class AddressClassifier
+ * @brief Classifies IP addresses according to the IANA special-purpose
+ *        address registries (RFC 6890 and its updates).
+ *
+ * The registries are compiled into lookup tables on first use: a
+ * 16-8-8 multibit trie for IPv4 and a table of rules bucketed by the
+ * first octet for IPv6. An address may belong to several categories
+ * (e.g. 2001:2::1 is both ietfProtocol and benchmarking), so the result
+ * is a bitmask of all matching categories.
+ */
+class AddressClassifier
+{
+public:
+    //===============================================================
+    /**
+     * @enum Category
+     * @brief Special-purpose address categories. Combined as a bitmask.
+     */
+    enum Category : std::uint32_t
+    {
+        none               = 0,
+        unspecified        = 1u << 0,  /**< 0.0.0.0/8 ("this network"), ::/128 */
+        loopback           = 1u << 1,  /**< 127.0.0.0/8, ::1/128 */
+        privateUse         = 1u << 2,  /**< RFC 1918, fc00::/7 (ULA) */
+        sharedAddressSpace = 1u << 3,  /**< 100.64.0.0/10 (CGNAT) */
+        linkLocal          = 1u << 4,  /**< 169.254.0.0/16, fe80::/10 */
+        documentation      = 1u << 5,  /**< TEST-NET-1/2/3, 2001:db8::/32, 3fff::/20 */
+        benchmarking       = 1u << 6,  /**< 198.18.0.0/15, 2001:2::/48 */
+        reserved           = 1u << 7,  /**< 240.0.0.0/4, deprecated site-local and ORCHID */
+        multicast          = 1u << 8,  /**< 224.0.0.0/4, ff00::/8 */
+        limitedBroadcast   = 1u << 9,  /**< 255.255.255.255/32 */
+        ietfProtocol       = 1u << 10, /**< 192.0.0.0/24, 2001::/23, except the globally reachable blocks below */
+        sixToFour          = 1u << 11, /**< 2002::/16, 192.88.99.0/24 */
+        teredo             = 1u << 12, /**< 2001::/32 */
+        nat64              = 1u << 13, /**< 64:ff9b::/96, 64:ff9b:1::/48, 192.0.0.170/31 */
+        ipv4Mapped         = 1u << 14, /**< ::ffff:0:0/96 */
+        discardOnly        = 1u << 15, /**< 100::/64 */
+        protocolAnycast    = 1u << 16, /**< 192.0.0.9/32, 192.0.0.10/32, 2001:1::1/128 to 2001:1::3/128 */
+        amt                = 1u << 17, /**< 2001:3::/32 */
+        as112              = 1u << 18, /**< 192.31.196.0/24, 192.175.48.0/24, 2001:4:112::/48 */
+        orchidV2           = 1u << 19, /**< 2001:20::/28 */
+        droneRemoteID      = 1u << 20, /**< 2001:30::/28 */
+
+        /** Addresses which must never appear as the source of packets
+            arriving from the public internet. The blocks which the IANA
+            registries list as globally reachable are not included. */
+        bogon = unspecified | loopback | privateUse | sharedAddressSpace | linkLocal | documentation
+              | benchmarking | reserved | multicast | limitedBroadcast | ietfProtocol | discardOnly
+    };
+
+    using Categories = std::uint32_t;
+
+    //===============================================================
+    /**
+     * @brief Classifies an address.
+     *
+     * The categories of the embedded IPv4 address are included for
+     * IPv4-mapped IPv6 addresses. Non-IP addresses have no categories.
+     *
+     * @param addr The address to classify.
+     * @return A bitmask of Category values.
+     */
+    static Categories classify(NetworkAddress const& addr) noexcept;
+
+    /**
+     * @brief Classifies an IPv4 address.
+     *
+     * @param saddr The IPv4 address in host byte order.
+     * @return A bitmask of Category values.
+     */
+    static Categories classifyIPv4(std::uint32_t saddr) noexcept;
+
+    /**
+     * @brief Classifies an IPv6 address.
+     *
+     * @param addr The IPv6 address.
+     * @return A bitmask of Category values.
+     */
+    static Categories classifyIPv6(::in6_addr const& addr) noexcept;
+
+    //===============================================================
+    /**
+     * @brief Classifies a batch of IPv4 addresses.
+     *
+     * Uses AVX2 gathers for the first trie level if supported by the CPU.
+     *
+     * @param saddrs The IPv4 addresses in host byte order.
+     * @param out The categories of each address. Must be the same size as saddrs.
+     */
+    static void classifyIPv4(std::span<std::uint32_t const> saddrs, std::span<Categories> out) noexcept;
+
+    /**
+     * @brief Classifies a batch of addresses.
+     *
+     * @param addrs The addresses to classify.
+     * @param out The categories of each address. Must be the same size as addrs.
+     */
+    static void classify(std::span<NetworkAddress const> addrs, std::span<Categories> out) noexcept;
+
+    //===============================================================
+    /**
+     * @brief Checks if an address is a bogon, i.e. in any of the
+     *        categories of Category::bogon.
+     *
+     * @param addr The address to check.
+     * @return True if the address is a bogon.
+     */
+    static bool isBogon(NetworkAddress const& addr) noexcept { return (classify(addr) & bogon) != 0; }
+};
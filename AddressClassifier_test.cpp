@@ -0,0 +1,121 @@
+//
+//  AddressClassifier_test.cpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+#include <gtest/gtest.h>
+#include <random>
+
+#include "AddressClassifier.hpp"
+
+namespace
+{
+AddressClassifier::Categories classify(std::string const& ip) {
+    return AddressClassifier::classify(*NetworkAddress::fromIPString(ip, 0, false));
+}
+}
+
+// Test the IPv4 special-purpose blocks
+TEST(AddressClassifierTest, ClassifiesIPv4) {
+    EXPECT_EQ(classify("0.1.2.3"),         AddressClassifier::unspecified);
+    EXPECT_EQ(classify("127.0.0.1"),       AddressClassifier::loopback);
+    EXPECT_EQ(classify("10.1.2.3"),        AddressClassifier::privateUse);
+    EXPECT_EQ(classify("172.31.255.255"),  AddressClassifier::privateUse);
+    EXPECT_EQ(classify("172.32.0.0"),      AddressClassifier::none);
+    EXPECT_EQ(classify("192.168.1.1"),     AddressClassifier::privateUse);
+    EXPECT_EQ(classify("100.64.0.1"),      AddressClassifier::sharedAddressSpace);
+    EXPECT_EQ(classify("100.128.0.1"),     AddressClassifier::none);
+    EXPECT_EQ(classify("169.254.1.1"),     AddressClassifier::linkLocal);
+    EXPECT_EQ(classify("192.0.2.1"),       AddressClassifier::documentation);
+    EXPECT_EQ(classify("198.51.100.7"),    AddressClassifier::documentation);
+    EXPECT_EQ(classify("203.0.113.9"),     AddressClassifier::documentation);
+    EXPECT_EQ(classify("198.19.255.1"),    AddressClassifier::benchmarking);
+    EXPECT_EQ(classify("224.0.0.251"),     AddressClassifier::multicast);
+    EXPECT_EQ(classify("240.0.0.1"),       AddressClassifier::reserved);
+    EXPECT_EQ(classify("255.255.255.255"), AddressClassifier::reserved | AddressClassifier::limitedBroadcast);
+    EXPECT_EQ(classify("192.0.0.1"),       AddressClassifier::ietfProtocol);
+    EXPECT_EQ(classify("192.0.0.171"),     AddressClassifier::ietfProtocol | AddressClassifier::nat64);
+    EXPECT_EQ(classify("192.0.0.172"),     AddressClassifier::ietfProtocol);
+    EXPECT_EQ(classify("192.0.0.8"),       AddressClassifier::ietfProtocol);
+    EXPECT_EQ(classify("192.0.0.9"),       AddressClassifier::protocolAnycast);
+    EXPECT_EQ(classify("192.0.0.10"),      AddressClassifier::protocolAnycast);
+    EXPECT_EQ(classify("192.0.0.11"),      AddressClassifier::ietfProtocol);
+    EXPECT_EQ(classify("192.31.196.1"),    AddressClassifier::as112);
+    EXPECT_EQ(classify("192.175.48.6"),    AddressClassifier::as112);
+    EXPECT_EQ(classify("8.8.8.8"),         AddressClassifier::none);
+}
+
+// Test the IPv6 special-purpose blocks
+TEST(AddressClassifierTest, ClassifiesIPv6) {
+    EXPECT_EQ(classify("::"),                 AddressClassifier::unspecified);
+    EXPECT_EQ(classify("::1"),                AddressClassifier::loopback);
+    EXPECT_EQ(classify("::ffff:8.8.8.8"),     AddressClassifier::ipv4Mapped);
+    EXPECT_EQ(classify("::ffff:10.0.0.1"),    AddressClassifier::ipv4Mapped | AddressClassifier::privateUse);
+    EXPECT_EQ(classify("64:ff9b::1.2.3.4"),   AddressClassifier::nat64);
+    EXPECT_EQ(classify("100::1"),             AddressClassifier::discardOnly);
+    EXPECT_EQ(classify("2001::1"),            AddressClassifier::teredo);
+    EXPECT_EQ(classify("2001:1::1"),          AddressClassifier::protocolAnycast);
+    EXPECT_EQ(classify("2001:1::3"),          AddressClassifier::protocolAnycast);
+    EXPECT_EQ(classify("2001:1::4"),          AddressClassifier::ietfProtocol);
+    EXPECT_EQ(classify("2001:2::1"),          AddressClassifier::ietfProtocol | AddressClassifier::benchmarking);
+    EXPECT_EQ(classify("2001:3::1"),          AddressClassifier::amt);
+    EXPECT_EQ(classify("2001:4:112::1"),      AddressClassifier::as112);
+    EXPECT_EQ(classify("2001:4:113::1"),      AddressClassifier::ietfProtocol);
+    EXPECT_EQ(classify("2001:10::1"),         AddressClassifier::ietfProtocol | AddressClassifier::reserved);
+    EXPECT_EQ(classify("2001:20::1"),         AddressClassifier::orchidV2);
+    EXPECT_EQ(classify("2001:30::1"),         AddressClassifier::droneRemoteID);
+    EXPECT_EQ(classify("2001:1ff::1"),        AddressClassifier::ietfProtocol);
+    EXPECT_EQ(classify("2001:200::1"),        AddressClassifier::none);
+    EXPECT_EQ(classify("2001:db8::1"),        AddressClassifier::documentation);
+    EXPECT_EQ(classify("3fff:fff::1"),        AddressClassifier::documentation);
+    EXPECT_EQ(classify("2002:c000:204::1"),   AddressClassifier::sixToFour);
+    EXPECT_EQ(classify("fd12:3456::1"),       AddressClassifier::privateUse);
+    EXPECT_EQ(classify("fe80::1"),            AddressClassifier::linkLocal);
+    EXPECT_EQ(classify("ff02::1"),            AddressClassifier::multicast);
+    EXPECT_EQ(classify("2606:4700::1111"),    AddressClassifier::none);
+}
+
+// Test bogon filtering
+TEST(AddressClassifierTest, DetectsBogons) {
+    EXPECT_TRUE(AddressClassifier::isBogon(NetworkAddress(10, 0, 0, 1)));
+    EXPECT_TRUE(AddressClassifier::isBogon(NetworkAddress(0xfe80, 0, 0, 0, 0, 0, 0, 1)));
+    EXPECT_FALSE(AddressClassifier::isBogon(NetworkAddress(8, 8, 8, 8)));
+    EXPECT_FALSE(AddressClassifier::isBogon(NetworkAddress(0x2002, 0xc000, 0x0204, 0, 0, 0, 0, 1)));
+    EXPECT_FALSE(AddressClassifier::isBogon(NetworkAddress(0x00, 0x1A, 0x2B, 0x3C, 0x4D, 0x5E)));
+}
+
+// Test that the globally reachable special-purpose blocks are not bogons
+TEST(AddressClassifierTest, ReachableBlocksAreNoBogons) {
+    for (auto const* ip : {"192.0.0.9", "192.0.0.10", "192.31.196.1", "192.175.48.1", "2001::1", "2001:0:4136:e378::1",
+                           "2001:1::1", "2001:1::2", "2001:1::3", "2001:3::1", "2001:4:112::1", "2001:20::1", "2001:30::1"}) {
+        EXPECT_FALSE(AddressClassifier::isBogon(*NetworkAddress::fromIPString(ip, 0, false))) << ip;
+    }
+
+    for (auto const* ip : {"192.0.0.1", "192.0.0.8", "192.0.0.11", "192.0.0.170", "2001:1::4", "2001:2::1", "2001:4:113::1",
+                           "2001:10::1", "2001:40::1"}) {
+        EXPECT_TRUE(AddressClassifier::isBogon(*NetworkAddress::fromIPString(ip, 0, false))) << ip;
+    }
+}
+
+// Test that the batch variant matches the scalar lookup
+TEST(AddressClassifierTest, BatchMatchesScalar) {
+    std::mt19937 rng(1);
+    std::vector<std::uint32_t> addrs(1003);
+
+    for (auto& a : addrs) {
+        // bias towards the interesting 192.0.0.0/16 block
+        a = (rng() % 2 == 0 ? static_cast<std::uint32_t>(rng()) : (0xc0000000u | (rng() & 0xffff)));
+    }
+
+    std::vector<AddressClassifier::Categories> out(addrs.size());
+    AddressClassifier::classifyIPv4(addrs, out);
+
+    for (std::size_t i = 0; i < addrs.size(); ++i) {
+        ASSERT_EQ(out[i], AddressClassifier::classifyIPv4(addrs[i]));
+    }
+}
@@ -0,0 +1,412 @@
+//
+//  AddressGenerator.cpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <optional>
+
+#include "AddressGenerator.hpp"
+#include "CxxUtilities.hpp"
+#include "NetworkInterface.hpp"
+
+namespace
+{
+using Key = unsigned __int128;
+
+std::uint64_t splitmix64(std::uint64_t& state) noexcept {
+    auto z = (state += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+//===============================================================
+// Eight independent xorshift128+ streams stored as structure of arrays.
+// The refill loop has no dependencies between lanes and is vectorized by
+// the compiler; with AVX2 four lanes are processed per instruction.
+class RandomStream
+{
+public:
+    static constexpr std::size_t kLanes = 8;
+    static constexpr std::size_t kBlockSize = 512;
+
+    void seed(std::uint64_t seed) noexcept {
+        for (std::size_t i = 0; i < kLanes; ++i) {
+            s0[i] = splitmix64(seed);
+            s1[i] = splitmix64(seed) | 1;
+        }
+
+        pos = kBlockSize;
+    }
+
+    std::uint64_t next() noexcept {
+        if (pos == kBlockSize) {
+            refill();
+        }
+
+        return block[pos++];
+    }
+
+    // uniform double in [0, 1)
+    double nextDouble() noexcept { return static_cast<double>(next() >> 11) * 0x1.0p-53; }
+
+private:
+    __attribute__((always_inline)) static inline void refillBlock(std::uint64_t* __restrict a, std::uint64_t* __restrict b,
+                                                                  std::uint64_t* __restrict out) noexcept {
+        for (std::size_t j = 0; j < kBlockSize; j += kLanes) {
+            for (std::size_t i = 0; i < kLanes; ++i) {
+                auto x = a[i];
+                auto const y = b[i];
+                a[i] = y;
+                x ^= x << 23;
+                b[i] = x ^ y ^ (x >> 17) ^ (y >> 26);
+                out[j + i] = b[i] + y;
+            }
+        }
+    }
+
+#if defined(__x86_64__)
+    __attribute__((target("avx2")))
+    static void refillAVX2(std::uint64_t* a, std::uint64_t* b, std::uint64_t* out) noexcept { refillBlock(a, b, out); }
+#endif
+
+    void refill() noexcept {
+#if defined(__x86_64__)
+        static auto const hasAVX2 = __builtin_cpu_supports("avx2");
+
+        if (hasAVX2) {
+            refillAVX2(s0.data(), s1.data(), block.data());
+        } else {
+            refillBlock(s0.data(), s1.data(), block.data());
+        }
+#else
+        refillBlock(s0.data(), s1.data(), block.data());
+#endif
+        pos = 0;
+    }
+
+    alignas(32) std::array<std::uint64_t, kLanes> s0 = {}, s1 = {};
+    alignas(32) std::array<std::uint64_t, kBlockSize> block = {};
+    std::size_t pos = kBlockSize;
+};
+
+//===============================================================
+// Rejection-inversion sampling of a Zipf distribution over [1, n]
+// (W. Hörmann, G. Derflinger: "Rejection-inversion to generate variates
+// from monotone discrete distributions", 1996). Constant time per sample
+// and no tables, so the population can be arbitrarily large.
+class ZipfSampler
+{
+public:
+    ZipfSampler(std::uint64_t populationSize, double exp) : n(static_cast<double>(populationSize)), exponent(exp) {
+        hIntegralX1 = hIntegral(1.5) - 1.0;
+        hIntegralN = hIntegral(n + 0.5);
+        s = 2.0 - hIntegralInverse(hIntegral(2.5) - h(2.0));
+    }
+
+    std::uint64_t operator()(RandomStream& rng) const noexcept {
+        while (true) {
+            auto const u = hIntegralN + rng.nextDouble() * (hIntegralX1 - hIntegralN);
+            auto const x = hIntegralInverse(u);
+            auto const k = std::clamp(std::floor(x + 0.5), 1.0, n);
+
+            if (k - x <= s || u >= hIntegral(k + 0.5) - h(k)) {
+                return static_cast<std::uint64_t>(k);
+            }
+        }
+    }
+
+private:
+    static double helper1(double x) noexcept { return std::abs(x) > 1e-8 ? std::log1p(x) / x : 1.0 - x * (0.5 - x * (1.0 / 3.0 - 0.25 * x)); }
+    static double helper2(double x) noexcept { return std::abs(x) > 1e-8 ? std::expm1(x) / x : 1.0 + x * 0.5 * (1.0 + x / 3.0 * (1.0 + 0.25 * x)); }
+
+    double h(double x) const noexcept { return std::exp(-exponent * std::log(x)); }
+
+    double hIntegral(double x) const noexcept {
+        auto const logX = std::log(x);
+        return helper2((1.0 - exponent) * logX) * logX;
+    }
+
+    double hIntegralInverse(double x) const noexcept {
+        auto t = x * (1.0 - exponent);
+        t = std::max(t, -1.0);
+        return std::exp(helper1(t) * x);
+    }
+
+    double n, exponent, hIntegralX1 = 0.0, hIntegralN = 0.0, s = 0.0;
+};
+
+//===============================================================
+// Vose's alias method: picks an index with the given weights from a
+// single 64-bit random number.
+class AliasTable
+{
+public:
+    AliasTable() = default;
+
+    explicit AliasTable(std::vector<double> const& weights) : threshold(weights.size()), alias(weights.size()) {
+        auto const n = weights.size();
+        auto const total = std::max(std::accumulate(weights.begin(), weights.end(), 0.0), std::numeric_limits<double>::min());
+        std::vector<double> scaled(n);
+        std::vector<std::uint32_t> small, large;
+
+        for (std::size_t i = 0; i < n; ++i) {
+            scaled[i] = weights[i] * static_cast<double>(n) / total;
+            (scaled[i] < 1.0 ? small : large).push_back(static_cast<std::uint32_t>(i));
+        }
+
+        while (! small.empty() && ! large.empty()) {
+            auto const s = small.back(); small.pop_back();
+            auto const l = large.back();
+
+            threshold[s] = static_cast<std::uint64_t>(scaled[s] * 0x1.0p32);
+            alias[s] = l;
+            scaled[l] -= 1.0 - scaled[s];
+
+            if (scaled[l] < 1.0) {
+                large.pop_back();
+                small.push_back(l);
+            }
+        }
+
+        for (auto i : large) { threshold[i] = std::uint64_t(1) << 32; alias[i] = i; }
+        for (auto i : small) { threshold[i] = std::uint64_t(1) << 32; alias[i] = i; }
+    }
+
+    std::size_t operator()(std::uint64_t r) const noexcept {
+        auto const i = static_cast<std::size_t>(((r & 0xffffffffu) * threshold.size()) >> 32);
+        return (r >> 32) < threshold[i] ? i : alias[i];
+    }
+
+private:
+    std::vector<std::uint64_t> threshold;
+    std::vector<std::uint32_t> alias;
+};
+
+//===============================================================
+Key keyOf(NetworkAddress const& addr) noexcept {
+    if (addr.family() == NetworkAddress::Family::ipv4) {
+        return cxxutils::byteswap(addr.get_sin_addr().s_addr);
+    }
+
+    Key key = 0;
+    for (auto octet : addr.get_sin6_addr().s6_addr) {
+        key = (key << 8) | octet;
+    }
+
+    return key;
+}
+
+Key lowBits(unsigned bits) noexcept {
+    return bits == 0 ? 0 : (~Key(0) >> (128 - bits));
+}
+
+void writeIPv6(::in6_addr& dst, Key key) noexcept {
+    for (int i = 15; i >= 0; --i, key >>= 8) {
+        dst.s6_addr[i] = static_cast<std::uint8_t>(key);
+    }
+}
+}
+
+//===============================================================
+struct AddressGenerator::Impl
+{
+    struct Prefix
+    {
+        Key base, mask;
+        unsigned hostBits;
+        bool isIPv6;
+        std::uint32_t scopeId;
+        std::uint64_t multiplier;  // odd, scatters Zipf ranks over the prefix
+        std::optional<ZipfSampler> zipf;
+    };
+
+    struct Cluster
+    {
+        std::size_t prefix;
+        Key base, mask;
+    };
+
+    struct Sample
+    {
+        Prefix const* prefix;
+        Key key;
+    };
+
+    Impl(Options opts) : options(std::move(opts)) {
+        std::vector<double> weights;
+
+        for (std::size_t i = 0; i < options.prefixes.size(); ++i) {
+            auto const& p = options.prefixes[i];
+
+            if (! p.valid()) {
+                continue;
+            }
+
+            auto const isIPv6 = p.family() == NetworkAddress::Family::ipv6;
+            auto const hostBits = (isIPv6 ? 128u : 32u) - p.length();
+            auto const intf = isIPv6 ? p.address().interface() : std::nullopt;
+
+            prefixes.push_back({keyOf(p.address()), lowBits(hostBits), hostBits, isIPv6, intf ? intf->getIndex() : 0u, 1, {}});
+            weights.push_back(i < options.weights.size() ? options.weights[i] : std::ldexp(1.0, static_cast<int>(hostBits)));
+            hasIPv6 = hasIPv6 || isIPv6;
+        }
+
+        if (prefixes.empty()) {
+            prefixes.push_back({0, lowBits(32), 32, false, 0, 1, {}});
+            weights.push_back(1.0);
+        }
+
+        selector = AliasTable(weights);
+        portRange = static_cast<std::uint64_t>(std::max(options.minPort, options.maxPort) - options.minPort) + 1;
+
+        // Derive all per-generator structure from a separate stream so that
+        // reseed() only changes the sequence, not the population.
+        std::uint64_t structureSeed = options.seed ^ 0x5bd1e9955bd1e995ull;
+
+        for (auto& p : prefixes) {
+            p.multiplier = splitmix64(structureSeed) | 1;
+
+            if (options.distribution == Distribution::zipf) {
+                auto const size = p.hostBits >= 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << p.hostBits);
+                p.zipf.emplace(std::clamp<std::uint64_t>(options.zipfPopulation, 1, size), options.zipfExponent);
+            }
+        }
+
+        if (options.distribution == Distribution::clustered) {
+            for (std::size_t i = 0; i < std::max<std::size_t>(options.clusterCount, 1); ++i) {
+                auto const idx = selector(splitmix64(structureSeed));
+                auto const& p = prefixes[idx];
+                auto const clusterMask = lowBits(std::min(options.clusterHostBits, p.hostBits));
+                auto const hi = splitmix64(structureSeed);
+                auto const offset = (Key(hi) << 64) | splitmix64(structureSeed);
+                clusters.push_back({idx, p.base | (offset & p.mask & ~clusterMask), clusterMask});
+            }
+        }
+
+        rng.seed(options.seed);
+    }
+
+    Key randomBits(unsigned bits) noexcept {
+        Key r = rng.next();
+
+        if (bits > 64) {
+            r |= Key(rng.next()) << 64;
+        }
+
+        return r;
+    }
+
+    Sample next() noexcept {
+        switch (options.distribution) {
+        case Distribution::zipf:
+        {
+            auto const& p = prefixes[selector(rng.next())];
+            auto const rank = (*p.zipf)(rng) - 1;
+            return {&p, p.base | ((Key(rank) * p.multiplier) & p.mask)};
+        }
+        case Distribution::clustered:
+        {
+            auto const& c = clusters[static_cast<std::size_t>(((rng.next() & 0xffffffffu) * clusters.size()) >> 32)];
+            return {&prefixes[c.prefix], c.base | (Key(rng.next()) & c.mask)};
+        }
+        case Distribution::uniform:
+        default:
+        {
+            auto const& p = prefixes[selector(rng.next())];
+            return {&p, p.base | (randomBits(p.hostBits) & p.mask)};
+        }
+        }
+    }
+
+    std::uint16_t nextPort() noexcept {
+        return static_cast<std::uint16_t>(options.minPort + (((rng.next() & 0xffffffffu) * portRange) >> 32));
+    }
+
+    Options options;
+    std::vector<Prefix> prefixes;
+    std::vector<Cluster> clusters;
+    AliasTable selector;
+    std::uint64_t portRange = 1;
+    bool hasIPv6 = false;
+    RandomStream rng;
+};
+
+//===============================================================
+AddressGenerator::AddressGenerator() : AddressGenerator(Options()) {}
+AddressGenerator::AddressGenerator(Options options) : impl(std::make_unique<Impl>(std::move(options))) {}
+AddressGenerator::~AddressGenerator() = default;
+AddressGenerator::AddressGenerator(AddressGenerator&&) = default;
+AddressGenerator& AddressGenerator::operator=(AddressGenerator&&) = default;
+
+void AddressGenerator::reseed(std::uint64_t seed) {
+    impl->rng.seed(seed);
+}
+
+void AddressGenerator::generate(std::span<std::uint32_t> saddrs, std::span<std::uint16_t> ports) {
+    assert(! impl->hasIPv6);
+    assert(ports.empty() || ports.size() == saddrs.size());
+
+    for (std::size_t i = 0; i < saddrs.size(); ++i) {
+        saddrs[i] = static_cast<std::uint32_t>(impl->next().key);
+
+        if (! ports.empty()) {
+            ports[i] = impl->nextPort();
+        }
+    }
+}
+
+void AddressGenerator::generate(std::span<::sockaddr_in> out) {
+    assert(! impl->hasIPv6);
+
+    for (auto& sin : out) {
+        std::memset(&sin, 0, sizeof(sin));
+        sin.sin_family = AF_INET;
+        sin.sin_addr.s_addr = cxxutils::byteswap(static_cast<std::uint32_t>(impl->next().key));
+        sin.sin_port = cxxutils::byteswap(impl->nextPort());
+    }
+}
+
+void AddressGenerator::generate(std::span<::sockaddr_in6> out) {
+    for (auto& sin6 : out) {
+        auto const sample = impl->next();
+
+        std::memset(&sin6, 0, sizeof(sin6));
+        sin6.sin6_family = AF_INET6;
+        sin6.sin6_scope_id = sample.prefix->scopeId;
+        writeIPv6(sin6.sin6_addr, sample.prefix->isIPv6 ? sample.key : ((Key(0xffff) << 32) | sample.key));
+        sin6.sin6_port = cxxutils::byteswap(impl->nextPort());
+    }
+}
+
+void AddressGenerator::generate(std::span<NetworkAddress> out) {
+    for (auto& addr : out) {
+        auto const sample = impl->next();
+        auto const port = impl->nextPort();
+
+        if (! sample.prefix->isIPv6) {
+            addr = NetworkAddress(static_cast<std::uint32_t>(sample.key), port);
+            continue;
+        }
+
+        ::sockaddr_in6 sin6;
+        std::memset(&sin6, 0, sizeof(sin6));
+        sin6.sin6_family = AF_INET6;
+        sin6.sin6_scope_id = sample.prefix->scopeId;
+        sin6.sin6_port = cxxutils::byteswap(port);
+        writeIPv6(sin6.sin6_addr, sample.key);
+        addr = NetworkAddress::fromPOSIXSocketAddress(reinterpret_cast<::sockaddr const&>(sin6), sizeof(sin6));
+    }
+}
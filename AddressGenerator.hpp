@@ -0,0 +1,153 @@
+//
+//  AddressGenerator.hpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include <netinet/in.h>
+
+#include "NetworkAddress.hpp"
+#include "NetworkPrefix.hpp"
+
+/**
+ * @class AddressGenerator
+ * @brief Generates large batches of synthetic source addresses and ports
+ *        for load testing.
+ *
+ * Addresses are drawn from a set of weighted prefixes following one of
+ * several distributions. Random numbers come from eight interleaved
+ * xorshift128+ streams which are refilled in blocks, so the compiler can
+ * vectorize the generator. The output is fully determined by the seed.
+ *
+ * An AddressGenerator must not be used from several threads at once;
+ * use one generator (with a different seed) per thread instead.
+ */
+class AddressGenerator
+{
+public:
+    //===============================================================
+    /**
+     * @enum Distribution
+     * @brief How addresses are picked within a prefix.
+     */
+    enum class Distribution
+    {
+        uniform,   /**< Every address of the prefix is equally likely. */
+        zipf,      /**< A fixed population of addresses with Zipfian popularity. */
+        clustered  /**< Uniformly random hosts within a set of small clusters (e.g. /24s). */
+    };
+
+    /** Options of the generator. */
+    struct Options
+    {
+        /** The prefixes to draw addresses from. The whole IPv4 address
+            space is used if empty. */
+        std::vector<NetworkPrefix> prefixes = {};
+
+        /** The relative weight of each prefix. If empty, prefixes are
+            weighted by their number of addresses. */
+        std::vector<double> weights = {};
+
+        Distribution distribution = Distribution::uniform;
+
+        /** The exponent of the Zipf distribution. */
+        double zipfExponent = 1.0;
+
+        /** The number of distinct addresses per prefix for the Zipf
+            distribution (capped at the prefix size). */
+        std::uint64_t zipfPopulation = 1u << 20;
+
+        /** The number of clusters for the clustered distribution. */
+        std::size_t clusterCount = 64;
+
+        /** The number of host bits of each cluster, i.e. 8 for /24 clusters. */
+        unsigned clusterHostBits = 8;
+
+        /** The range of generated ports (inclusive). */
+        std::uint16_t minPort = 1024, maxPort = 65535;
+
+        std::uint64_t seed = 0;
+    };
+
+    //===============================================================
+    /**
+     * @brief Creates a generator drawing uniformly from the whole IPv4
+     *        address space.
+     */
+    AddressGenerator();
+
+    /**
+     * @brief Creates a generator. Invalid prefixes are ignored.
+     *
+     * @param options The options of the generator.
+     */
+    explicit AddressGenerator(Options options);
+    ~AddressGenerator();
+
+    AddressGenerator(AddressGenerator&&);
+    AddressGenerator& operator=(AddressGenerator&&);
+
+    /**
+     * @brief Restarts the generator's random streams from a new seed.
+     *
+     * The clusters of the clustered distribution are kept.
+     *
+     * @param seed The new seed.
+     */
+    void reseed(std::uint64_t seed);
+
+    //===============================================================
+    /**
+     * @brief Generates IPv4 addresses and ports into packed arrays.
+     *
+     * All configured prefixes must be IPv4 prefixes.
+     *
+     * @param saddrs Receives the IPv4 addresses in host byte order.
+     * @param ports Receives the ports. Must either be empty or the same size as saddrs.
+     */
+    void generate(std::span<std::uint32_t> saddrs, std::span<std::uint16_t> ports = {});
+
+    /**
+     * @brief Generates addresses with random ports.
+     *
+     * IPv6 addresses carry the scope of the prefix they were drawn from.
+     *
+     * @param out Receives the addresses.
+     */
+    void generate(std::span<NetworkAddress> out);
+
+    /**
+     * @brief Generates socket addresses ready to be used as the msg_name
+     *        of a sendmmsg batch.
+     *
+     * All configured prefixes must be IPv4 prefixes.
+     *
+     * @param out Receives the socket addresses.
+     */
+    void generate(std::span<::sockaddr_in> out);
+
+    /**
+     * @brief Generates IPv6 socket addresses ready to be used as the
+     *        msg_name of a sendmmsg batch.
+     *
+     * Addresses drawn from IPv4 prefixes are written as IPv4-mapped IPv6
+     * addresses, suitable for dual-stack sockets.
+     *
+     * @param out Receives the socket addresses.
+     */
+    void generate(std::span<::sockaddr_in6> out);
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl;
+};
@@ -0,0 +1,138 @@
+//
+//  AddressGenerator_test.cpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <map>
+#include <set>
+
+#include "AddressGenerator.hpp"
+
+namespace
+{
+NetworkPrefix prefix(std::string const& str) {
+    return *NetworkPrefix::fromString(str);
+}
+}
+
+// Test that the output only depends on the seed
+TEST(AddressGeneratorTest, IsDeterministic) {
+    AddressGenerator::Options options;
+    options.prefixes = {prefix("10.0.0.0/8"), prefix("192.168.0.0/16")};
+    options.seed = 7;
+
+    std::vector<std::uint32_t> a(5000), b(5000), c(5000);
+    std::vector<std::uint16_t> portsA(5000), portsB(5000);
+    AddressGenerator(options).generate(a, portsA);
+
+    AddressGenerator gen(options);
+    gen.generate(b, portsB);
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(portsA, portsB);
+
+    gen.reseed(8);
+    gen.generate(c);
+    EXPECT_NE(a, c);
+
+    gen.reseed(7);
+    gen.generate(c, portsB);
+    EXPECT_EQ(a, c);
+}
+
+// Test that addresses stay within the weighted prefixes and port range
+TEST(AddressGeneratorTest, UniformRespectsPrefixesAndWeights) {
+    AddressGenerator::Options options;
+    options.prefixes = {prefix("10.0.0.0/8"), prefix("192.168.7.0/24")};
+    options.weights = {1.0, 3.0};
+    options.minPort = 5000;
+    options.maxPort = 5009;
+
+    std::vector<std::uint32_t> saddrs(40000);
+    std::vector<std::uint16_t> ports(saddrs.size());
+    AddressGenerator(options).generate(saddrs, ports);
+
+    std::size_t inSmall = 0;
+    for (std::size_t i = 0; i < saddrs.size(); ++i) {
+        auto const addr = NetworkAddress(saddrs[i]);
+        ASSERT_TRUE(options.prefixes[0].contains(addr) || options.prefixes[1].contains(addr));
+        ASSERT_GE(ports[i], 5000);
+        ASSERT_LE(ports[i], 5009);
+        inSmall += options.prefixes[1].contains(addr) ? 1 : 0;
+    }
+
+    EXPECT_NEAR(static_cast<double>(inSmall) / static_cast<double>(saddrs.size()), 0.75, 0.02);
+    EXPECT_EQ(std::set<std::uint16_t>(ports.begin(), ports.end()).size(), 10u);
+}
+
+// Test the Zipf distribution's popularity skew
+TEST(AddressGeneratorTest, ZipfIsSkewed) {
+    AddressGenerator::Options options;
+    options.prefixes = {prefix("2001:db8::/32")};
+    options.distribution = AddressGenerator::Distribution::zipf;
+    options.zipfPopulation = 1000;
+
+    std::vector<NetworkAddress> addrs(20000);
+    AddressGenerator(options).generate(addrs);
+
+    std::map<std::string, std::size_t> counts;
+    for (auto const& addr : addrs) {
+        ASSERT_TRUE(options.prefixes[0].contains(addr));
+        ++counts[addr.withPort(0).toString()];
+    }
+
+    std::vector<std::size_t> sorted;
+    for (auto const& [_, count] : counts) {
+        sorted.push_back(count);
+    }
+
+    std::sort(sorted.rbegin(), sorted.rend());
+    EXPECT_LE(counts.size(), 1000u);
+
+    // with s = 1 and n = 1000, P(rank 1) = 1 / H(1000) ~ 13%
+    EXPECT_NEAR(static_cast<double>(sorted[0]) / static_cast<double>(addrs.size()), 0.134, 0.015);
+    EXPECT_NEAR(static_cast<double>(sorted[0]) / static_cast<double>(sorted[1]), 2.0, 0.3);
+}
+
+// Test that clustered addresses fall into a bounded set of /24s
+TEST(AddressGeneratorTest, ClustersIntoSlash24s) {
+    AddressGenerator::Options options;
+    options.distribution = AddressGenerator::Distribution::clustered;
+    options.clusterCount = 16;
+
+    std::vector<::sockaddr_in> out(10000);
+    AddressGenerator(options).generate(out);
+
+    std::set<std::uint32_t> clusters, hosts;
+    for (auto const& sin : out) {
+        ASSERT_EQ(sin.sin_family, AF_INET);
+        auto const saddr = ntohl(sin.sin_addr.s_addr);
+        clusters.insert(saddr >> 8);
+        hosts.insert(saddr);
+    }
+
+    EXPECT_LE(clusters.size(), 16u);
+    EXPECT_GT(hosts.size(), 16u * 200u);
+}
+
+// Test IPv4-mapped output for dual-stack sockets
+TEST(AddressGeneratorTest, MapsIPv4ForDualStack) {
+    AddressGenerator::Options options;
+    options.prefixes = {prefix("203.0.113.0/24")};
+
+    std::vector<::sockaddr_in6> out(100);
+    AddressGenerator(options).generate(out);
+
+    for (auto const& sin6 : out) {
+        ASSERT_EQ(sin6.sin6_family, AF_INET6);
+        ASSERT_TRUE(IN6_IS_ADDR_V4MAPPED(&sin6.sin6_addr));
+        ASSERT_EQ(sin6.sin6_addr.s6_addr[12], 203);
+        ASSERT_EQ(sin6.sin6_addr.s6_addr[14], 113);
+    }
+}
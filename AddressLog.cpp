@@ -0,0 +1,239 @@
+//
+//  AddressLog.cpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <netinet/in.h>
+
+#if __APPLE__
+ #include <net/if_types.h>
+#endif
+
+#include "AddressLog.hpp"
+#include "CxxUtilities.hpp"
+
+namespace
+{
+#if __APPLE__
+constexpr ::sa_family_t kFamilyLinkLevel = AF_LINK;
+#elif __linux__
+constexpr ::sa_family_t kFamilyLinkLevel = AF_PACKET;
+#endif
+}
+
+//===============================================================
+CompactAddress CompactAddress::fromAddress(NetworkAddress const& addr, std::uint64_t tag) noexcept {
+    auto const& storage = addr.storage;
+    CompactAddress result = {};
+    result.tag = tag;
+    result.family = static_cast<std::uint8_t>(addr.family());
+
+    switch (storage.ss.ss_family) {
+    case AF_INET:
+        std::memcpy(result.bytes.data(), &storage.in4.sin_addr, sizeof(storage.in4.sin_addr));
+        result.port = cxxutils::byteswap(storage.in4.sin_port);
+        break;
+    case AF_INET6:
+        std::memcpy(result.bytes.data(), &storage.in6.sin6_addr, sizeof(storage.in6.sin6_addr));
+        result.scopeId = storage.in6.sin6_scope_id;
+        result.port = cxxutils::byteswap(storage.in6.sin6_port);
+        break;
+    case kFamilyLinkLevel:
+       #if __APPLE__
+        std::memcpy(result.bytes.data(), LLADDR(&storage.ll), std::min(static_cast<std::size_t>(storage.ll.sdl_alen), std::size_t(6)));
+        result.scopeId = storage.ll.sdl_index;
+       #elif __linux__
+        std::memcpy(result.bytes.data(), storage.ll.sll_addr, 6);
+        result.scopeId = static_cast<std::uint32_t>(storage.ll.sll_ifindex);
+        result.port = cxxutils::byteswap(storage.ll.sll_protocol);
+       #endif
+        break;
+    default:
+        break;
+    }
+
+    return result;
+}
+
+NetworkAddress CompactAddress::toAddress() const {
+    switch (static_cast<NetworkAddress::Family>(family)) {
+    case NetworkAddress::Family::ipv4: {
+        NetworkAddress result(static_cast<::sa_family_t>(AF_INET));
+        std::memcpy(&result.storage.in4.sin_addr, bytes.data(), sizeof(result.storage.in4.sin_addr));
+        result.storage.in4.sin_port = cxxutils::byteswap(port);
+        return result;
+    }
+    case NetworkAddress::Family::ipv6: {
+        NetworkAddress result(static_cast<::sa_family_t>(AF_INET6));
+        std::memcpy(&result.storage.in6.sin6_addr, bytes.data(), sizeof(result.storage.in6.sin6_addr));
+        result.storage.in6.sin6_scope_id = scopeId;
+        result.storage.in6.sin6_port = cxxutils::byteswap(port);
+        return result;
+    }
+    case NetworkAddress::Family::ethernet: {
+        NetworkAddress result(kFamilyLinkLevel);
+        auto& sock = result.storage.ll;
+       #if __APPLE__
+        std::memcpy(sock.sdl_data, bytes.data(), 6);
+        sock.sdl_type = IFT_ETHER;
+        sock.sdl_index = static_cast<decltype(sock.sdl_index)>(scopeId);
+        sock.sdl_alen = 6;
+       #elif __linux__
+        std::memcpy(sock.sll_addr, bytes.data(), 6);
+        sock.sll_protocol = cxxutils::byteswap(port);
+        sock.sll_ifindex = static_cast<int>(scopeId);
+        sock.sll_halen = 6;
+       #endif
+        return result;
+    }
+    default:
+        break;
+    }
+
+    return {};
+}
+
+std::to_chars_result CompactAddress::toChars(char* first, char* last) const {
+    if (static_cast<NetworkAddress::Family>(family) == NetworkAddress::Family::unixSocket) {
+        static constexpr char kUnix[] = "unix";
+
+        if (static_cast<std::size_t>(last - first) < sizeof(kUnix) - 1) {
+            return {last, std::errc::value_too_large};
+        }
+
+        return {std::copy_n(kUnix, sizeof(kUnix) - 1, first), std::errc()};
+    }
+
+    return toAddress().toChars(first, last);
+}
+
+//===============================================================
+namespace
+{
+// A single-producer, single-consumer ring. The producer only touches
+// head and its cached copy of tail, the consumer only tail, each on
+// their own cache line.
+struct Ring
+{
+    static constexpr std::uint64_t kMask = AddressLog::kCapacity - 1;
+    static_assert((AddressLog::kCapacity & kMask) == 0, "the capacity must be a power of two");
+
+    alignas(64) std::atomic<std::uint64_t> head = 0;
+    std::uint64_t cachedTail = 0;
+    std::atomic<std::uint64_t> dropped = 0;
+
+    alignas(64) std::atomic<std::uint64_t> tail = 0;
+    std::atomic<bool> retired = false;
+
+    std::array<CompactAddress, AddressLog::kCapacity> records;
+};
+
+//===============================================================
+// The rings of all threads. The mutex is only taken when a thread first
+// records an address, when it exits and when draining - never on the
+// recording path.
+struct Registry
+{
+    std::mutex lock;
+    std::mutex drainLock;
+    std::vector<std::shared_ptr<Ring>> rings;
+    std::uint64_t retiredDropped = 0;
+
+    static Registry& get() {
+        // leaked deliberately: threads may exit after static destruction
+        static auto* registry = new Registry;
+        return *registry;
+    }
+};
+
+struct ThreadRing
+{
+    ThreadRing() : ring(std::make_shared<Ring>()) {
+        auto& registry = Registry::get();
+        std::lock_guard guard(registry.lock);
+        registry.rings.push_back(ring);
+    }
+
+    // the registry keeps the ring until its records were drained
+    ~ThreadRing() { ring->retired.store(true, std::memory_order_release); }
+
+    std::shared_ptr<Ring> ring;
+};
+}
+
+bool AddressLog::record(NetworkAddress const& addr, std::uint64_t tag) {
+    thread_local ThreadRing threadRing;
+    auto& ring = *threadRing.ring;
+    auto const head = ring.head.load(std::memory_order_relaxed);
+
+    if (head - ring.cachedTail >= kCapacity) {
+        ring.cachedTail = ring.tail.load(std::memory_order_acquire);
+
+        if (head - ring.cachedTail >= kCapacity) {
+            ring.dropped.store(ring.dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return false;
+        }
+    }
+
+    ring.records[head & Ring::kMask] = CompactAddress::fromAddress(addr, tag);
+    ring.head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+std::size_t AddressLog::drainRecords(cxxnetaddr::detail::VisitorRef<CompactAddress> fn) {
+    auto& registry = Registry::get();
+    std::lock_guard drainGuard(registry.drainLock);
+    std::vector<std::shared_ptr<Ring>> rings;
+
+    {
+        std::lock_guard guard(registry.lock);
+        rings = registry.rings;
+    }
+
+    std::size_t count = 0;
+
+    for (auto const& ring : rings) {
+        // read before head: a retired ring receives no further records
+        auto const retired = ring->retired.load(std::memory_order_acquire);
+        auto const head = ring->head.load(std::memory_order_acquire);
+        auto tail = ring->tail.load(std::memory_order_relaxed);
+
+        for (; tail != head; ++tail, ++count) {
+            fn(ring->records[tail & Ring::kMask]);
+        }
+
+        ring->tail.store(tail, std::memory_order_release);
+
+        if (retired) {
+            std::lock_guard guard(registry.lock);
+            registry.retiredDropped += ring->dropped.load(std::memory_order_relaxed);
+            registry.rings.erase(std::find(registry.rings.begin(), registry.rings.end(), ring));
+        }
+    }
+
+    return count;
+}
+
+std::uint64_t AddressLog::dropped() noexcept {
+    auto& registry = Registry::get();
+    std::lock_guard guard(registry.lock);
+    auto result = registry.retiredDropped;
+
+    for (auto const& ring : registry.rings) {
+        result += ring->dropped.load(std::memory_order_relaxed);
+    }
+
+    return result;
+}
@@ -0,0 +1,130 @@
+//
+//  AddressLog.hpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+#pragma once
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "NetworkAddress.hpp"
+
+/**
+ * @struct CompactAddress
+ * @brief The fields of a NetworkAddress in 32 bytes, for binary logs.
+ *
+ * Converting a NetworkAddress is a handful of loads and a single 32-byte
+ * store; formatting is deferred to toChars(), which uses the library's
+ * formatter. The struct is trivially copyable and may be written to
+ * files as is and decoded later by a process with the same byte order.
+ *
+ * UNIX socket paths do not fit and only their family is recorded.
+ */
+struct alignas(32) CompactAddress
+{
+    /** The address in network byte order: 4 bytes for IPv4, 16 for IPv6 and 6 for MACs */
+    std::array<std::uint8_t, 16> bytes;
+
+    /** A value chosen by the caller, e.g. a timestamp or request id */
+    std::uint64_t tag;
+
+    /** The IPv6 scope id or the interface index of a MAC address */
+    std::uint32_t scopeId;
+
+    /** The port or the protocol of a MAC address, in host byte order */
+    std::uint16_t port;
+
+    /** The NetworkAddress::Family */
+    std::uint8_t family;
+    std::uint8_t reserved;
+
+    //===============================================================
+    /**
+     * @brief Captures the fields of an address.
+     *
+     * @param addr The address.
+     * @param tag A value chosen by the caller.
+     */
+    static CompactAddress fromAddress(NetworkAddress const& addr, std::uint64_t tag = 0) noexcept;
+
+    /**
+     * @brief Reconstructs the address.
+     *
+     * @return The address or an unspecified address for UNIX sockets.
+     */
+    NetworkAddress toAddress() const;
+
+    /** The maximum number of characters written by toChars(). */
+    static constexpr std::size_t kMaxStringLength = NetworkAddress::kMaxStringLength;
+
+    /**
+     * @brief Formats the address like NetworkAddress::toChars.
+     *
+     * UNIX socket addresses are formatted as "unix".
+     */
+    std::to_chars_result toChars(char* first, char* last) const;
+};
+
+static_assert(sizeof(CompactAddress) == 32 && std::is_trivially_copyable_v<CompactAddress>);
+
+//===============================================================
+/**
+ * @class AddressLog
+ * @brief A binary log of addresses with deferred formatting.
+ *
+ * record() stores a CompactAddress into a lock-free single-producer,
+ * single-consumer ring owned by the calling thread and never blocks or
+ * allocates after a thread's first call. A consumer - e.g. a background
+ * thread - calls drain() to collect the records of all threads and format
+ * them off the hot path.
+ *
+ * If a thread's ring is full, its new records are dropped and counted.
+ * Records of exited threads remain until drained.
+ */
+class AddressLog
+{
+public:
+    /** The number of records each thread's ring can hold. */
+    static constexpr std::size_t kCapacity = 4096;
+
+    /**
+     * @brief Records an address in the calling thread's ring.
+     *
+     * The first call of a thread allocates its ring and may throw
+     * std::bad_alloc; later calls do not throw.
+     *
+     * @param addr The address.
+     * @param tag A value chosen by the caller, e.g. a timestamp or request id.
+     * @return False if the ring was full and the record was dropped.
+     */
+    static bool record(NetworkAddress const& addr, std::uint64_t tag = 0);
+
+    /**
+     * @brief Removes all records from the rings of all threads.
+     *
+     * The records of each thread are passed in the order they were
+     * recorded; there is no order between threads. drain() may be called
+     * from any thread, concurrent calls are serialized.
+     *
+     * @param fn Called with every CompactAddress.
+     * @return The number of records drained.
+     */
+    template <typename Fn>
+    static std::size_t drain(Fn && fn) {
+        return drainRecords(cxxnetaddr::detail::VisitorRef<CompactAddress>(fn));
+    }
+
+    /** The number of records dropped because a ring was full. */
+    static std::uint64_t dropped() noexcept;
+
+private:
+    static std::size_t drainRecords(cxxnetaddr::detail::VisitorRef<CompactAddress> fn);
+};
@@ -0,0 +1,77 @@
+//
+//  AddressLog_bench.cpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+#include <benchmark/benchmark.h>
+
+#include "AddressLog.hpp"
+
+namespace
+{
+NetworkAddress const& peer() {
+    static auto const addr = *NetworkAddress::fromIPString("[2001:db8::42]:8080");
+    return addr;
+}
+}
+
+//===============================================================
+// The cost on the request thread: recording a peer in the binary log ...
+static void BM_AddressLogRecord(benchmark::State& state) {
+    auto const& addr = peer();
+    std::uint64_t tag = 0;
+
+    for (auto _ : state) {
+        AddressLog::record(addr, tag++);
+
+        // keep the ring from filling up, outside of the measurement
+        if ((tag & (AddressLog::kCapacity - 1)) == 0) {
+            state.PauseTiming();
+            AddressLog::drain([] (CompactAddress const& record) { benchmark::DoNotOptimize(record); });
+            state.ResumeTiming();
+        }
+    }
+
+    AddressLog::drain([] (CompactAddress const&) {});
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AddressLogRecord);
+
+// ... compared to formatting it right away
+static void BM_Baseline_ToChars(benchmark::State& state) {
+    auto const& addr = peer();
+    char buffer[NetworkAddress::kMaxStringLength];
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(addr.toChars(buffer, buffer + sizeof(buffer)));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Baseline_ToChars);
+
+// The deferred cost on the consumer
+static void BM_AddressLogDrainAndFormat(benchmark::State& state) {
+    auto const& addr = peer();
+    char buffer[CompactAddress::kMaxStringLength];
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        for (std::size_t i = 0; i < AddressLog::kCapacity; ++i) {
+            AddressLog::record(addr, i);
+        }
+        state.ResumeTiming();
+
+        AddressLog::drain([&buffer] (CompactAddress const& record) {
+            benchmark::DoNotOptimize(record.toChars(buffer, buffer + sizeof(buffer)));
+        });
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(AddressLog::kCapacity));
+}
+BENCHMARK(BM_AddressLogDrainAndFormat);
@@ -0,0 +1,141 @@
+//
+//  AddressLog_test.cpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+#include <gtest/gtest.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "AddressLog.hpp"
+
+namespace
+{
+std::string format(CompactAddress const& record) {
+    char buffer[CompactAddress::kMaxStringLength];
+    auto const [end, ec] = record.toChars(buffer, buffer + sizeof(buffer));
+    return ec == std::errc() ? std::string(buffer, end) : std::string();
+}
+}
+
+// Test that compact addresses reproduce the original addresses
+TEST(AddressLogTest, CompactAddressRoundTrip) {
+    std::vector<NetworkAddress> const addrs = {
+        NetworkAddress(192, 168, 1, 1, 8080),
+        *NetworkAddress::fromIPString("[2001:db8::1]:443"),
+        *NetworkAddress::fromIPString("fe80::1%1"),
+        NetworkAddress(0x00, 0x1A, 0x2B, 0x3C, 0x4D, 0x5E)
+    };
+
+    for (auto const& addr : addrs) {
+        auto const compact = CompactAddress::fromAddress(addr, 42);
+        EXPECT_EQ(compact.tag, 42u);
+        EXPECT_EQ(compact.toAddress(), addr) << addr.toString();
+        EXPECT_EQ(format(compact), addr.toString());
+    }
+
+    auto const unixRecord = CompactAddress::fromAddress(NetworkAddress::fromUNIXSocketPath("/tmp/socket"));
+    EXPECT_EQ(static_cast<NetworkAddress::Family>(unixRecord.family), NetworkAddress::Family::unixSocket);
+    EXPECT_EQ(format(unixRecord), "unix");
+    EXPECT_FALSE(unixRecord.toAddress().valid());
+
+    EXPECT_FALSE(CompactAddress::fromAddress(NetworkAddress()).toAddress().valid());
+}
+
+// Test that the records of each thread are drained in order
+TEST(AddressLogTest, RecordAndDrain) {
+    AddressLog::drain([] (CompactAddress const&) {});
+
+    for (std::uint64_t i = 0; i < 100; ++i) {
+        EXPECT_TRUE(AddressLog::record(NetworkAddress(10, 0, 0, static_cast<std::uint8_t>(i), 80), i));
+    }
+
+    std::vector<std::uint64_t> tags;
+    EXPECT_EQ(AddressLog::drain([&tags] (CompactAddress const& record) {
+        EXPECT_EQ(record.toAddress(), NetworkAddress(10, 0, 0, static_cast<std::uint8_t>(record.tag), 80));
+        tags.push_back(record.tag);
+    }), 100u);
+
+    ASSERT_EQ(tags.size(), 100u);
+    EXPECT_TRUE(std::is_sorted(tags.begin(), tags.end()));
+    EXPECT_EQ(AddressLog::drain([] (CompactAddress const&) {}), 0u);
+
+    // const visitors
+    std::size_t count = 0;
+    auto const countRecord = [&count] (CompactAddress const&) { ++count; };
+    EXPECT_TRUE(AddressLog::record(NetworkAddress(10, 0, 0, 1, 80)));
+    EXPECT_EQ(AddressLog::drain(countRecord), 1u);
+    EXPECT_EQ(count, 1u);
+}
+
+// Test that a full ring drops records instead of blocking
+TEST(AddressLogTest, FullRingDropsRecords) {
+    AddressLog::drain([] (CompactAddress const&) {});
+    auto const droppedBefore = AddressLog::dropped();
+    NetworkAddress const addr(127, 0, 0, 1);
+
+    for (std::size_t i = 0; i < AddressLog::kCapacity; ++i) {
+        ASSERT_TRUE(AddressLog::record(addr));
+    }
+
+    EXPECT_FALSE(AddressLog::record(addr));
+    EXPECT_EQ(AddressLog::dropped(), droppedBefore + 1);
+    EXPECT_EQ(AddressLog::drain([] (CompactAddress const&) {}), AddressLog::kCapacity);
+    EXPECT_TRUE(AddressLog::record(addr));
+    AddressLog::drain([] (CompactAddress const&) {});
+}
+
+// Test concurrent producers with a concurrent consumer, including exited threads
+TEST(AddressLogTest, ConcurrentProducers) {
+    static constexpr std::uint64_t kThreads = 4;
+    static constexpr std::uint64_t kRecords = 20000;
+
+    AddressLog::drain([] (CompactAddress const&) {});
+    auto const droppedBefore = AddressLog::dropped();
+    std::atomic<bool> done = false;
+    std::vector<std::uint64_t> next(kThreads, 0);
+    std::uint64_t drained = 0;
+
+    auto consume = [&] (CompactAddress const& record) {
+        auto const thread = record.tag >> 32;
+        // every thread's records arrive in order, up to the dropped ones
+        EXPECT_GE(record.tag & 0xffffffffu, next[thread]);
+        next[thread] = (record.tag & 0xffffffffu) + 1;
+        EXPECT_EQ(record.toAddress().port(), thread);
+        ++drained;
+    };
+
+    std::thread consumer([&] {
+        while (! done.load()) {
+            AddressLog::drain(consume);
+            std::this_thread::yield();
+        }
+    });
+
+    std::vector<std::thread> producers;
+
+    for (std::uint64_t t = 0; t < kThreads; ++t) {
+        producers.emplace_back([t] {
+            for (std::uint64_t i = 0; i < kRecords; ++i) {
+                AddressLog::record(NetworkAddress(10, 0, 0, 1, static_cast<std::uint16_t>(t)), (t << 32) | i);
+            }
+        });
+    }
+
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    done = true;
+    consumer.join();
+    AddressLog::drain(consume);
+
+    EXPECT_EQ(drained + (AddressLog::dropped() - droppedBefore), kThreads * kRecords);
+}
@@ -0,0 +1,797 @@
+//
+//  AddressPool.cpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <system_error>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "AddressPool.hpp"
+
+namespace
+{
+using Index = AddressRange::Index;
+
+constexpr auto kMaxIndex = std::numeric_limits<Index>::max();
+
+// prefixes with up to this many host bits keep a bit per address (2 MiB)
+constexpr unsigned kMaxDenseBits = 24;
+
+constexpr std::uint64_t bit(std::size_t i) noexcept { return std::uint64_t(1) << (i % 64); }
+
+unsigned addressBits(NetworkAddress::Family family) noexcept {
+    switch (family) {
+    case NetworkAddress::Family::ipv4: return 32;
+    case NetworkAddress::Family::ipv6: return 128;
+    default: break;
+    }
+
+    return 0;
+}
+
+//===============================================================
+// A bit per address which is set while the address is free, and above it
+// levels with a bit per word of the level below that has a set bit, up to a
+// single word: the lowest free address is found by descending from the top.
+class HierarchicalBitmap
+{
+public:
+    HierarchicalBitmap() = default;
+
+    explicit HierarchicalBitmap(std::size_t count)
+        : HierarchicalBitmap(std::vector<std::uint64_t>((count + 63) / 64, ~std::uint64_t(0)), count) {}
+
+    // takes the free bits of all addresses
+    HierarchicalBitmap(std::vector<std::uint64_t> words, std::size_t count) {
+        if (count % 64 != 0) {
+            words.back() &= bit(count) - 1;
+        }
+
+        levels.push_back(std::move(words));
+
+        while (levels.back().size() > 1) {
+            auto const& below = levels.back();
+            std::vector<std::uint64_t> above((below.size() + 63) / 64, 0);
+
+            for (std::size_t i = 0; i < below.size(); ++i) {
+                above[i / 64] |= below[i] != 0 ? bit(i) : 0;
+            }
+
+            levels.push_back(std::move(above));
+        }
+    }
+
+    std::optional<std::size_t> allocate() noexcept {
+        if (levels.back().front() == 0) {
+            return {};
+        }
+
+        std::size_t i = 0;
+
+        for (auto level = levels.size(); level-- > 0;) {
+            i = i * 64 + static_cast<std::size_t>(std::countr_zero(levels[level][i]));
+        }
+
+        clear(i);
+        return i;
+    }
+
+    bool reserve(std::size_t i) noexcept {
+        if (! isFree(i)) {
+            return false;
+        }
+
+        clear(i);
+        return true;
+    }
+
+    bool release(std::size_t i) noexcept {
+        if (isFree(i)) {
+            return false;
+        }
+
+        for (auto& level : levels) {
+            auto& word = level[i / 64];
+            auto const wasEmpty = word == 0;
+            word |= bit(i);
+
+            if (! wasEmpty) {
+                break;
+            }
+
+            i /= 64;
+        }
+
+        return true;
+    }
+
+    bool isFree(std::size_t i) const noexcept { return (levels.front()[i / 64] & bit(i)) != 0; }
+
+    std::vector<std::uint64_t> const& freeBits() const noexcept { return levels.front(); }
+
+private:
+    void clear(std::size_t i) noexcept {
+        for (auto& level : levels) {
+            auto& word = level[i / 64];
+            word &= ~bit(i);
+
+            if (word != 0) {
+                break;
+            }
+
+            i /= 64;
+        }
+    }
+
+    std::vector<std::vector<std::uint64_t>> levels;
+};
+
+//===============================================================
+using Bits256 = std::array<std::uint64_t, 4>;
+
+bool isFull(Bits256 const& bits) noexcept {
+    return (bits[0] & bits[1] & bits[2] & bits[3]) == ~std::uint64_t(0);
+}
+
+bool isEmpty(Bits256 const& bits) noexcept {
+    return (bits[0] | bits[1] | bits[2] | bits[3]) == 0;
+}
+
+unsigned firstZero(Bits256 const& bits) noexcept {
+    for (unsigned w = 0; w < 4; ++w) {
+        if (bits[w] != ~std::uint64_t(0)) {
+            return w * 64 + static_cast<unsigned>(std::countr_one(bits[w]));
+        }
+    }
+
+    return 256;
+}
+
+// The allocated addresses of a large prefix: leaves with a bit per address
+// of 256 consecutive ones, below nodes with 256 children and a bit per child
+// that is full. Missing children are entirely free, so the memory grows with
+// the allocated parts of the prefix instead of its size.
+class RadixBitmap
+{
+public:
+    RadixBitmap() = default;
+
+    explicit RadixBitmap(unsigned hostBits)
+        : depth((hostBits - 1) / 8), leafLimit(kMaxIndex >> (128 - (hostBits - 8))) {
+        // the root selects the remaining (up to eight) bits: children beyond are never free
+        auto const rootBits = hostBits - 8 * depth;
+
+        for (unsigned c = 1u << rootBits; c < 256; ++c) {
+            root.bits[c / 64] |= bit(c);
+        }
+    }
+
+    std::optional<Index> allocate() {
+        if (isFull(root.bits)) {
+            return {};
+        }
+
+        Path path;
+        Index offset = 0;
+        auto* node = &root;
+
+        for (unsigned level = 0; level < depth; ++level) {
+            auto const c = firstZero(node->bits);
+            path[level] = { node, c };
+            node = child(*node, c);
+            offset = (offset << 8) | c;
+        }
+
+        auto const b = firstZero(node->bits);
+        node->bits[b / 64] |= bit(b);
+        markFull(path, *node);
+        return (offset << 8) | b;
+    }
+
+    bool reserve(Index offset) {
+        Path path;
+        auto& leaf = *descend(offset, path, true);
+        auto const b = static_cast<unsigned>(offset & 255);
+
+        if ((leaf.bits[b / 64] & bit(b)) != 0) {
+            return false;
+        }
+
+        leaf.bits[b / 64] |= bit(b);
+        markFull(path, leaf);
+        return true;
+    }
+
+    bool release(Index offset) {
+        Path path;
+        auto* leaf = descend(offset, path, false);
+        auto const b = static_cast<unsigned>(offset & 255);
+
+        if (leaf == nullptr || (leaf->bits[b / 64] & bit(b)) == 0) {
+            return false;
+        }
+
+        leaf->bits[b / 64] &= ~bit(b);
+
+        // no ancestor is full anymore; remove the nodes that became empty
+        auto prune = isEmpty(leaf->bits);
+
+        for (auto level = depth; level-- > 0;) {
+            auto& [node, c] = path[level];
+            node->bits[c / 64] &= ~bit(c);
+
+            if (prune) {
+                (*node->children)[c].reset();
+                prune = --node->numChildren == 0 && level != 0;
+            }
+        }
+
+        return true;
+    }
+
+    bool isAllocated(Index offset) const {
+        auto const* node = &root;
+
+        for (unsigned level = 0; level < depth && node != nullptr; ++level) {
+            auto const c = static_cast<unsigned>(offset >> (8 * (depth - level))) & 255;
+            node = node->children != nullptr ? (*node->children)[c].get() : nullptr;
+        }
+
+        auto const b = static_cast<unsigned>(offset & 255);
+        return node != nullptr && (node->bits[b / 64] & bit(b)) != 0;
+    }
+
+    // calls fn with the index (offset / 256) and the bits of every leaf in order
+    template <typename Fn>
+    void forEachLeaf(Fn&& fn) const {
+        visit(root, 0, 0, fn);
+    }
+
+    bool insertLeaf(Index leafIndex, Bits256 const& bits) {
+        if (leafIndex > leafLimit) {
+            return false;
+        }
+
+        if (isEmpty(bits)) {
+            return true;
+        }
+
+        Path path;
+        auto& leaf = *descend(leafIndex << 8, path, true);
+
+        if (! isEmpty(leaf.bits)) {
+            return false;
+        }
+
+        leaf.bits = bits;
+        markFull(path, leaf);
+        return true;
+    }
+
+private:
+    struct Node
+    {
+        Bits256 bits = {};  // leaves: the allocated addresses, nodes: the full children
+        std::unique_ptr<std::array<std::unique_ptr<Node>, 256>> children;
+        unsigned numChildren = 0;
+    };
+
+    struct Step
+    {
+        Node* node;
+        unsigned child;
+    };
+
+    using Path = std::array<Step, 16>;
+
+    static Node* child(Node& node, unsigned c) {
+        if (node.children == nullptr) {
+            node.children = std::make_unique<std::array<std::unique_ptr<Node>, 256>>();
+        }
+
+        auto& slot = (*node.children)[c];
+
+        if (slot == nullptr) {
+            slot = std::make_unique<Node>();
+            ++node.numChildren;
+        }
+
+        return slot.get();
+    }
+
+    Node* descend(Index offset, Path& path, bool create) {
+        auto* node = &root;
+
+        for (unsigned level = 0; level < depth; ++level) {
+            auto const c = static_cast<unsigned>(offset >> (8 * (depth - level))) & 255;
+            path[level] = { node, c };
+
+            if (create) {
+                node = child(*node, c);
+            } else if (node->children == nullptr || (node = (*node->children)[c].get()) == nullptr) {
+                return nullptr;
+            }
+        }
+
+        return node;
+    }
+
+    void markFull(Path const& path, Node const& leaf) noexcept {
+        if (! isFull(leaf.bits)) {
+            return;
+        }
+
+        for (auto level = depth; level-- > 0;) {
+            auto const [node, c] = path[level];
+            node->bits[c / 64] |= bit(c);
+
+            if (! isFull(node->bits)) {
+                break;
+            }
+        }
+    }
+
+    template <typename Fn>
+    void visit(Node const& node, unsigned level, Index prefix, Fn& fn) const {
+        if (level == depth) {
+            fn(prefix, node.bits);
+            return;
+        }
+
+        if (node.children == nullptr) {
+            return;
+        }
+
+        for (unsigned c = 0; c < 256; ++c) {
+            if (auto const* next = (*node.children)[c].get()) {
+                visit(*next, level + 1, (prefix << 8) | c, fn);
+            }
+        }
+    }
+
+    unsigned depth = 0;   // the number of levels of nodes above the leaves
+    Index leafLimit = 0;  // the largest leaf index
+    Node root;
+};
+
+//===============================================================
+// The file: a FileHeader, then for every prefix a BlockHeader followed by
+// numWords 64-bit words. These are the free bits of dense prefixes and, for
+// sparse prefixes, six words per leaf: its index (low, high) and its bits.
+constexpr char kMagic[8] = { 'C', 'X', 'X', 'P', 'O', 'O', 'L', '\0' };
+constexpr std::uint32_t kVersion = 1;
+
+struct FileHeader
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t numBlocks;
+};
+
+struct BlockHeader
+{
+    std::uint64_t networkLow, networkHigh;
+    std::uint8_t family, length, reserved[6];
+    std::uint64_t numWords;
+};
+
+static_assert(sizeof(FileHeader) == 16 && sizeof(BlockHeader) == 32);
+
+// writes all bytes, or returns false on an error
+bool writeAll(int fd, void const* data, std::size_t size) noexcept {
+    auto const* bytes = static_cast<char const*>(data);
+
+    while (size > 0) {
+        auto const written = ::write(fd, bytes, size);
+
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            return false;
+        }
+
+        bytes += written;
+        size -= static_cast<std::size_t>(written);
+    }
+
+    return true;
+}
+
+// aligned prefixes share addresses if and only if one contains the other
+bool overlap(NetworkPrefix const& a, NetworkPrefix const& b) {
+    return a.contains(b.address()) || b.contains(a.address());
+}
+
+// a read-only private mapping of a whole file
+class MappedFile
+{
+public:
+    explicit MappedFile(std::filesystem::path const& path) {
+        auto const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+        if (fd < 0) {
+            return;
+        }
+
+        struct ::stat st;
+
+        if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+            auto* const ptr = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+
+            if (ptr != MAP_FAILED) {
+                data = static_cast<std::byte const*>(ptr);
+                size = static_cast<std::size_t>(st.st_size);
+            }
+        }
+
+        ::close(fd);
+    }
+
+    ~MappedFile() {
+        if (data != nullptr) {
+            ::munmap(const_cast<std::byte*>(data), size);
+        }
+    }
+
+    MappedFile(MappedFile const&) = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+
+    // reads the next object, or returns false if the file is too short
+    template <typename T>
+    bool read(T& out) noexcept {
+        if (size - position < sizeof(T)) {
+            return false;
+        }
+
+        std::memcpy(&out, data + position, sizeof(T));
+        position += sizeof(T);
+        return true;
+    }
+
+    // the next count words, or nullptr if the file is too short
+    std::byte const* words(std::uint64_t count) noexcept {
+        if ((size - position) / sizeof(std::uint64_t) < count) {
+            return nullptr;
+        }
+
+        auto const* result = data + position;
+        position += static_cast<std::size_t>(count) * sizeof(std::uint64_t);
+        return result;
+    }
+
+    bool valid() const noexcept { return data != nullptr; }
+    bool atEnd() const noexcept { return position == size; }
+
+private:
+    std::byte const* data = nullptr;
+    std::size_t size = 0, position = 0;
+};
+}
+
+//===============================================================
+struct AddressPool::Block
+{
+    explicit Block(NetworkPrefix const& p)
+        : prefix(p),
+          base(AddressRange::keyOf(p.address())),
+          hostBits(addressBits(p.family()) - p.length()) {
+        if (isDense()) {
+            dense = HierarchicalBitmap(std::size_t(1) << hostBits);
+        } else {
+            sparse = RadixBitmap(hostBits);
+        }
+    }
+
+    bool isDense() const noexcept { return hostBits <= kMaxDenseBits; }
+
+    Index capacity() const noexcept { return hostBits >= 128 ? kMaxIndex : Index(1) << hostBits; }
+
+    NetworkAddress addressAt(Index offset) const noexcept {
+        auto result = prefix.address();
+        AddressRange::setKey(result, base + offset);
+        return result;
+    }
+
+    NetworkPrefix prefix;
+    Index base;
+    unsigned hostBits;
+    Index allocated = 0;
+    HierarchicalBitmap dense;  // if isDense()
+    RadixBitmap sparse;        // otherwise
+};
+
+//===============================================================
+AddressPool::AddressPool() = default;
+AddressPool::AddressPool(AddressPool&&) noexcept = default;
+AddressPool& AddressPool::operator=(AddressPool&&) noexcept = default;
+AddressPool::~AddressPool() = default;
+
+AddressPool::AddressPool(std::vector<NetworkPrefix> const& prefixes) {
+    for (auto const& prefix : prefixes) {
+        if (prefix.valid() && ! overlapsBlock(prefix)) {
+            blocks.push_back(std::make_unique<Block>(prefix));
+        }
+    }
+}
+
+bool AddressPool::overlapsBlock(NetworkPrefix const& prefix) const {
+    return std::any_of(blocks.begin(), blocks.end(), [&prefix] (auto const& block) { return overlap(block->prefix, prefix); });
+}
+
+AddressPool::Block* AddressPool::blockOf(NetworkAddress const& addr, Index& offset) const {
+    for (auto const& block : blocks) {
+        if (block->prefix.family() == addr.family() && block->prefix.contains(addr)) {
+            offset = AddressRange::keyOf(addr) - block->base;
+            return block.get();
+        }
+    }
+
+    return nullptr;
+}
+
+//===============================================================
+std::optional<NetworkAddress> AddressPool::allocate(NetworkAddress::Family family) {
+    for (auto const& block : blocks) {
+        if (family != NetworkAddress::Family::unspecified && block->prefix.family() != family) {
+            continue;
+        }
+
+        auto const offset = block->isDense() ? block->dense.allocate().transform([] (auto i) { return Index(i); })
+                                             : block->sparse.allocate();
+
+        if (offset) {
+            ++block->allocated;
+            return block->addressAt(*offset);
+        }
+    }
+
+    return {};
+}
+
+bool AddressPool::reserve(NetworkAddress const& addr) {
+    Index offset;
+    auto* block = blockOf(addr, offset);
+
+    if (block == nullptr || ! (block->isDense() ? block->dense.reserve(static_cast<std::size_t>(offset)) : block->sparse.reserve(offset))) {
+        return false;
+    }
+
+    ++block->allocated;
+    return true;
+}
+
+bool AddressPool::release(NetworkAddress const& addr) {
+    Index offset;
+    auto* block = blockOf(addr, offset);
+
+    if (block == nullptr || ! (block->isDense() ? block->dense.release(static_cast<std::size_t>(offset)) : block->sparse.release(offset))) {
+        return false;
+    }
+
+    --block->allocated;
+    return true;
+}
+
+bool AddressPool::isAllocated(NetworkAddress const& addr) const {
+    Index offset;
+    auto const* block = blockOf(addr, offset);
+
+    if (block == nullptr) {
+        return false;
+    }
+
+    return block->isDense() ? ! block->dense.isFree(static_cast<std::size_t>(offset)) : block->sparse.isAllocated(offset);
+}
+
+//===============================================================
+std::vector<NetworkPrefix> AddressPool::prefixes() const {
+    std::vector<NetworkPrefix> result;
+    result.reserve(blocks.size());
+
+    for (auto const& block : blocks) {
+        result.push_back(block->prefix);
+    }
+
+    return result;
+}
+
+std::pmr::vector<NetworkPrefix> AddressPool::prefixes(std::pmr::memory_resource* resource) const {
+    std::pmr::vector<NetworkPrefix> result(resource);
+    result.reserve(blocks.size());
+
+    for (auto const& block : blocks) {
+        result.push_back(block->prefix);
+    }
+
+    return result;
+}
+
+AddressPool::Index AddressPool::size() const noexcept {
+    Index result = 0;
+
+    for (auto const& block : blocks) {
+        result += block->allocated;
+    }
+
+    return result;
+}
+
+AddressPool::Index AddressPool::capacity() const noexcept {
+    Index result = 0;
+
+    for (auto const& block : blocks) {
+        result = block->capacity() > kMaxIndex - result ? kMaxIndex : result + block->capacity();
+    }
+
+    return result;
+}
+
+//===============================================================
+bool AddressPool::save(std::filesystem::path const& path) const {
+    auto temporary = path;
+    temporary += ".tmp";
+
+    auto const fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+
+    if (fd < 0) {
+        return false;
+    }
+
+    auto ok = true;
+    auto const writeBytes = [fd, &ok] (void const* data, std::size_t size) { ok = ok && writeAll(fd, data, size); };
+    auto const write = [&writeBytes] (auto const& value) { writeBytes(&value, sizeof(value)); };
+
+    FileHeader header = {};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.numBlocks = static_cast<std::uint32_t>(blocks.size());
+    write(header);
+
+    for (auto const& block : blocks) {
+        BlockHeader blockHeader = {};
+        blockHeader.networkLow = static_cast<std::uint64_t>(block->base);
+        blockHeader.networkHigh = static_cast<std::uint64_t>(block->base >> 64);
+        blockHeader.family = static_cast<std::uint8_t>(block->prefix.family());
+        blockHeader.length = static_cast<std::uint8_t>(block->prefix.length());
+
+        if (block->isDense()) {
+            auto const& words = block->dense.freeBits();
+            blockHeader.numWords = words.size();
+            write(blockHeader);
+            writeBytes(words.data(), words.size() * sizeof(std::uint64_t));
+        } else {
+            std::vector<std::uint64_t> words;
+
+            block->sparse.forEachLeaf([&words] (Index leafIndex, Bits256 const& bits) {
+                words.push_back(static_cast<std::uint64_t>(leafIndex));
+                words.push_back(static_cast<std::uint64_t>(leafIndex >> 64));
+                words.insert(words.end(), bits.begin(), bits.end());
+            });
+
+            blockHeader.numWords = words.size();
+            write(blockHeader);
+            writeBytes(words.data(), words.size() * sizeof(std::uint64_t));
+        }
+    }
+
+    // the data must be on disk before the rename can replace the old file
+    ok = ok && ::fsync(fd) == 0;
+    ok = ::close(fd) == 0 && ok;
+    ok = ok && ::rename(temporary.c_str(), path.c_str()) == 0;
+
+    if (! ok) {
+        ::unlink(temporary.c_str());
+        return false;
+    }
+
+    // and the rename itself only once the directory is synced
+    auto const directory = path.has_parent_path() ? path.parent_path() : std::filesystem::path(".");
+    auto const directoryFd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+    if (directoryFd < 0) {
+        return false;
+    }
+
+    auto const synced = ::fsync(directoryFd) == 0;
+    ::close(directoryFd);
+    return synced;
+}
+
+std::optional<AddressPool> AddressPool::load(std::filesystem::path const& path) {
+    MappedFile file(path);
+    FileHeader header;
+
+    if (! file.valid() || ! file.read(header) || std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion) {
+        return {};
+    }
+
+    AddressPool pool;
+
+    for (std::uint32_t i = 0; i < header.numBlocks; ++i) {
+        BlockHeader blockHeader;
+
+        if (! file.read(blockHeader)) {
+            return {};
+        }
+
+        auto const family = static_cast<NetworkAddress::Family>(blockHeader.family);
+        auto const bits = addressBits(family);
+
+        if (bits == 0 || blockHeader.length > bits) {
+            return {};
+        }
+
+        auto network = family == NetworkAddress::Family::ipv4 ? NetworkAddress(std::uint32_t(0)) : NetworkAddress(0, 0, 0, 0, 0, 0, 0, 0);
+        AddressRange::setKey(network, (Index(blockHeader.networkHigh) << 64) | blockHeader.networkLow);
+        NetworkPrefix const prefix(network, blockHeader.length);
+
+        auto block = std::make_unique<Block>(prefix);
+        auto const* data = file.words(blockHeader.numWords);
+
+        if (data == nullptr || block->base != AddressRange::keyOf(network) || pool.overlapsBlock(prefix)) {
+            return {};
+        }
+
+        if (block->isDense()) {
+            auto const count = std::size_t(1) << block->hostBits;
+            std::vector<std::uint64_t> words(blockHeader.numWords);
+
+            if (words.size() != (count + 63) / 64) {
+                return {};
+            }
+
+            std::memcpy(words.data(), data, words.size() * sizeof(std::uint64_t));
+            block->dense = HierarchicalBitmap(std::move(words), count);
+
+            std::size_t free = 0;
+            for (auto const word : block->dense.freeBits()) {
+                free += static_cast<std::size_t>(std::popcount(word));
+            }
+
+            block->allocated = count - free;
+        } else {
+            if (blockHeader.numWords % 6 != 0) {
+                return {};
+            }
+
+            for (std::uint64_t w = 0; w < blockHeader.numWords; w += 6) {
+                std::uint64_t leaf[6];
+                std::memcpy(leaf, data + w * sizeof(std::uint64_t), sizeof(leaf));
+                Bits256 const leafBits = { leaf[2], leaf[3], leaf[4], leaf[5] };
+
+                if (! block->sparse.insertLeaf((Index(leaf[1]) << 64) | leaf[0], leafBits)) {
+                    return {};
+                }
+
+                for (auto const word : leafBits) {
+                    block->allocated += static_cast<unsigned>(std::popcount(word));
+                }
+            }
+        }
+
+        pool.blocks.push_back(std::move(block));
+    }
+
+    if (! file.atEnd()) {
+        return {};
+    }
+
+    return pool;
+}
@@ -0,0 +1,131 @@
+//
+//  AddressPool.hpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+#pragma once
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <vector>
+
+#include "NetworkPrefix.hpp"
+
+/**
+ * @class AddressPool
+ * @brief Allocates the addresses of one or more prefixes, e.g. for IP address management.
+ *
+ * Prefixes with up to 2^24 addresses keep a bit per address, below levels of
+ * summary bits of the words with free addresses, so the lowest free address
+ * is found by descending a handful of words. Larger prefixes (such as IPv6
+ * /64s) keep a radix tree over 256-address leaves which only holds the parts
+ * with allocated addresses. Allocating, reserving and releasing an address
+ * take a constant number of steps either way.
+ *
+ * The state can be saved to a compact binary file and loaded again by
+ * mapping it into memory. The file uses the native byte order.
+ *
+ * The pool is not thread-safe.
+ */
+class AddressPool
+{
+public:
+    using Index = AddressRange::Index;
+
+    //===============================================================
+    /**
+     * @brief Default constructor.
+     *
+     * Creates a pool without addresses.
+     */
+    AddressPool();
+
+    /**
+     * @brief Creates a pool with all addresses of the prefixes free.
+     *
+     * Invalid prefixes are ignored, as are prefixes overlapping an earlier
+     * one, so that no address is handed out twice. Use reserve() to exclude
+     * addresses such as the network, gateway or broadcast address.
+     *
+     * @param prefixes The prefixes in the order in which they are allocated from.
+     */
+    explicit AddressPool(std::vector<NetworkPrefix> const& prefixes);
+
+    AddressPool(AddressPool&&) noexcept;
+    AddressPool& operator=(AddressPool&&) noexcept;
+    ~AddressPool();
+
+    //===============================================================
+    /**
+     * @brief Allocates the lowest free address of the first prefix with free addresses.
+     *
+     * @param family Only allocates from prefixes of this family unless unspecified.
+     * @return The address (with port 0) or nullopt if all addresses are allocated.
+     */
+    std::optional<NetworkAddress> allocate(NetworkAddress::Family family = NetworkAddress::Family::unspecified);
+
+    /**
+     * @brief Allocates a specific address.
+     *
+     * @return False if the address is not in the pool or already allocated.
+     */
+    bool reserve(NetworkAddress const& addr);
+
+    /**
+     * @brief Frees an allocated or reserved address.
+     *
+     * @return False if the address is not in the pool or not allocated.
+     */
+    bool release(NetworkAddress const& addr);
+
+    /** Checks if an address of the pool is allocated. The port is ignored. */
+    bool isAllocated(NetworkAddress const& addr) const;
+
+    //===============================================================
+    /** The prefixes of the pool. */
+    std::vector<NetworkPrefix> prefixes() const;
+
+    /** The prefixes of the pool, allocated from a memory resource. */
+    std::pmr::vector<NetworkPrefix> prefixes(std::pmr::memory_resource* resource) const;
+
+    /** The number of allocated addresses. */
+    Index size() const noexcept;
+
+    /** The number of addresses, saturated at the maximum of Index. */
+    Index capacity() const noexcept;
+
+    //===============================================================
+    /**
+     * @brief Saves the prefixes and allocated addresses.
+     *
+     * The file is written next to the path, synced to disk and then renamed,
+     * so an existing file is only replaced by a complete one, even if the
+     * system crashes meanwhile.
+     *
+     * @return False if the file could not be written.
+     */
+    bool save(std::filesystem::path const& path) const;
+
+    /**
+     * @brief Loads a pool saved with save().
+     *
+     * @return The pool or nullopt if the file could not be read or is
+     *         malformed, e.g. has overlapping prefixes.
+     */
+    static std::optional<AddressPool> load(std::filesystem::path const& path);
+
+private:
+    struct Block;
+
+    Block* blockOf(NetworkAddress const& addr, Index& offset) const;
+    bool overlapsBlock(NetworkPrefix const& prefix) const;
+
+    std::vector<std::unique_ptr<Block>> blocks;
+};
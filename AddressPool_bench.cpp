@@ -0,0 +1,95 @@
+//
+//  AddressPool_bench.cpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <deque>
+#include <filesystem>
+
+#include <unistd.h>
+
+#include "AddressPool.hpp"
+
+namespace
+{
+// a dense IPv4 /8 and a sparse IPv6 /64
+NetworkPrefix poolPrefix(std::int64_t sparse) {
+    return *NetworkPrefix::fromString(sparse != 0 ? "2001:db8::/64" : "10.0.0.0/8");
+}
+
+constexpr int kLeases = 1 << 20;
+}
+
+//===============================================================
+// Churn: release the oldest of 1M leases and allocate a new one
+static void BM_AddressPoolChurn(benchmark::State& state) {
+    AddressPool pool({poolPrefix(state.range(0))});
+    std::deque<NetworkAddress> leases;
+
+    for (int i = 0; i < kLeases; ++i) {
+        leases.push_back(*pool.allocate());
+    }
+
+    for (auto _ : state) {
+        pool.release(leases.front());
+        leases.pop_front();
+        leases.push_back(*pool.allocate());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AddressPoolChurn)->ArgName("sparse")->Arg(0)->Arg(1);
+
+// ... compared to scanning a list of addresses for a free slot
+static void BM_Baseline_ListScan(benchmark::State& state) {
+    struct Slot { NetworkAddress address; bool used; };
+    std::vector<Slot> slots;
+
+    for (std::uint32_t i = 0; i < 4096; ++i) {
+        slots.push_back({ NetworkAddress(0x0a000000 + i), i % 2 == 0 });
+    }
+
+    std::size_t next = 1;
+
+    for (auto _ : state) {
+        auto it = std::find_if(slots.begin(), slots.end(), [] (Slot const& s) { return ! s.used; });
+        it->used = true;
+        benchmark::DoNotOptimize(it->address);
+
+        slots[next].used = false;
+        next = (next + 2) % slots.size();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Baseline_ListScan);
+
+// Restoring 1M leases from a saved pool
+static void BM_AddressPoolLoad(benchmark::State& state) {
+    auto const path = std::filesystem::temp_directory_path() / ("cxxnetaddr_bench_pool_" + std::to_string(::getpid()));
+
+    {
+        AddressPool pool({poolPrefix(state.range(0))});
+
+        for (int i = 0; i < kLeases; ++i) {
+            pool.allocate();
+        }
+
+        pool.save(path);
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(AddressPool::load(path));
+    }
+
+    std::filesystem::remove(path);
+    state.SetItemsProcessed(state.iterations() * kLeases);
+}
+BENCHMARK(BM_AddressPoolLoad)->ArgName("sparse")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
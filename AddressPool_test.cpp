@@ -0,0 +1,191 @@
+//
+//  AddressPool_test.cpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <set>
+
+#include <unistd.h>
+
+#include "AddressPool.hpp"
+
+namespace
+{
+NetworkPrefix prefix(char const* str) {
+    return *NetworkPrefix::fromString(str);
+}
+
+NetworkAddress addr(char const* str) {
+    return *NetworkAddress::fromIPString(str);
+}
+}
+
+// Test that the lowest free address is allocated and released addresses are reused
+TEST(AddressPoolTest, AllocatesLowestFree) {
+    AddressPool pool({prefix("10.1.2.0/24")});
+    EXPECT_EQ(pool.capacity(), 256u);
+
+    for (unsigned i = 0; i < 256; ++i) {
+        auto const allocated = pool.allocate();
+        ASSERT_TRUE(allocated);
+        EXPECT_EQ(*allocated, NetworkAddress(0x0a010200 + i));
+    }
+
+    EXPECT_FALSE(pool.allocate().has_value());
+    EXPECT_EQ(pool.size(), 256u);
+
+    EXPECT_TRUE(pool.release(addr("10.1.2.77")));
+    EXPECT_FALSE(pool.release(addr("10.1.2.77")));
+    EXPECT_FALSE(pool.isAllocated(addr("10.1.2.77")));
+    EXPECT_TRUE(pool.isAllocated(addr("10.1.2.78")));
+    EXPECT_EQ(pool.allocate(), addr("10.1.2.77"));
+}
+
+// Test reserving specific addresses and allocating around them
+TEST(AddressPoolTest, ReservesAddresses) {
+    AddressPool pool({prefix("192.168.0.0/30"), prefix("fd00::/126")});
+
+    EXPECT_TRUE(pool.reserve(addr("192.168.0.0")));
+    EXPECT_TRUE(pool.reserve(addr("192.168.0.3:80")));
+    EXPECT_FALSE(pool.reserve(addr("192.168.0.3")));
+    EXPECT_FALSE(pool.reserve(addr("192.168.0.4")));
+    EXPECT_FALSE(pool.release(addr("10.0.0.1")));
+
+    EXPECT_EQ(pool.allocate(), addr("192.168.0.1"));
+    EXPECT_EQ(pool.allocate(NetworkAddress::Family::ipv6), addr("fd00::"));
+    EXPECT_EQ(pool.allocate(), addr("192.168.0.2"));
+    EXPECT_EQ(pool.allocate(), addr("fd00::1"));
+    EXPECT_EQ(pool.size(), 6u);
+    EXPECT_EQ(pool.capacity(), 8u);
+}
+
+// Test the sparse representation of large prefixes against a reference
+TEST(AddressPoolTest, SparsePrefixes) {
+    for (auto const* str : {"2001:db8::/64", "10.0.0.0/7", "::/0"}) {
+        auto const p = prefix(str);
+        AddressPool pool({p});
+        std::set<NetworkAddress> reference;
+
+        for (int i = 0; i < 600; ++i) {
+            auto const allocated = pool.allocate();
+            ASSERT_TRUE(allocated);
+            EXPECT_EQ(*allocated, p.addresses()[static_cast<AddressPool::Index>(i)]);
+            reference.insert(*allocated);
+        }
+
+        // addresses far apart and at the very end of the prefix
+        auto const range = p.addresses();
+        std::mt19937_64 rng(1);
+
+        for (int i = 0; i < 200; ++i) {
+            auto const a = range[((AddressPool::Index(rng()) << 64) | rng()) % range.size()];
+            EXPECT_EQ(pool.reserve(a), reference.insert(a).second);
+        }
+
+        EXPECT_TRUE(pool.reserve(p.last()));
+        reference.insert(p.last());
+
+        for (int i = 0; i < 300; ++i) {
+            auto const a = range[static_cast<AddressPool::Index>(rng() % 700)];
+            EXPECT_EQ(pool.release(a), reference.erase(a) == 1) << a.toString();
+        }
+
+        EXPECT_EQ(pool.size(), reference.size());
+
+        for (auto const& a : reference) {
+            EXPECT_TRUE(pool.isAllocated(a)) << a.toString();
+        }
+
+        // the lowest released address comes back first
+        auto const lowest = std::find_if(range.begin(), range.end(), [&reference] (auto const& a) { return ! reference.contains(a); });
+        EXPECT_EQ(pool.allocate(), *lowest);
+    }
+}
+
+// Test that saved pools load with the same allocations
+TEST(AddressPoolTest, SavesAndLoads) {
+    auto const path = std::filesystem::temp_directory_path() / ("cxxnetaddr_pool_" + std::to_string(::getpid()));
+    AddressPool pool({prefix("10.0.0.0/16"), prefix("2001:db8:1::/64")});
+
+    for (int i = 0; i < 5000; ++i) {
+        pool.allocate(i % 2 == 0 ? NetworkAddress::Family::ipv4 : NetworkAddress::Family::ipv6);
+    }
+
+    pool.release(addr("10.0.0.10"));
+    pool.reserve(addr("10.0.255.255"));
+    pool.reserve(addr("2001:db8:1::ffff:ffff:ffff:ffff"));
+    ASSERT_TRUE(pool.save(path));
+
+    auto loaded = AddressPool::load(path);
+    ASSERT_TRUE(loaded);
+    EXPECT_EQ(loaded->prefixes(), pool.prefixes());
+    EXPECT_EQ(loaded->size(), pool.size());
+    EXPECT_FALSE(loaded->isAllocated(addr("10.0.0.10")));
+    EXPECT_TRUE(loaded->isAllocated(addr("10.0.255.255")));
+    EXPECT_TRUE(loaded->isAllocated(addr("2001:db8:1::ffff:ffff:ffff:ffff")));
+    EXPECT_TRUE(loaded->isAllocated(addr("2001:db8:1::9c3")));
+
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(loaded->allocate(), pool.allocate());
+    }
+
+    // truncated and missing files
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 8);
+    EXPECT_FALSE(AddressPool::load(path).has_value());
+    std::filesystem::remove(path);
+    EXPECT_FALSE(AddressPool::load(path).has_value());
+
+    // failing to replace the file leaves no temporary file behind
+    std::filesystem::create_directories(path / "occupied");
+    EXPECT_FALSE(pool.save(path));
+    EXPECT_FALSE(std::filesystem::exists(path.string() + ".tmp"));
+    EXPECT_FALSE(pool.save(path / "missing" / "pool"));
+    std::filesystem::remove_all(path);
+}
+
+// Test that overlapping prefixes do not hand out addresses twice
+TEST(AddressPoolTest, IgnoresOverlappingPrefixes) {
+    AddressPool pool({prefix("10.0.0.0/30"), prefix("10.0.0.0/29"), prefix("10.0.0.4/30"), prefix("10.0.0.0/8")});
+    EXPECT_EQ(pool.prefixes(), (std::vector<NetworkPrefix> {prefix("10.0.0.0/30"), prefix("10.0.0.4/30")}));
+    EXPECT_EQ(pool.capacity(), 8u);
+
+    std::set<NetworkAddress> allocated;
+
+    while (auto const a = pool.allocate()) {
+        EXPECT_TRUE(allocated.insert(*a).second) << a->toString();
+    }
+
+    EXPECT_EQ(allocated.size(), 8u);
+    EXPECT_EQ(pool.size(), 8u);
+
+    // files with overlapping prefixes are malformed
+    auto const path = std::filesystem::temp_directory_path() / ("cxxnetaddr_pool_overlap_" + std::to_string(::getpid()));
+    ASSERT_TRUE(pool.save(path));
+    ASSERT_TRUE(AddressPool::load(path).has_value());
+
+    {
+        // the network of the second prefix: after the file header, the first block header and its word
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        std::uint64_t network = 0;
+        file.seekg(16 + 32 + 8);
+        file.read(reinterpret_cast<char*>(&network), sizeof(network));
+        ASSERT_EQ(network, 0x0a000004u);
+
+        network = 0x0a000000;
+        file.seekp(16 + 32 + 8);
+        file.write(reinterpret_cast<char const*>(&network), sizeof(network));
+    }
+
+    EXPECT_FALSE(AddressPool::load(path).has_value());
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,171 @@
+//
+//  AddressStringCache.cpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+#include "AddressStringCache.hpp"
+
+//===============================================================
+// Entries never change after they were created, so handles can read
+// their text without holding any lock.
+struct AddressStringCache::Entry
+{
+    explicit Entry(NetworkAddress const& addr) : address(addr) {
+        auto const result = addr.toChars(text, text + sizeof(text));
+        length = result.ec == std::errc() ? static_cast<std::size_t>(result.ptr - text) : 0;
+    }
+
+    NetworkAddress address;
+    std::size_t length;
+    char text[NetworkAddress::kMaxStringLength];
+};
+
+std::string_view AddressStringCache::Handle::view() const noexcept {
+    return entry != nullptr ? std::string_view(entry->text, entry->length) : std::string_view();
+}
+
+//===============================================================
+struct AddressStringCache::Shard
+{
+    struct Slot
+    {
+        std::shared_ptr<Entry const> entry;
+        bool referenced = false;
+    };
+
+    explicit Shard(std::size_t capacity) : slots(capacity) { index.reserve(capacity); }
+
+    std::shared_ptr<Entry const> find(NetworkAddress const& addr) {
+        if (auto it = index.find(addr); it != index.end()) {
+            auto& slot = slots[it->second];
+            slot.referenced = true;
+            return slot.entry;
+        }
+
+        return {};
+    }
+
+    void insert(std::shared_ptr<Entry const> entry) {
+        auto const i = evict();
+
+        if (slots[i].entry != nullptr) {
+            index.erase(slots[i].entry->address);
+            ++stats.evictions;
+        }
+
+        index.emplace(entry->address, i);
+        slots[i] = Slot { std::move(entry), false };
+    }
+
+    // the CLOCK algorithm: the first unused slot, otherwise the first slot
+    // after the hand that was not referenced since the hand last passed
+    std::size_t evict() noexcept {
+        if (used < slots.size()) {
+            return used++;
+        }
+
+        for (;; hand = (hand + 1) % slots.size()) {
+            if (! std::exchange(slots[hand].referenced, false)) {
+                auto const result = hand;
+                hand = (hand + 1) % slots.size();
+                return result;
+            }
+        }
+    }
+
+    void clear() {
+        index.clear();
+        std::fill(slots.begin(), slots.end(), Slot());
+        used = hand = 0;
+    }
+
+    std::mutex lock;
+    std::vector<Slot> slots;
+    std::unordered_map<NetworkAddress, std::size_t> index;
+    std::size_t used = 0, hand = 0;
+    Stats stats;
+};
+
+//===============================================================
+AddressStringCache::AddressStringCache(std::size_t capacity, std::size_t numShards) {
+    // every shard needs a slot, and the first shards take the remainder
+    capacity = std::max(std::size_t(1), capacity);
+    numShards = std::clamp(numShards, std::size_t(1), capacity);
+
+    for (std::size_t i = 0; i < numShards; ++i) {
+        shards.push_back(std::make_unique<Shard>(capacity / numShards + (i < capacity % numShards ? 1 : 0)));
+    }
+}
+
+AddressStringCache::~AddressStringCache() = default;
+
+AddressStringCache::Shard& AddressStringCache::shardOf(std::size_t hash) noexcept {
+    return *shards[hash % shards.size()];
+}
+
+AddressStringCache::Handle AddressStringCache::get(NetworkAddress const& addr) {
+    auto& shard = shardOf(addr.hash());
+
+    {
+        std::lock_guard guard(shard.lock);
+
+        if (auto entry = shard.find(addr)) {
+            ++shard.stats.hits;
+            return Handle(std::move(entry));
+        }
+    }
+
+    // format outside of the lock
+    auto entry = std::make_shared<Entry const>(addr);
+    std::lock_guard guard(shard.lock);
+
+    ++shard.stats.misses;
+
+    // another thread may have added the address in the meantime
+    if (auto existing = shard.find(addr)) {
+        return Handle(std::move(existing));
+    }
+
+    shard.insert(entry);
+    return Handle(std::move(entry));
+}
+
+std::size_t AddressStringCache::capacity() const noexcept {
+    std::size_t result = 0;
+
+    for (auto const& shard : shards) {
+        result += shard->slots.size();
+    }
+
+    return result;
+}
+
+AddressStringCache::Stats AddressStringCache::stats() const {
+    Stats result;
+
+    for (auto const& shard : shards) {
+        std::lock_guard guard(shard->lock);
+        result.hits      += shard->stats.hits;
+        result.misses    += shard->stats.misses;
+        result.evictions += shard->stats.evictions;
+    }
+
+    return result;
+}
+
+void AddressStringCache::clear() {
+    for (auto const& shard : shards) {
+        std::lock_guard guard(shard->lock);
+        shard->clear();
+    }
+}
@@ -0,0 +1,126 @@
+//
+//  AddressStringCache.hpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "NetworkAddress.hpp"
+
+/**
+ * @class AddressStringCache
+ * @brief A bounded cache of the text of frequently formatted addresses.
+ *
+ * get() returns the text of toString() and formats each address only on
+ * a miss. The cache is split into shards, selected by the address' hash,
+ * each with its own lock and CLOCK eviction: a hit marks an entry as
+ * recently used, and eviction skips (and clears) marked entries.
+ *
+ * The returned Handle keeps its text alive even if the entry is evicted
+ * meanwhile.
+ */
+class AddressStringCache
+{
+    struct Entry;
+
+public:
+    //===============================================================
+    /**
+     * @class Handle
+     * @brief The cached text of an address.
+     */
+    class Handle
+    {
+    public:
+        /** The text; empty for an empty handle. */
+        std::string_view view() const noexcept;
+        operator std::string_view() const noexcept { return view(); }
+
+        /** A copy of the text. */
+        std::string toString() const { return std::string(view()); }
+
+    private:
+        friend class AddressStringCache;
+        explicit Handle(std::shared_ptr<Entry const> e) : entry(std::move(e)) {}
+
+        std::shared_ptr<Entry const> entry;
+    };
+
+    /**
+     * @struct Stats
+     * @brief Hit and miss counters.
+     */
+    struct Stats
+    {
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+        std::uint64_t evictions = 0;
+
+        /** The fraction of lookups that were hits, or zero without lookups. */
+        double hitRate() const noexcept {
+            auto const lookups = hits + misses;
+            return lookups != 0 ? static_cast<double>(hits) / static_cast<double>(lookups) : 0.0;
+        }
+    };
+
+    //===============================================================
+    /**
+     * @brief Creates an empty cache.
+     *
+     * @param capacity The maximum number of addresses (at least one), split
+     *        among the shards.
+     * @param shards The number of independently locked shards, at most one
+     *        per address of the capacity.
+     */
+    explicit AddressStringCache(std::size_t capacity = 4096, std::size_t shards = 16);
+    ~AddressStringCache();
+
+    AddressStringCache(AddressStringCache const&) = delete;
+    AddressStringCache& operator=(AddressStringCache const&) = delete;
+
+    /**
+     * @brief Gets the text of an address, formatting it on a miss.
+     *
+     * @param addr The address.
+     * @return A handle to the same text as addr.toString().
+     */
+    Handle get(NetworkAddress const& addr);
+
+    /** The number of addresses the cache can hold, i.e. the capacity it was created with. */
+    std::size_t capacity() const noexcept;
+
+    /** The sums of the counters of all shards. */
+    Stats stats() const;
+
+    /** Removes all entries; handles stay valid. */
+    void clear();
+
+private:
+    struct Shard;
+
+    Shard& shardOf(std::size_t hash) noexcept;
+
+    std::vector<std::unique_ptr<Shard>> shards;
+};
+
+#if defined(__cpp_lib_format)
+/** Formats a handle as its text, e.g. std::format("{:>40}", cache.get(addr)). */
+template <>
+struct std::formatter<AddressStringCache::Handle> : std::formatter<std::string_view>
+{
+    auto format(AddressStringCache::Handle const& handle, std::format_context& ctx) const {
+        return std::formatter<std::string_view>::format(handle.view(), ctx);
+    }
+};
+#endif
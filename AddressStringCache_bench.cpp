@@ -0,0 +1,74 @@
+//
+//  AddressStringCache_bench.cpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "AddressStringCache.hpp"
+
+namespace
+{
+int const kMaxThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+// a few hot peers and a long tail, like the peers of a busy service
+std::vector<NetworkAddress> const& peers() {
+    static auto const result = [] {
+        std::mt19937_64 rng(42);
+        std::vector<NetworkAddress> addrs;
+
+        for (std::size_t i = 0; i < 4096; ++i) {
+            auto const hot = rng() % 10 < 8;
+            auto const host = hot ? static_cast<std::uint32_t>(rng() % 16) : static_cast<std::uint32_t>(rng());
+            addrs.emplace_back(0x0a000000u | (host & 0xffffff), static_cast<std::uint16_t>(hot ? 443 : rng()));
+        }
+
+        return addrs;
+    }();
+
+    return result;
+}
+
+AddressStringCache& sharedCache() {
+    static AddressStringCache cache(1024);
+    return cache;
+}
+}
+
+//===============================================================
+static void BM_AddressStringCacheGet(benchmark::State& state) {
+    auto const& addrs = peers();
+    std::size_t i = static_cast<std::size_t>(state.thread_index()) * 97;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sharedCache().get(addrs[i++ % addrs.size()]));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0) {
+        state.counters["hit_rate"] = sharedCache().stats().hitRate();
+    }
+}
+BENCHMARK(BM_AddressStringCacheGet)->ThreadRange(1, kMaxThreads)->UseRealTime();
+
+static void BM_Baseline_ToString(benchmark::State& state) {
+    auto const& addrs = peers();
+    std::size_t i = 0;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(addrs[i++ % addrs.size()].toString());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Baseline_ToString)->ThreadRange(1, kMaxThreads)->UseRealTime();
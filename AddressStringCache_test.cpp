@@ -0,0 +1,109 @@
+//
+//  AddressStringCache_test.cpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "AddressStringCache.hpp"
+
+// Test that the cache returns the text of toString and counts hits
+TEST(AddressStringCacheTest, ReturnsCanonicalText) {
+    AddressStringCache cache(64, 4);
+    std::vector<NetworkAddress> const addrs = {
+        NetworkAddress(192, 168, 1, 1, 8080),
+        *NetworkAddress::fromIPString("[2001:db8::1]:443"),
+        NetworkAddress(0x00, 0x1A, 0x2B, 0x3C, 0x4D, 0x5E),
+        NetworkAddress::fromUNIXSocketPath("/tmp/socket")
+    };
+
+    for (int round = 0; round < 3; ++round) {
+        for (auto const& addr : addrs) {
+            std::string_view const text = cache.get(addr);
+            EXPECT_EQ(text, addr.toString());
+        }
+    }
+
+    auto const stats = cache.stats();
+    EXPECT_EQ(stats.misses, addrs.size());
+    EXPECT_EQ(stats.hits, 2 * addrs.size());
+    EXPECT_DOUBLE_EQ(stats.hitRate(), 2.0 / 3.0);
+    EXPECT_EQ(stats.evictions, 0u);
+}
+
+// Test that the cache is bounded and that CLOCK keeps recently used entries
+TEST(AddressStringCacheTest, EvictsUnreferencedEntries) {
+    AddressStringCache cache(8, 1);
+    ASSERT_EQ(cache.capacity(), 8u);
+    NetworkAddress const hot(10, 0, 0, 1);
+
+    auto const evicted = cache.get(NetworkAddress(10, 1, 0, 0));
+    cache.get(hot);
+
+    for (std::uint8_t i = 1; i < 100; ++i) {
+        cache.get(NetworkAddress(10, 1, 0, i));
+        // keep the hot address referenced
+        cache.get(hot);
+    }
+
+    auto const before = cache.stats();
+    EXPECT_EQ(before.misses, 101u);
+    EXPECT_EQ(before.evictions, 101u - 8u);
+
+    cache.get(hot);
+    EXPECT_EQ(cache.stats().hits, before.hits + 1);
+
+    // handles outlive the eviction of their entries
+    EXPECT_EQ(evicted.view(), "10.1.0.0");
+    cache.clear();
+    EXPECT_EQ(evicted.toString(), "10.1.0.0");
+}
+
+// Test that the capacity is the requested one, however it is split among the shards
+TEST(AddressStringCacheTest, KeepsRequestedCapacity) {
+    EXPECT_EQ(AddressStringCache(10, 4).capacity(), 10u);
+    EXPECT_EQ(AddressStringCache(4096, 16).capacity(), 4096u);
+    EXPECT_EQ(AddressStringCache(3, 16).capacity(), 3u);
+    EXPECT_EQ(AddressStringCache(0, 0).capacity(), 1u);
+}
+
+#if defined(__cpp_lib_format)
+// Test that handles can be formatted
+TEST(AddressStringCacheTest, StdFormat) {
+    AddressStringCache cache;
+    EXPECT_EQ(std::format("{}", cache.get(NetworkAddress(192, 168, 1, 1, 8080))), "192.168.1.1:8080");
+    EXPECT_EQ(std::format("[{:>8}]", cache.get(NetworkAddress(10, 0, 0, 1))), "[10.0.0.1]");
+    EXPECT_EQ(std::format("[{:>9}]", cache.get(NetworkAddress(10, 0, 0, 1))), "[ 10.0.0.1]");
+}
+#endif
+
+// Test concurrent lookups
+TEST(AddressStringCacheTest, ConcurrentLookups) {
+    AddressStringCache cache(256);
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&cache, t] {
+            for (std::uint32_t i = 0; i < 5000; ++i) {
+                NetworkAddress const addr(0x0a000000u + (i * 7 + static_cast<std::uint32_t>(t)) % 512, 80);
+                ASSERT_EQ(cache.get(addr).view(), addr.toString());
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    auto const stats = cache.stats();
+    EXPECT_EQ(stats.hits + stats.misses, 4u * 5000u);
+    EXPECT_GT(stats.hits, 0u);
+}
@@ -0,0 +1,212 @@
+//
+//  Allocation_test.cpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+
+#include "AddressPool.hpp"
+#include "NetworkAddress.hpp"
+#include "NetworkInterface.hpp"
+#include "NetworkPrefix.hpp"
+
+//===============================================================
+// Allocation counting: the global operator new/delete are replaced for the
+// whole test binary and, with glibc, malloc & co. are interposed as well so
+// that allocations made by C library calls are caught too. Counting is only
+// active on the thread which armed an AllocationCounter.
+namespace
+{
+thread_local bool isArmed = false;
+thread_local std::size_t numAllocations = 0;
+
+void countAllocation() noexcept {
+    if (isArmed) {
+        ++numAllocations;
+    }
+}
+
+class AllocationCounter
+{
+public:
+    AllocationCounter() noexcept  { numAllocations = 0; isArmed = true; }
+    ~AllocationCounter() noexcept { isArmed = false; }
+
+    std::size_t allocations() const noexcept { return numAllocations; }
+};
+}
+
+#if defined(__GLIBC__)
+extern "C" {
+void* __libc_malloc(std::size_t);
+void* __libc_calloc(std::size_t, std::size_t);
+void* __libc_realloc(void*, std::size_t);
+void  __libc_free(void*);
+
+void* malloc(std::size_t size)                   { countAllocation(); return __libc_malloc(size); }
+void* calloc(std::size_t num, std::size_t size)  { countAllocation(); return __libc_calloc(num, size); }
+void* realloc(void* ptr, std::size_t size)       { countAllocation(); return __libc_realloc(ptr, size); }
+void  free(void* ptr)                            { __libc_free(ptr); }
+}
+
+namespace
+{
+void* rawAllocate(std::size_t size) noexcept { return __libc_malloc(size == 0 ? 1 : size); }
+void rawFree(void* ptr) noexcept             { __libc_free(ptr); }
+}
+#else
+namespace
+{
+void* rawAllocate(std::size_t size) noexcept { return std::malloc(size == 0 ? 1 : size); }
+void rawFree(void* ptr) noexcept             { std::free(ptr); }
+}
+#endif
+
+void* operator new(std::size_t size) {
+    countAllocation();
+
+    if (auto* ptr = rawAllocate(size); ptr != nullptr) {
+        return ptr;
+    }
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)                        { return operator new(size); }
+void* operator new(std::size_t size, std::nothrow_t const&) noexcept   { countAllocation(); return rawAllocate(size); }
+void* operator new[](std::size_t size, std::nothrow_t const&) noexcept { countAllocation(); return rawAllocate(size); }
+void operator delete(void* ptr) noexcept                      { rawFree(ptr); }
+void operator delete[](void* ptr) noexcept                    { rawFree(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept         { rawFree(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept       { rawFree(ptr); }
+
+//===============================================================
+namespace
+{
+// Runs fn once to warm up (lazy initialisation is allowed to allocate)
+// and then counts the allocations of a number of steady-state calls.
+template <typename Fn>
+std::size_t steadyStateAllocations(Fn&& fn) {
+    fn();
+
+    AllocationCounter counter;
+    for (int i = 0; i < 16; ++i) {
+        fn();
+    }
+
+    return counter.allocations();
+}
+}
+
+// Test that the harness itself catches allocations
+TEST(AllocationTest, CountsAllocations) {
+    EXPECT_GT(steadyStateAllocations([] { auto* p = new int(1); delete p; }), 0u);
+    EXPECT_GT(steadyStateAllocations([] { std::free(std::malloc(16)); }), 0u);
+    EXPECT_GT(steadyStateAllocations([] { std::string s(64, 'x'); EXPECT_EQ(s.size(), 64u); }), 0u);
+}
+
+// Test that value semantics and accessors never allocate
+TEST(AllocationTest, ValueSemanticsDoNotAllocate) {
+    NetworkAddress const v4(192, 168, 1, 1, 80);
+    NetworkAddress const v6(0x2001, 0xdb8, 0, 0, 0, 0, 0, 1, 443);
+
+    EXPECT_EQ(steadyStateAllocations([&] {
+        NetworkAddress copy(v6);
+        NetworkAddress moved(std::move(copy));
+        copy = v4;
+        moved = std::move(copy);
+        EXPECT_TRUE(moved == v4);
+        EXPECT_TRUE((v4 <=> v6) != 0);
+    }), 0u);
+
+    EXPECT_EQ(steadyStateAllocations([&] {
+        EXPECT_EQ(v6.port(), 443);
+        EXPECT_EQ(v4.family(), NetworkAddress::Family::ipv4);
+        EXPECT_EQ(v4.withPort(8080).port(), 8080);
+        EXPECT_TRUE(v6.valid());
+        EXPECT_FALSE(v6.isMulticast());
+    }), 0u);
+}
+
+// Test that formatting into a buffer never allocates
+TEST(AllocationTest, ToCharsDoesNotAllocate) {
+    auto const addrs = std::array {
+        NetworkAddress(10, 0, 0, 1, 65535),
+        NetworkAddress(0x2001, 0xdb8, 0, 0, 0, 0xff00, 0x42, 0x8329, 80),
+        *NetworkAddress::fromIPString("fe80::1%lo"),
+        *NetworkAddress::fromIPString("::ffff:1.2.3.4"),
+        NetworkAddress(0x00, 0x1A, 0x2B, 0x3C, 0x4D, 0x5E),
+        NetworkAddress::fromUNIXSocketPath("/tmp/cxxnetaddr.sock")
+    };
+
+    for (auto const& addr : addrs) {
+        EXPECT_EQ(steadyStateAllocations([&addr] {
+            char buffer[NetworkAddress::kMaxStringLength];
+            EXPECT_EQ(addr.toChars(buffer, buffer + sizeof(buffer)).ec, std::errc());
+        }), 0u);
+    }
+}
+
+// Test that parsing never allocates
+TEST(AllocationTest, ParsingDoesNotAllocate) {
+    for (std::string_view str : {"192.168.100.200:3000", "[2001:db8:85a3::8a2e:370:7334]:443", "fe80::1%lo", "::ffff:10.1.2.3", "not an address"}) {
+        EXPECT_EQ(steadyStateAllocations([str] { (void) NetworkAddress::fromIPString(str); }), 0u) << str;
+    }
+
+    EXPECT_EQ(steadyStateAllocations([] { EXPECT_TRUE(NetworkAddress::fromMACString("00:1A:2B:3C:4D:5E").has_value()); }), 0u);
+    EXPECT_EQ(steadyStateAllocations([] { EXPECT_FALSE(NetworkAddress::fromMACString("00:1A:2B:3C:4D").has_value()); }), 0u);
+}
+
+// Test that interface lookups by index and (short) name never allocate
+TEST(AllocationTest, InterfaceLookupDoesNotAllocate) {
+    auto const index = NetworkInterface::fromString("lo")->getIndex();
+
+    EXPECT_EQ(steadyStateAllocations([index] { EXPECT_TRUE(NetworkInterface::fromIntfIndex(index).has_value()); }), 0u);
+    EXPECT_EQ(steadyStateAllocations([] { EXPECT_TRUE(NetworkInterface::fromString("lo").has_value()); }), 0u);
+}
+
+// Test that the pmr overloads allocate from the given memory resource only
+TEST(AllocationTest, PmrOverloadsUseMemoryResource) {
+    std::array<std::byte, 16384> arena;
+    auto const addr = *NetworkAddress::fromIPString("[2001:db8:85a3::8a2e:370:7334]:443");
+    auto const prefix = *NetworkPrefix::fromString("2001:db8:85a3::/48");
+
+    EXPECT_EQ(steadyStateAllocations([&] {
+        std::pmr::monotonic_buffer_resource resource(arena.data(), arena.size(), std::pmr::null_memory_resource());
+        EXPECT_EQ(addr.toString(&resource), "[2001:db8:85a3::8a2e:370:7334]:443");
+        EXPECT_EQ(prefix.toString(&resource), "2001:db8:85a3::/48");
+        EXPECT_TRUE(NetworkPrefix::fromString("10.0.0.0/8").has_value());
+    }), 0u);
+
+    std::uint32_t const saddrs[] = {0x0a000001, 0xc0a80101};
+    std::uint16_t const ports[] = {80, 443};
+    AddressPool const pool({prefix, *NetworkPrefix::fromString("10.0.0.0/24")});
+
+    EXPECT_EQ(steadyStateAllocations([&] {
+        std::pmr::monotonic_buffer_resource resource(arena.data(), arena.size(), std::pmr::null_memory_resource());
+        EXPECT_TRUE(std::ranges::equal(NetworkAddress::fromIPv4Array(&resource, saddrs, ports),
+                                       std::array {NetworkAddress(10, 0, 0, 1, 80), NetworkAddress(192, 168, 1, 1, 443)}));
+        EXPECT_TRUE(std::ranges::equal(pool.prefixes(&resource), std::array {prefix, *NetworkPrefix::fromString("10.0.0.0/24")}));
+    }), 0u);
+
+    // getifaddrs allocates internally, but the returned vectors must come from the arena
+    std::pmr::monotonic_buffer_resource resource(arena.data(), arena.size(), std::pmr::null_memory_resource());
+    auto const intfs = NetworkInterface::getAllInterfaces(&resource);
+    EXPECT_TRUE(std::ranges::equal(intfs, NetworkInterface::getAllInterfaces()));
+    EXPECT_EQ(intfs.get_allocator().resource(), &resource);
+
+    auto const loopback = NetworkInterface::fromString("lo");
+    ASSERT_TRUE(loopback.has_value());
+    auto const addrs = loopback->getAddresses(&resource, NetworkAddress::Family::ipv4);
+    EXPECT_TRUE(std::ranges::equal(addrs, loopback->getAddresses(NetworkAddress::Family::ipv4)));
+}
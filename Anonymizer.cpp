@@ -0,0 +1,371 @@
+//
+//  Anonymizer.cpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+ #include <immintrin.h>
+ #define CXXNETADDR_HAS_AESNI 1
+#else
+ #define CXXNETADDR_HAS_AESNI 0
+#endif
+
+#include "CxxUtilities.hpp"
+#include "Anonymizer.hpp"
+
+namespace
+{
+//===============================================================
+// AES-128 (FIPS-197). The software implementation is only used if the
+// CPU does not support AES-NI; the key schedule is shared by both.
+using uint128 = unsigned __int128;
+
+constexpr std::uint8_t xtime(std::uint8_t x) noexcept {
+    return static_cast<std::uint8_t>((x << 1) ^ ((x & 0x80) != 0 ? 0x1b : 0x00));
+}
+
+constexpr std::uint8_t rotl8(std::uint8_t x, int shift) noexcept {
+    return static_cast<std::uint8_t>((x << shift) | (x >> (8 - shift)));
+}
+
+constexpr auto kSBox = std::invoke([] {
+    std::array<std::uint8_t, 256> sbox = {};
+    std::uint8_t p = 1, q = 1;
+
+    // p runs through all non-zero field elements as powers of 3, q is its inverse
+    do {
+        p = static_cast<std::uint8_t>(p ^ xtime(p));
+        q ^= static_cast<std::uint8_t>(q << 1);
+        q ^= static_cast<std::uint8_t>(q << 2);
+        q ^= static_cast<std::uint8_t>(q << 4);
+        q ^= ((q & 0x80) != 0 ? 0x09 : 0x00);
+
+        sbox[p] = q ^ rotl8(q, 1) ^ rotl8(q, 2) ^ rotl8(q, 3) ^ rotl8(q, 4) ^ 0x63;
+    } while (p != 1);
+
+    sbox[0] = 0x63;
+    return sbox;
+});
+
+void expandKey(std::span<std::uint8_t const, 16> key, std::array<std::uint8_t, 176>& rk) noexcept {
+    std::copy(key.begin(), key.end(), rk.begin());
+    std::uint8_t rcon = 1;
+
+    for (std::size_t i = 16; i < rk.size(); i += 4) {
+        std::array<std::uint8_t, 4> t = {{rk[i - 4], rk[i - 3], rk[i - 2], rk[i - 1]}};
+
+        if (i % 16 == 0) {
+            t = {{static_cast<std::uint8_t>(kSBox[t[1]] ^ rcon), kSBox[t[2]], kSBox[t[3]], kSBox[t[0]]}};
+            rcon = xtime(rcon);
+        }
+
+        for (std::size_t j = 0; j < 4; ++j) {
+            rk[i + j] = rk[i + j - 16] ^ t[j];
+        }
+    }
+}
+
+void encryptSoftware(std::array<std::uint8_t, 176> const& rk, std::uint8_t* block) noexcept {
+    std::array<std::uint8_t, 16> s;
+
+    for (std::size_t i = 0; i < 16; ++i) {
+        s[i] = block[i] ^ rk[i];
+    }
+
+    for (std::size_t round = 1; round <= 10; ++round) {
+        // SubBytes and ShiftRows
+        std::array<std::uint8_t, 16> t;
+        for (std::size_t c = 0; c < 4; ++c) {
+            for (std::size_t r = 0; r < 4; ++r) {
+                t[r + 4 * c] = kSBox[s[r + 4 * ((c + r) % 4)]];
+            }
+        }
+
+        // MixColumns
+        if (round != 10) {
+            for (std::size_t c = 0; c < 4; ++c) {
+                auto* col = t.data() + 4 * c;
+                auto const all = static_cast<std::uint8_t>(col[0] ^ col[1] ^ col[2] ^ col[3]);
+                auto const first = col[0];
+
+                col[0] ^= all ^ xtime(col[0] ^ col[1]);
+                col[1] ^= all ^ xtime(col[1] ^ col[2]);
+                col[2] ^= all ^ xtime(col[2] ^ col[3]);
+                col[3] ^= all ^ xtime(col[3] ^ first);
+            }
+        }
+
+        for (std::size_t i = 0; i < 16; ++i) {
+            s[i] = t[i] ^ rk[16 * round + i];
+        }
+    }
+
+    std::memcpy(block, s.data(), s.size());
+}
+
+#if CXXNETADDR_HAS_AESNI
+// Eight independent blocks are kept in flight to hide the latency of aesenc
+__attribute__((target("aes,sse2")))
+void encryptAESNI(std::array<std::uint8_t, 176> const& rk, std::uint8_t* blocks, std::size_t n) noexcept {
+    static constexpr std::size_t kLanes = 8;
+    __m128i k[11];
+
+    for (std::size_t r = 0; r < 11; ++r) {
+        k[r] = _mm_loadu_si128(reinterpret_cast<__m128i const*>(rk.data() + 16 * r));
+    }
+
+    std::size_t i = 0;
+    for (; i + kLanes <= n; i += kLanes) {
+        __m128i b[kLanes];
+
+        for (std::size_t l = 0; l < kLanes; ++l) {
+            b[l] = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<__m128i const*>(blocks + 16 * (i + l))), k[0]);
+        }
+
+        for (std::size_t r = 1; r < 10; ++r) {
+            for (std::size_t l = 0; l < kLanes; ++l) {
+                b[l] = _mm_aesenc_si128(b[l], k[r]);
+            }
+        }
+
+        for (std::size_t l = 0; l < kLanes; ++l) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(blocks + 16 * (i + l)), _mm_aesenclast_si128(b[l], k[10]));
+        }
+    }
+
+    for (; i < n; ++i) {
+        auto b = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<__m128i const*>(blocks + 16 * i)), k[0]);
+
+        for (std::size_t r = 1; r < 10; ++r) {
+            b = _mm_aesenc_si128(b, k[r]);
+        }
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(blocks + 16 * i), _mm_aesenclast_si128(b, k[10]));
+    }
+}
+#endif
+
+//===============================================================
+std::uint32_t load32(std::uint8_t const* p) noexcept {
+    return (std::uint32_t(p[0]) << 24) | (std::uint32_t(p[1]) << 16) | (std::uint32_t(p[2]) << 8) | std::uint32_t(p[3]);
+}
+
+void store32(std::uint8_t* p, std::uint32_t v) noexcept {
+    for (int i = 3; i >= 0; --i, v >>= 8) {
+        p[i] = static_cast<std::uint8_t>(v);
+    }
+}
+
+uint128 load128(std::uint8_t const* p) noexcept {
+    uint128 v = 0;
+    for (int i = 0; i < 16; ++i) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+void store128(std::uint8_t* p, uint128 v) noexcept {
+    for (int i = 15; i >= 0; --i, v >>= 8) {
+        p[i] = static_cast<std::uint8_t>(v);
+    }
+}
+
+// The cached anonymization of the 16 most significant bits of an IPv4
+// address is stored in the lower 16 bits of the entry
+constexpr std::uint32_t kIPv4CacheValid = 1u << 16;
+constexpr std::size_t kIPv4CachedBits = 16;
+constexpr std::size_t kIPv6CachedBits = 64;
+constexpr std::size_t kIPv6CacheSize = 4096;
+constexpr std::size_t kIPv4BatchSize = 8;
+}
+
+//===============================================================
+void cxxnetaddr::detail::aes128EncryptPortable(std::span<std::uint8_t const, 16> key, std::span<std::uint8_t, 16> block) noexcept {
+    std::array<std::uint8_t, 176> rk;
+    expandKey(key, rk);
+    encryptSoftware(rk, block.data());
+}
+
+//===============================================================
+Anonymizer::Anonymizer(std::span<std::uint8_t const, 32> key)
+    : ipv4Cache(std::size_t(1) << kIPv4CachedBits, 0),
+      ipv6Cache(kIPv6CacheSize, IPv6CacheEntry {0, 0, false}),
+      scratch(std::max(kIPv4BatchSize * 32, std::size_t(128))) {
+   #if CXXNETADDR_HAS_AESNI
+    hasAESNI = __builtin_cpu_supports("aes");
+   #else
+    hasAESNI = false;
+   #endif
+
+    expandKey(key.first<16>(), roundKeys);
+    std::copy(key.begin() + 16, key.end(), pad.begin());
+    encrypt(&pad, 1);
+}
+
+void Anonymizer::encrypt(Block* blocks, std::size_t n) const {
+   #if CXXNETADDR_HAS_AESNI
+    if (hasAESNI) {
+        encryptAESNI(roundKeys, blocks->data(), n);
+        return;
+    }
+   #endif
+
+    for (std::size_t i = 0; i < n; ++i) {
+        encryptSoftware(roundKeys, blocks[i].data());
+    }
+}
+
+//===============================================================
+std::uint32_t Anonymizer::anonymizeIPv4(std::uint32_t saddr) {
+    std::uint32_t result;
+    anonymizeIPv4(std::span<std::uint32_t const>(&saddr, 1), std::span<std::uint32_t>(&result, 1));
+    return result;
+}
+
+void Anonymizer::anonymizeIPv4(std::span<std::uint32_t const> in, std::span<std::uint32_t> out) {
+    assert(in.size() == out.size());
+    auto const padHi = load32(pad.data());
+
+    for (std::size_t base = 0; base < in.size(); base += kIPv4BatchSize) {
+        auto const n = std::min(kIPv4BatchSize, in.size() - base);
+        std::array<std::uint32_t, kIPv4BatchSize> flips = {};
+        std::array<std::size_t, kIPv4BatchSize> firstBit = {};
+        std::size_t numBlocks = 0;
+
+        // Bit i of the result is flipped by the MSB of AES(i most significant bits
+        // of the address followed by the padding). All blocks of the batch are
+        // independent, so they are encrypted together.
+        for (std::size_t i = 0; i < n; ++i) {
+            auto const addr = in[base + i];
+
+            if (auto const entry = ipv4Cache[addr >> kIPv4CachedBits]; (entry & kIPv4CacheValid) != 0) {
+                flips[i] = (entry & 0xffffu) << kIPv4CachedBits;
+                firstBit[i] = kIPv4CachedBits;
+            }
+
+            for (auto pos = firstBit[i]; pos < 32; ++pos) {
+                auto& block = scratch[numBlocks++];
+                block = pad;
+
+                if (pos != 0) {
+                    store32(block.data(), ((addr >> (32 - pos)) << (32 - pos)) | (padHi & (0xffffffffu >> pos)));
+                }
+            }
+        }
+
+        encrypt(scratch.data(), numBlocks);
+
+        for (std::size_t i = 0, block = 0; i < n; ++i) {
+            auto const addr = in[base + i];
+
+            for (auto pos = firstBit[i]; pos < 32; ++pos) {
+                flips[i] |= std::uint32_t(scratch[block++][0] >> 7) << (31 - pos);
+            }
+
+            if (firstBit[i] == 0) {
+                ipv4Cache[addr >> kIPv4CachedBits] = kIPv4CacheValid | (flips[i] >> kIPv4CachedBits);
+            }
+
+            out[base + i] = addr ^ flips[i];
+        }
+    }
+}
+
+::in6_addr Anonymizer::anonymizeIPv6(::in6_addr const& in6) {
+    auto const addr = load128(in6.s6_addr);
+    auto const p = load128(pad.data());
+    auto const top = static_cast<std::uint64_t>(addr >> kIPv6CachedBits);
+    auto& entry = ipv6Cache[(top * 0x9e3779b97f4a7c15ull) >> (64 - 12)];
+    static_assert(kIPv6CacheSize == 1u << 12);
+
+    uint128 flips = 0;
+    std::size_t firstBit = 0;
+
+    if (entry.valid && entry.prefix == top) {
+        flips = uint128(entry.flips) << kIPv6CachedBits;
+        firstBit = kIPv6CachedBits;
+    }
+
+    std::size_t numBlocks = 0;
+    for (auto pos = firstBit; pos < 128; ++pos) {
+        auto const input = (pos == 0 ? p : ((addr >> (128 - pos)) << (128 - pos)) | (p & (~uint128(0) >> pos)));
+        store128(scratch[numBlocks++].data(), input);
+    }
+
+    encrypt(scratch.data(), numBlocks);
+
+    for (auto pos = firstBit, block = std::size_t(0); pos < 128; ++pos) {
+        flips |= uint128(scratch[block++][0] >> 7) << (127 - pos);
+    }
+
+    if (firstBit == 0) {
+        entry = IPv6CacheEntry {top, static_cast<std::uint64_t>(flips >> kIPv6CachedBits), true};
+    }
+
+    ::in6_addr result;
+    store128(result.s6_addr, addr ^ flips);
+    return result;
+}
+
+//===============================================================
+NetworkAddress Anonymizer::anonymize(NetworkAddress const& addr) {
+    switch (addr.family()) {
+    case NetworkAddress::Family::ipv4:
+        return NetworkAddress(anonymizeIPv4(cxxutils::byteswap(addr.get_sin_addr().s_addr)), addr.port());
+    case NetworkAddress::Family::ipv6: {
+        ::sockaddr_in6 sin6;
+        std::memcpy(&sin6, &addr.socket(), sizeof(sin6));
+        sin6.sin6_addr = anonymizeIPv6(sin6.sin6_addr);
+        return NetworkAddress::fromPOSIXSocketAddress(*reinterpret_cast<::sockaddr const*>(&sin6), sizeof(sin6));
+    }
+    default:
+        break;
+    }
+
+    return addr;
+}
+
+void Anonymizer::anonymize(std::span<NetworkAddress const> in, std::span<NetworkAddress> out) {
+    assert(in.size() == out.size());
+
+    // runs of IPv4 addresses are anonymized with the batch kernel
+    static constexpr std::size_t kRun = 64;
+    std::array<std::uint32_t, kRun> v4;
+    std::array<std::size_t, kRun> index;
+    std::size_t pending = 0;
+
+    auto const flush = [&] {
+        anonymizeIPv4(std::span<std::uint32_t const>(v4.data(), pending), std::span<std::uint32_t>(v4.data(), pending));
+
+        for (std::size_t i = 0; i < pending; ++i) {
+            out[index[i]] = NetworkAddress(v4[i], in[index[i]].port());
+        }
+
+        pending = 0;
+    };
+
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        if (in[i].family() != NetworkAddress::Family::ipv4) {
+            out[i] = anonymize(in[i]);
+            continue;
+        }
+
+        v4[pending] = cxxutils::byteswap(in[i].get_sin_addr().s_addr);
+        index[pending++] = i;
+
+        if (pending == kRun) {
+            flush();
+        }
+    }
+
+    flush();
+}
@@ -0,0 +1,121 @@
+//
+//  Anonymizer.hpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+#pragma once
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <netinet/in.h>
+
+#include "NetworkAddress.hpp"
+
+/**
+ * @class Anonymizer
+ * @brief Prefix-preserving address anonymization (Crypto-PAn).
+ *
+ * Two addresses sharing a k-bit prefix are mapped to two anonymized
+ * addresses which also share a k-bit prefix. The mapping is a bijection
+ * determined by a 32 byte key and is compatible with the reference
+ * Crypto-PAn implementation for IPv4 addresses. IPv6 addresses are
+ * anonymized with the same construction over all 128 bits.
+ *
+ * AES is computed with AES-NI if the CPU supports it and the
+ * anonymization of the high-order 16 (IPv4) or 64 (IPv6) bits is cached
+ * per prefix. An Anonymizer is not thread-safe: use one per thread.
+ */
+class Anonymizer
+{
+public:
+    /**
+     * @brief Creates an anonymizer.
+     *
+     * @param key The first 16 bytes are the AES key, the last 16 bytes
+     *            are used to derive the padding.
+     */
+    explicit Anonymizer(std::span<std::uint8_t const, 32> key);
+
+    //===============================================================
+    /**
+     * @brief Anonymizes an IP address.
+     *
+     * The port and the scope of the address are preserved. Addresses which
+     * are neither IPv4 nor IPv6 are returned unchanged.
+     *
+     * @param addr The address to anonymize.
+     * @return The anonymized address.
+     */
+    NetworkAddress anonymize(NetworkAddress const& addr);
+
+    /**
+     * @brief Anonymizes a batch of addresses.
+     *
+     * @param in The addresses to anonymize.
+     * @param out The anonymized addresses. Must be the same size as in.
+     */
+    void anonymize(std::span<NetworkAddress const> in, std::span<NetworkAddress> out);
+
+    //===============================================================
+    /**
+     * @brief Anonymizes an IPv4 address.
+     *
+     * @param saddr The IPv4 address in host byte order.
+     * @return The anonymized address in host byte order.
+     */
+    std::uint32_t anonymizeIPv4(std::uint32_t saddr);
+
+    /**
+     * @brief Anonymizes a batch of IPv4 addresses.
+     *
+     * This is the fastest way to anonymize many addresses as AES is
+     * pipelined across the addresses of the batch.
+     *
+     * @param in The IPv4 addresses in host byte order.
+     * @param out The anonymized addresses. Must be the same size as in.
+     */
+    void anonymizeIPv4(std::span<std::uint32_t const> in, std::span<std::uint32_t> out);
+
+    /**
+     * @brief Anonymizes an IPv6 address.
+     *
+     * @param addr The IPv6 address.
+     * @return The anonymized address.
+     */
+    ::in6_addr anonymizeIPv6(::in6_addr const& addr);
+
+private:
+    using Block = std::array<std::uint8_t, 16>;
+
+    struct IPv6CacheEntry
+    {
+        std::uint64_t prefix;
+        std::uint64_t flips;
+        bool valid;
+    };
+
+    void encrypt(Block* blocks, std::size_t n) const;
+
+    std::array<std::uint8_t, 176> roundKeys;
+    Block pad;
+    std::vector<std::uint32_t> ipv4Cache;
+    std::vector<IPv6CacheEntry> ipv6Cache;
+    std::vector<Block> scratch;
+    bool hasAESNI;
+};
+
+namespace cxxnetaddr::detail
+{
+/**
+ * Encrypts a block with the portable AES-128 which Anonymizer uses if the
+ * CPU does not support AES-NI, so that it can be tested on any CPU.
+ */
+void aes128EncryptPortable(std::span<std::uint8_t const, 16> key, std::span<std::uint8_t, 16> block) noexcept;
+}
@@ -0,0 +1,122 @@
+//
+//  Anonymizer_test.cpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+#include <gtest/gtest.h>
+#include <bit>
+#include <cstring>
+#include <random>
+
+#include "Anonymizer.hpp"
+
+namespace
+{
+// key and sample addresses of the Crypto-PAn reference implementation
+constexpr std::array<std::uint8_t, 32> kKey = {{21, 34, 23, 141, 51, 164, 207, 128, 19, 10, 91, 22, 73, 144, 125, 16,
+                                                216, 152, 143, 131, 121, 121, 101, 39, 98, 87, 76, 45, 42, 132, 34, 2}};
+
+std::uint32_t ipv4(std::uint8_t o1, std::uint8_t o2, std::uint8_t o3, std::uint8_t o4) {
+    return (std::uint32_t(o1) << 24) | (std::uint32_t(o2) << 16) | (std::uint32_t(o3) << 8) | o4;
+}
+
+int commonPrefix(std::uint32_t a, std::uint32_t b) { return std::countl_zero(a ^ b); }
+}
+
+// Test the portable AES, which CPUs with AES-NI never use, against the FIPS-197 examples
+TEST(AnonymizerTest, PortableAESMatchesFIPS197) {
+    struct Vector { std::array<std::uint8_t, 16> key, plaintext, ciphertext; };
+    constexpr Vector kVectors[] = {
+        // appendix B
+        {{0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c},
+         {0x32, 0x43, 0xf6, 0xa8, 0x88, 0x5a, 0x30, 0x8d, 0x31, 0x31, 0x98, 0xa2, 0xe0, 0x37, 0x07, 0x34},
+         {0x39, 0x25, 0x84, 0x1d, 0x02, 0xdc, 0x09, 0xfb, 0xdc, 0x11, 0x85, 0x97, 0x19, 0x6a, 0x0b, 0x32}},
+        // appendix C.1
+        {{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f},
+         {0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff},
+         {0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30, 0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a}},
+    };
+
+    for (auto const& v : kVectors) {
+        auto block = v.plaintext;
+        cxxnetaddr::detail::aes128EncryptPortable(v.key, block);
+        EXPECT_EQ(block, v.ciphertext);
+    }
+}
+
+// Test against the sample trace of the Crypto-PAn reference implementation
+TEST(AnonymizerTest, MatchesReferenceImplementation) {
+    Anonymizer anon(kKey);
+
+    EXPECT_EQ(anon.anonymizeIPv4(ipv4(128, 11, 68, 132)),  ipv4(135, 242, 180, 132));
+    EXPECT_EQ(anon.anonymizeIPv4(ipv4(129, 118, 74, 4)),   ipv4(134, 136, 186, 123));
+    EXPECT_EQ(anon.anonymizeIPv4(ipv4(130, 132, 252, 244)), ipv4(133, 68, 164, 234));
+    EXPECT_EQ(anon.anonymizeIPv4(ipv4(141, 223, 7, 43)),   ipv4(141, 167, 8, 160));
+    EXPECT_EQ(anon.anonymizeIPv4(ipv4(141, 233, 145, 108)), ipv4(141, 129, 237, 235));
+}
+
+// Test that the prefix cache and the batch API do not change the result
+TEST(AnonymizerTest, BatchMatchesSingleAddress) {
+    Anonymizer batched(kKey);
+    std::mt19937 rng(42);
+    std::vector<std::uint32_t> in(1000), out(in.size());
+
+    // plenty of shared /16 prefixes to exercise the cache
+    for (auto& a : in) {
+        a = (rng() % 4 == 0 ? rng() : (ipv4(10, 20, 0, 0) | (rng() & 0xffff)));
+    }
+
+    batched.anonymizeIPv4(in, out);
+
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        Anonymizer single(kKey);
+        ASSERT_EQ(out[i], single.anonymizeIPv4(in[i]));
+    }
+}
+
+// Test that shared prefixes are preserved
+TEST(AnonymizerTest, PreservesPrefixes) {
+    Anonymizer anon(kKey);
+    std::mt19937 rng(7);
+
+    for (int i = 0; i < 200; ++i) {
+        auto const a = static_cast<std::uint32_t>(rng());
+        auto const b = a ^ (static_cast<std::uint32_t>(rng()) >> (rng() % 32));
+        EXPECT_EQ(commonPrefix(anon.anonymizeIPv4(a), anon.anonymizeIPv4(b)), commonPrefix(a, b));
+    }
+}
+
+// Test anonymization of NetworkAddress objects
+TEST(AnonymizerTest, AnonymizesNetworkAddresses) {
+    Anonymizer anon(kKey);
+
+    auto const v4 = anon.anonymize(NetworkAddress(128, 11, 68, 132, 8080));
+    EXPECT_EQ(v4, NetworkAddress(135, 242, 180, 132, 8080));
+
+    NetworkAddress const a(0x2001, 0x0db8, 0, 0, 0, 0, 0, 1, 443);
+    NetworkAddress const b(0x2001, 0x0db8, 0, 0, 0, 0, 0, 2, 443);
+    auto const aa = anon.anonymize(a);
+    auto const ab = anon.anonymize(b);
+
+    EXPECT_EQ(aa.family(), NetworkAddress::Family::ipv6);
+    EXPECT_EQ(aa.port(), 443);
+    EXPECT_NE(aa, a);
+    EXPECT_EQ(std::memcmp(aa.get_sin6_addr().s6_addr, ab.get_sin6_addr().s6_addr, 15), 0);
+    EXPECT_NE(aa, ab);
+    EXPECT_EQ(anon.anonymize(a), aa);
+
+    auto const mac = NetworkAddress(0x00, 0x1A, 0x2B, 0x3C, 0x4D, 0x5E);
+    EXPECT_EQ(anon.anonymize(mac), mac);
+
+    std::vector<NetworkAddress> const in = {v4, a, mac, NetworkAddress(128, 11, 68, 132, 8080)};
+    std::vector<NetworkAddress> out(in.size());
+    anon.anonymize(in, out);
+    EXPECT_EQ(out[1], aa);
+    EXPECT_EQ(out[2], mac);
+    EXPECT_EQ(out[3], v4);
+}
@@ -10,15 +10,24 @@
 //  14467 Potsdam, Germany
 //
 #pragma once
+#include <algorithm>
+#include <array>
 #include <optional>
 #include <utility>
+#include <atomic>
 #include <iostream>
 #include <cmath>
 #include <memory>
 #include <functional>
 #include <mutex>
+#include <span>
+#include <thread>
 #include <type_traits>
 
+#if defined(__x86_64__) || defined(__i386__)
+ #include <immintrin.h>
+#endif
+
 // see https://gcc.gnu.org/onlinedocs/cpp/_005f_005fhas_005finclude.html
 #if defined __has_include
 #  if __has_include (<bit>)
@@ -121,24 +130,84 @@ template <typename... Args> auto range(Args... args) noexcept { return Range<dec
 template <typename T> T dround(T const x, T const dir) noexcept { return dir >= static_cast<T>(0) ? std::ceil(x) : std::floor(x); }
 
 //====================================================================
-/** Create a reference counted singleton object */
+namespace detail {
+template <typename T>
+struct SharedSingleton {
+    // a generation never changes after it was published, so readers only
+    // need to find it via the atomic pointer
+    struct Generation { std::weak_ptr<T> weak; };
+
+    ~SharedSingleton() { delete current.load(std::memory_order_relaxed); }
+
+    // Finds the object without taking a lock. The reader count of the
+    // epoch keeps the generation alive while its weak pointer is locked.
+    std::shared_ptr<T> find() noexcept {
+        auto& readers = readerCounts[epoch.load(std::memory_order_relaxed)].count;
+        readers.fetch_add(1);
+
+        auto const* generation = current.load();
+        auto result = generation != nullptr ? generation->weak.lock() : std::shared_ptr<T>();
+
+        readers.fetch_sub(1, std::memory_order_release);
+        return result;
+    }
+
+    // Replaces the generation; only called while holding the creation lock.
+    // The previous generation is freed once the readers of both epochs,
+    // which may still be looking at it, are done: new readers count in
+    // the other epoch, so this does not wait for them.
+    void publish(std::shared_ptr<T> const& object) {
+        auto const* previous = current.exchange(new Generation { object });
+
+        for (int i = 0; i < 2; ++i) {
+            auto const old = epoch.load(std::memory_order_relaxed);
+            epoch.store(old ^ 1u, std::memory_order_relaxed);
+
+            while (readerCounts[old].count.load() != 0) {
+                std::this_thread::yield();
+            }
+        }
+
+        delete previous;
+    }
+
+    std::atomic<Generation const*> current = nullptr;
+    std::atomic<unsigned> epoch = 0;
+    struct alignas(64) Readers { std::atomic<std::size_t> count = 0; } readerCounts[2];
+
+    // serializes the creation of new objects
+    std::mutex lock;
+};
+}
+
+/**
+ * Create a reference counted singleton object
+ *
+ * The object lives as long as any of the returned pointers; the next call
+ * after that creates a new one. This is thread-safe and finding an
+ * existing object takes no lock. The factory is called at most once per
+ * object while holding a lock, so it must not call getOrCreate for the
+ * same singleton.
+ */
 template <typename Fn, typename... Args>
 auto getOrCreate(Fn && factory, Args&&... args) {
     // here we use CTAD to help us deduce the pointer's type
     using PointerType = std::remove_reference_t<std::remove_cv_t<std::invoke_result_t<Fn, Args...>>>;
     using Type = std::pointer_traits<PointerType>::element_type;
-    std::shared_ptr<Type> _shared;
-    static std::weak_ptr<Type> _weak = std::invoke([&_shared, factory] (Args&&... _args) {
-        _shared = std::shared_ptr<Type>(factory(std::forward<Args>(_args)...));
-        return _shared;
-    }, std::forward<Args>(args)...);
+    static detail::SharedSingleton<Type> singleton;
+
+    if (auto ptr = singleton.find())
+        return ptr;
 
-    if (auto ptr = _weak.lock())
+    std::lock_guard<std::mutex> guard(singleton.lock);
+
+    // another thread may have created the object in the meantime
+    if (auto ptr = singleton.find())
         return ptr;
 
-    _shared = std::shared_ptr<Type>(factory(std::forward<Args>(args)...));
-    _weak = _shared;
-    return _shared;
+    auto shared = std::shared_ptr<Type>(std::invoke(factory, std::forward<Args>(args)...));
+    singleton.publish(shared);
+    return shared;
 }
 
 //====================================================================
@@ -217,4 +286,96 @@ constexpr std::enable_if_t<std::is_integral_v<T>, T> byteswap(T value) noexcept
     return std::bit_cast<T>(reverse_byte_representation);
    #endif
 }
+
+//====================================================================
+namespace detail {
+template <typename T>
+void byteswapScalar(T const* src, T* dst, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; ++i) {
+        dst[i] = byteswap(src[i]);
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+// pshufb control reversing the bytes of every T in a 32 byte vector
+template <typename T>
+inline constexpr auto kByteswapShuffle = [] {
+    std::array<char, 32> mask = {};
+    for (std::size_t i = 0; i < mask.size(); ++i) {
+        mask[i] = static_cast<char>((i / sizeof(T)) * sizeof(T) + sizeof(T) - 1 - i % sizeof(T));
+    }
+    return mask;
+}();
+
+template <typename T>
+__attribute__((target("ssse3")))
+void byteswapSSSE3(T const* src, T* dst, std::size_t n) noexcept {
+    static constexpr auto kPerVector = 16 / sizeof(T);
+    auto const shuffle = _mm_loadu_si128(reinterpret_cast<__m128i const*>(kByteswapShuffle<T>.data()));
+    std::size_t i = 0;
+
+    for (; i + kPerVector <= n; i += kPerVector) {
+        auto const v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_shuffle_epi8(v, shuffle));
+    }
+
+    byteswapScalar(src + i, dst + i, n - i);
+}
+
+template <typename T>
+__attribute__((target("avx2")))
+void byteswapAVX2(T const* src, T* dst, std::size_t n) noexcept {
+    static constexpr auto kPerVector = 32 / sizeof(T);
+    auto const shuffle = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(kByteswapShuffle<T>.data()));
+    std::size_t i = 0;
+
+    for (; i + kPerVector <= n; i += kPerVector) {
+        auto const v = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_shuffle_epi8(v, shuffle));
+    }
+
+    byteswapScalar(src + i, dst + i, n - i);
+}
+#endif
+}
+
+/**
+ * Byte swaps an array of integers, e.g. to convert addresses or ports
+ * between network and host byte order in bulk.
+ *
+ * Uses AVX2 or SSSE3 shuffles where the CPU supports them. src and dst
+ * may be the same array but must not otherwise overlap; dst must be at
+ * least as large as src.
+ */
+template <typename T>
+std::enable_if_t<std::is_integral_v<T>> byteswapArray(std::span<T const> src, std::span<T> dst) noexcept {
+    auto const n = std::min(src.size(), dst.size());
+
+    if constexpr (sizeof(T) == 1) {
+        if (src.data() != dst.data()) {
+            std::copy_n(src.data(), n, dst.data());
+        }
+    } else {
+       #if defined(__x86_64__) || defined(__i386__)
+        static auto const hasAVX2 = __builtin_cpu_supports("avx2");
+        static auto const hasSSSE3 = __builtin_cpu_supports("ssse3");
+
+        if (hasAVX2) {
+            detail::byteswapAVX2(src.data(), dst.data(), n);
+        } else if (hasSSSE3) {
+            detail::byteswapSSSE3(src.data(), dst.data(), n);
+        } else {
+            detail::byteswapScalar(src.data(), dst.data(), n);
+        }
+       #else
+        detail::byteswapScalar(src.data(), dst.data(), n);
+       #endif
+    }
+}
+
+/** Byte swaps an array of integers in place */
+template <typename T>
+std::enable_if_t<std::is_integral_v<T>> byteswapArray(std::span<T> values) noexcept {
+    byteswapArray(std::span<T const>(values), values);
+}
 }
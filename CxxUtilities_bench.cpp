@@ -0,0 +1,95 @@
+//
+//  CxxUtilities_bench.cpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <vector>
+#include <thread>
+
+#include "CxxUtilities.hpp"
+
+namespace
+{
+int const kMaxThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+std::shared_ptr<int> sharedValue() {
+    return cxxutils::getOrCreate([] { return std::make_unique<int>(42); });
+}
+}
+
+//===============================================================
+// Every thread looks up the singleton while it is alive, i.e. the lock-free path
+static void BM_GetOrCreate(benchmark::State& state) {
+    static std::shared_ptr<int> keepAlive;
+
+    if (state.thread_index() == 0) {
+        keepAlive = sharedValue();
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sharedValue());
+    }
+
+    if (state.thread_index() == 0) {
+        keepAlive.reset();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GetOrCreate)->ThreadRange(1, kMaxThreads)->UseRealTime();
+
+// Baseline: copying a shared_ptr, which has the same reference count contention
+static void BM_Baseline_SharedPtrCopy(benchmark::State& state) {
+    static auto const value = std::make_shared<int>(42);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::shared_ptr<int>(value));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Baseline_SharedPtrCopy)->ThreadRange(1, kMaxThreads)->UseRealTime();
+
+//===============================================================
+template <typename T>
+static void BM_ByteswapArray(benchmark::State& state) {
+    std::vector<T> values(static_cast<std::size_t>(state.range(0)));
+    std::iota(values.begin(), values.end(), T(1));
+
+    for (auto _ : state) {
+        cxxutils::byteswapArray(std::span<T>(values));
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<std::int64_t>(sizeof(T)));
+}
+BENCHMARK(BM_ByteswapArray<std::uint16_t>)->Arg(4096);
+BENCHMARK(BM_ByteswapArray<std::uint32_t>)->Arg(7)->Arg(4096);
+BENCHMARK(BM_ByteswapArray<std::uint64_t>)->Arg(4096);
+
+template <typename T>
+static void BM_Baseline_ByteswapLoop(benchmark::State& state) {
+    std::vector<T> values(static_cast<std::size_t>(state.range(0)));
+    std::iota(values.begin(), values.end(), T(1));
+
+    for (auto _ : state) {
+        for (auto& value : values) {
+            value = cxxutils::byteswap(value);
+        }
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<std::int64_t>(sizeof(T)));
+}
+BENCHMARK(BM_Baseline_ByteswapLoop<std::uint32_t>)->Arg(4096);
@@ -0,0 +1,134 @@
+//
+//  CxxUtilities_test.cpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "CxxUtilities.hpp"
+
+namespace
+{
+struct Counted {
+    static inline std::atomic<int> alive = 0;
+    Counted()  { ++alive; }
+    ~Counted() { --alive; }
+};
+
+// the live allocations of CountingAllocator, i.e. the control blocks of allocate_shared
+std::atomic<int> liveAllocations = 0;
+
+template <typename T>
+struct CountingAllocator {
+    using value_type = T;
+
+    CountingAllocator() = default;
+    template <typename U> CountingAllocator(CountingAllocator<U> const&) noexcept {}
+
+    T* allocate(std::size_t n) { ++liveAllocations; return std::allocator<T>().allocate(n); }
+    void deallocate(T* p, std::size_t n) noexcept { --liveAllocations; std::allocator<T>().deallocate(p, n); }
+
+    template <typename U> bool operator==(CountingAllocator<U> const&) const noexcept { return true; }
+};
+}
+
+// Test that the object is shared and recreated once it died
+TEST(CxxUtilitiesTest, GetOrCreateSharesObject) {
+    int calls = 0;
+    auto get = [&calls] { return cxxutils::getOrCreate([&calls] { ++calls; return new int(calls); }); };
+
+    auto first = get();
+    auto second = get();
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(calls, 1);
+
+    first.reset();
+    second.reset();
+
+    auto third = get();
+    EXPECT_EQ(*third, 2);
+    EXPECT_EQ(calls, 2);
+}
+
+// Test that racing threads call the factory at most once per generation and
+// that the memory of dead generations is released
+TEST(CxxUtilitiesTest, GetOrCreateIsThreadSafe) {
+    static constexpr int kThreads = 8;
+    static constexpr int kGenerations = 200;
+
+    std::atomic<int> calls = 0;
+    auto get = [&calls] {
+        return cxxutils::getOrCreate([&calls] { ++calls; return std::allocate_shared<Counted>(CountingAllocator<Counted>()); });
+    };
+
+    for (int generation = 0; generation < kGenerations; ++generation) {
+        std::atomic<int> ready = 0;
+        std::vector<std::shared_ptr<Counted>> results(kThreads);
+        std::vector<std::thread> threads;
+
+        for (int i = 0; i < kThreads; ++i) {
+            threads.emplace_back([&, i] {
+                ++ready;
+                while (ready.load() < kThreads) { std::this_thread::yield(); }
+                results[static_cast<std::size_t>(i)] = get();
+            });
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        // every thread got the same object, all created in this generation
+        for (auto const& result : results) {
+            EXPECT_EQ(result, results.front());
+        }
+
+        EXPECT_EQ(calls.load(), generation + 1);
+        EXPECT_EQ(Counted::alive.load(), 1);
+        EXPECT_EQ(liveAllocations.load(), 1);
+    }
+
+    EXPECT_EQ(Counted::alive.load(), 0);
+    EXPECT_LE(liveAllocations.load(), 1);
+}
+
+// Test the vectorized byte swaps against the scalar ones, including the tails
+template <typename T>
+void checkByteswapArray() {
+    std::vector<T> values(100);
+
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<T>(0x0102030405060708ull * (i + 1));
+    }
+
+    for (std::size_t n = 0; n <= values.size(); ++n) {
+        std::vector<T> swapped(n);
+        cxxutils::byteswapArray(std::span<T const>(values.data(), n), std::span<T>(swapped));
+
+        for (std::size_t i = 0; i < n; ++i) {
+            ASSERT_EQ(swapped[i], cxxutils::byteswap(values[i])) << n << ", " << i;
+        }
+
+        cxxutils::byteswapArray(std::span<T>(swapped));
+        ASSERT_TRUE(std::equal(swapped.begin(), swapped.end(), values.begin())) << n;
+    }
+}
+
+TEST(CxxUtilitiesTest, ByteswapArray) {
+    checkByteswapArray<std::uint8_t>();
+    checkByteswapArray<std::uint16_t>();
+    checkByteswapArray<std::uint32_t>();
+    checkByteswapArray<std::uint64_t>();
+    checkByteswapArray<std::int32_t>();
+}
@@ -0,0 +1,486 @@
+//
+//  ExpiringAddressMap.hpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "AddressLog.hpp"
+#include "NetworkAddress.hpp"
+
+/**
+ * @class ExpiringAddressMap
+ * @brief A map from addresses to values which expire after a time to live.
+ *
+ * Entries live in slabs of nodes which are never moved or freed, so the
+ * memory is bounded by the maximum size given on construction and pointers
+ * to values stay valid until their entry is removed. A hash table with open
+ * addressing finds the node of an address, and a hierarchical timing wheel
+ * of four levels with 256 slots each orders the nodes by expiry: inserting,
+ * refreshing, erasing and expiring an entry are all O(1).
+ *
+ * Time is measured in ticks of the caller's choosing (e.g. milliseconds of
+ * a steady clock) and only moves forward with advance(). Keys are the
+ * fields of a CompactAddress, so UNIX socket addresses are not supported.
+ *
+ * The map is not thread-safe.
+ *
+ * @tparam V The type of the values; must be default constructible and movable.
+ */
+template <typename V>
+class ExpiringAddressMap
+{
+public:
+    using Ticks = std::uint64_t;
+
+    /** The maximum time to live; longer ones are clamped. */
+    static constexpr Ticks kMaxTTL = Ticks(255) << 24;
+
+    /** An expired entry, as passed to the callback of advance(). */
+    struct Expired
+    {
+        CompactAddress address;
+        V value;
+        Ticks expiry;
+    };
+
+    //===============================================================
+    /**
+     * @brief Creates an empty map.
+     *
+     * @param maxEntries The maximum number of entries (less than 2^32 - 1).
+     * @param now The current time.
+     */
+    explicit ExpiringAddressMap(std::size_t maxEntries, Ticks now = 0)
+        : capacity(std::max(std::size_t(1), maxEntries)),
+          table(std::bit_ceil(capacity + capacity / 3 + 1), Slot { kNone, 0 }),
+          current(now) {
+        assert(capacity < kNone);
+        std::fill(&wheel[0][0], &wheel[0][0] + kLevels * kSlots, kNone);
+    }
+
+    /** The number of entries. */
+    std::size_t size() const noexcept { return count; }
+
+    /** The maximum number of entries. */
+    std::size_t maxSize() const noexcept { return capacity; }
+
+    /** The current time, i.e. the time last passed to advance(). */
+    Ticks now() const noexcept { return current; }
+
+    //===============================================================
+    /**
+     * @brief Inserts or replaces the value of an address.
+     *
+     * @param addr The address.
+     * @param value The value.
+     * @param ttl The number of ticks after now() when the entry expires (at least one).
+     * @return The value in the map, or nullptr if the map is full or the
+     *         address is not supported.
+     */
+    V* insert(NetworkAddress const& addr, V value, Ticks ttl) {
+        auto const key = makeKey(addr);
+
+        if (! key) {
+            return nullptr;
+        }
+
+        auto const hash = hashKey(*key);
+        auto pos = findSlot(*key, hash);
+
+        if (table[pos].node == kNone) {
+            if (count == capacity) {
+                return nullptr;
+            }
+
+            table[pos] = Slot { allocateNode(), static_cast<std::uint32_t>(hash >> 32) };
+            ++count;
+            nodeAt(table[pos].node).key = *key;
+        } else {
+            unlinkTimer(table[pos].node);
+        }
+
+        auto& n = nodeAt(table[pos].node);
+        n.value = std::move(value);
+        n.expiry = current + std::clamp(ttl, Ticks(1), kMaxTTL);
+        linkTimer(table[pos].node);
+        return &n.value;
+    }
+
+    /**
+     * @brief Finds the value of an address.
+     *
+     * @return The value, or nullptr if the address is not in the map.
+     */
+    V* find(NetworkAddress const& addr) noexcept {
+        auto const index = findNode(addr);
+        return index != kNone ? &nodeAt(index).value : nullptr;
+    }
+
+    /**
+     * @brief Sets the time to live of an entry anew.
+     *
+     * @return False if the address is not in the map.
+     */
+    bool refresh(NetworkAddress const& addr, Ticks ttl) noexcept {
+        auto const index = findNode(addr);
+
+        if (index == kNone) {
+            return false;
+        }
+
+        unlinkTimer(index);
+        nodeAt(index).expiry = current + std::clamp(ttl, Ticks(1), kMaxTTL);
+        linkTimer(index);
+        return true;
+    }
+
+    /**
+     * @brief Removes an entry without calling the expiry callback.
+     *
+     * @return False if the address is not in the map.
+     */
+    bool erase(NetworkAddress const& addr) noexcept {
+        auto const key = makeKey(addr);
+
+        if (! key) {
+            return false;
+        }
+
+        auto const pos = findSlot(*key, hashKey(*key));
+
+        if (table[pos].node == kNone) {
+            return false;
+        }
+
+        auto const index = table[pos].node;
+        unlinkTimer(index);
+        eraseSlot(pos);
+        freeNode(index);
+        return true;
+    }
+
+    /**
+     * @brief Moves the time forward and removes all entries expiring until then.
+     *
+     * The expired entries are passed to the callback in batches.
+     *
+     * @param now The new time; ignored if it is before now().
+     * @param onExpired Called with a std::span<Expired> of up to kBatchSize entries.
+     * @return The number of expired entries.
+     */
+    template <typename Fn>
+    std::size_t advance(Ticks now, Fn && onExpired) {
+        std::array<Expired, kBatchSize> batch;
+        std::size_t batchSize = 0, expired = 0;
+
+        while (current < now) {
+            if (count == 0) {
+                current = now;
+                break;
+            }
+
+            current = nextEvent(now);
+
+            if ((current & kSlotMask) == 0) {
+                cascade();
+            }
+
+            auto const slot = static_cast<std::size_t>(current & kSlotMask);
+
+            for (auto index = takeSlot(0, slot); index != kNone;) {
+                auto& n = nodeAt(index);
+                auto const next = n.next;
+
+                batch[batchSize++] = Expired { toCompactAddress(n.key), std::move(n.value), n.expiry };
+                eraseSlot(findSlot(n.key, hashKey(n.key)));
+                freeNode(index);
+                ++expired;
+
+                if (batchSize == batch.size()) {
+                    onExpired(std::span<Expired>(batch.data(), batchSize));
+                    batchSize = 0;
+                }
+
+                index = next;
+            }
+        }
+
+        if (batchSize != 0) {
+            onExpired(std::span<Expired>(batch.data(), batchSize));
+        }
+
+        return expired;
+    }
+
+    /** The maximum number of entries passed to the callback of advance() at once. */
+    static constexpr std::size_t kBatchSize = 64;
+
+private:
+    static constexpr std::uint32_t kNone = UINT32_MAX;
+    static constexpr std::size_t kLevels = 4;
+    static constexpr unsigned kSlotBits = 8;
+    static constexpr std::size_t kSlots = std::size_t(1) << kSlotBits;
+    static constexpr Ticks kSlotMask = kSlots - 1;
+    static constexpr unsigned kSlabBits = 14;
+
+    //===============================================================
+    // the fields of a CompactAddress without the tag
+    struct Key
+    {
+        std::array<std::uint8_t, 16> bytes;
+        std::uint32_t scopeId;
+        std::uint16_t port;
+        std::uint8_t family;
+        std::uint8_t reserved;
+
+        bool operator==(Key const&) const = default;
+    };
+
+    static_assert(sizeof(Key) == 24 && std::has_unique_object_representations_v<Key>);
+
+    struct Node
+    {
+        Key key;
+        Ticks expiry;
+        std::uint32_t next, prev;  // the list of the wheel slot, or the free list
+        std::uint8_t level;
+        V value;
+    };
+
+    struct Slot
+    {
+        std::uint32_t node;
+        std::uint32_t hashTag;
+    };
+
+    static std::optional<Key> makeKey(NetworkAddress const& addr) noexcept {
+        auto const family = addr.family();
+
+        if (family == NetworkAddress::Family::unixSocket || family == NetworkAddress::Family::unspecified) {
+            return {};
+        }
+
+        auto const compact = CompactAddress::fromAddress(addr);
+        return Key { compact.bytes, compact.scopeId, compact.port, compact.family, 0 };
+    }
+
+    static CompactAddress toCompactAddress(Key const& key) noexcept {
+        CompactAddress result = {};
+        result.bytes = key.bytes;
+        result.scopeId = key.scopeId;
+        result.port = key.port;
+        result.family = key.family;
+        return result;
+    }
+
+    static std::uint64_t hashKey(Key const& key) noexcept {
+        std::uint64_t words[3];
+        std::memcpy(words, &key, sizeof(words));
+        auto h = words[0] * 0x9e3779b97f4a7c15ull;
+        h = (std::rotl(h, 31) ^ words[1]) * 0xff51afd7ed558ccdull;
+        h = (std::rotl(h, 31) ^ words[2]) * 0xc4ceb9fe1a85ec53ull;
+        return h ^ (h >> 29);
+    }
+
+    //===============================================================
+    // Linear probing; deletion shifts entries back instead of leaving tombstones
+    std::size_t findSlot(Key const& key, std::uint64_t hash) const noexcept {
+        auto const mask = table.size() - 1;
+        auto const tag = static_cast<std::uint32_t>(hash >> 32);
+
+        for (auto pos = static_cast<std::size_t>(hash) & mask;; pos = (pos + 1) & mask) {
+            auto const& slot = table[pos];
+
+            if (slot.node == kNone || (slot.hashTag == tag && nodeAt(slot.node).key == key)) {
+                return pos;
+            }
+        }
+    }
+
+    std::uint32_t findNode(NetworkAddress const& addr) const noexcept {
+        auto const key = makeKey(addr);
+        return key ? table[findSlot(*key, hashKey(*key))].node : kNone;
+    }
+
+    void eraseSlot(std::size_t pos) noexcept {
+        auto const mask = table.size() - 1;
+        --count;
+
+        for (auto next = (pos + 1) & mask; table[next].node != kNone; next = (next + 1) & mask) {
+            auto const home = static_cast<std::size_t>(hashKey(nodeAt(table[next].node).key)) & mask;
+
+            // move the entry into the hole unless its home lies between the hole and it
+            if (((next - home) & mask) >= ((next - pos) & mask)) {
+                table[pos] = table[next];
+                pos = next;
+            }
+        }
+
+        table[pos].node = kNone;
+    }
+
+    //===============================================================
+    Node& nodeAt(std::uint32_t index) noexcept             { return slabs[index >> kSlabBits][index & ((1u << kSlabBits) - 1)]; }
+    Node const& nodeAt(std::uint32_t index) const noexcept { return slabs[index >> kSlabBits][index & ((1u << kSlabBits) - 1)]; }
+
+    std::uint32_t allocateNode() {
+        if (freeList != kNone) {
+            auto const index = freeList;
+            freeList = nodeAt(index).next;
+            return index;
+        }
+
+        if ((allocated >> kSlabBits) == slabs.size()) {
+            slabs.push_back(std::make_unique<Node[]>(std::size_t(1) << kSlabBits));
+        }
+
+        return allocated++;
+    }
+
+    void freeNode(std::uint32_t index) noexcept {
+        nodeAt(index).value = V();
+        nodeAt(index).next = freeList;
+        freeList = index;
+    }
+
+    //===============================================================
+    // The timing wheel: a node is on the lowest level whose slot (the bits
+    // of its expiry for that level) is less than a revolution ahead of now.
+    // When the lower levels wrap around, the next slot of the level above
+    // is cascaded down.
+    static std::size_t slotOf(Ticks expiry, std::size_t level) noexcept {
+        return static_cast<std::size_t>((expiry >> (kSlotBits * level)) & kSlotMask);
+    }
+
+    void linkTimer(std::uint32_t index) noexcept {
+        auto& n = nodeAt(index);
+        std::size_t level = 0;
+
+        while (level + 1 < kLevels && ((n.expiry >> (kSlotBits * level)) - (current >> (kSlotBits * level))) >= kSlots) {
+            ++level;
+        }
+
+        auto const slot = slotOf(n.expiry, level);
+        auto& head = wheel[level][slot];
+        n.level = static_cast<std::uint8_t>(level);
+        n.prev = kNone;
+        n.next = head;
+
+        if (head != kNone) {
+            nodeAt(head).prev = index;
+        }
+
+        head = index;
+        occupied[level][slot / 64] |= std::uint64_t(1) << (slot % 64);
+    }
+
+    void unlinkTimer(std::uint32_t index) noexcept {
+        auto& n = nodeAt(index);
+        auto const slot = slotOf(n.expiry, n.level);
+
+        if (n.prev != kNone) {
+            nodeAt(n.prev).next = n.next;
+        } else {
+            wheel[n.level][slot] = n.next;
+        }
+
+        if (n.next != kNone) {
+            nodeAt(n.next).prev = n.prev;
+        }
+
+        if (wheel[n.level][slot] == kNone) {
+            occupied[n.level][slot / 64] &= ~(std::uint64_t(1) << (slot % 64));
+        }
+    }
+
+    std::uint32_t takeSlot(std::size_t level, std::size_t slot) noexcept {
+        occupied[level][slot / 64] &= ~(std::uint64_t(1) << (slot % 64));
+        return std::exchange(wheel[level][slot], kNone);
+    }
+
+    // moves the nodes of the levels' current slots down, highest level first
+    void cascade() noexcept {
+        std::size_t top = 1;
+
+        while (top + 1 < kLevels && (current & ((Ticks(1) << (kSlotBits * (top + 1))) - 1)) == 0) {
+            ++top;
+        }
+
+        for (auto level = top; level >= 1; --level) {
+            for (auto index = takeSlot(level, slotOf(current, level)); index != kNone;) {
+                auto const next = nodeAt(index).next;
+                linkTimer(index);
+                index = next;
+            }
+        }
+    }
+
+    // the next tick with expiring nodes or nodes to cascade, but at most until; the
+    // slots of a level are searched up to where the level wraps around, which is
+    // only an event if the level has nodes in the slots of the next revolution
+    Ticks nextEvent(Ticks until) const noexcept {
+        auto next = until;
+
+        for (std::size_t level = 0; level < kLevels; ++level) {
+            auto const shift = kSlotBits * level;
+            auto const base = current >> shift;
+            auto const from = static_cast<std::size_t>(base & kSlotMask) + 1;
+            auto const any = std::any_of(occupied[level].begin(), occupied[level].end(), [] (auto bits) { return bits != 0; });
+
+            if (! any) {
+                continue;
+            }
+
+            auto candidate = (base | kSlotMask) + 1;
+
+            for (auto word = from / 64; from < kSlots && word < occupied[level].size(); ++word) {
+                auto bits = occupied[level][word];
+
+                if (word == from / 64) {
+                    bits &= ~std::uint64_t(0) << (from % 64);
+                }
+
+                if (bits != 0) {
+                    candidate = (base & ~kSlotMask) + word * 64 + static_cast<std::size_t>(std::countr_zero(bits));
+                    break;
+                }
+            }
+
+            // don't overflow on the top level
+            if (candidate <= (UINT64_MAX >> shift)) {
+                next = std::min(next, candidate << shift);
+            }
+        }
+
+        return next;
+    }
+
+    //===============================================================
+    std::size_t capacity;
+    std::vector<Slot> table;
+    std::vector<std::unique_ptr<Node[]>> slabs;
+    std::uint32_t allocated = 0, freeList = kNone;
+    std::size_t count = 0;
+    Ticks current;
+    std::uint32_t wheel[kLevels][kSlots];
+    std::array<std::array<std::uint64_t, kSlots / 64>, kLevels> occupied = {};
+};
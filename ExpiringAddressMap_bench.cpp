@@ -0,0 +1,92 @@
+//
+//  ExpiringAddressMap_bench.cpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+#include <benchmark/benchmark.h>
+#include <numeric>
+#include <vector>
+
+#include "ExpiringAddressMap.hpp"
+
+namespace
+{
+// with one tick per millisecond, 1000 entries per tick are 1M expiries per second
+constexpr std::uint32_t kPerTick = 1000;
+
+using Map = ExpiringAddressMap<std::uint64_t>;
+
+// the addresses of the flows starting at a tick: consecutive IPv4 addresses
+std::vector<NetworkAddress> flowsAt(Map::Ticks tick) {
+    std::vector<std::uint32_t> saddrs(kPerTick);
+    std::iota(saddrs.begin(), saddrs.end(), static_cast<std::uint32_t>(tick * kPerTick));
+    return NetworkAddress::fromIPv4Array(std::span<std::uint32_t const>(saddrs), std::span<std::uint16_t const>());
+}
+
+// a map with the given number of live entries and kPerTick of them expiring at every tick
+Map& prefilled(std::size_t liveEntries) {
+    static std::size_t filledWith = 0;
+    static std::unique_ptr<Map> map;
+
+    if (filledWith != liveEntries) {
+        map.reset();
+        map = std::make_unique<Map>(liveEntries + kPerTick);
+
+        auto const ttl = liveEntries / kPerTick;
+
+        for (Map::Ticks tick = 0; tick < ttl; ++tick) {
+            for (auto const& addr : flowsAt(tick)) {
+                map->insert(addr, tick, ttl - tick);
+            }
+        }
+
+        filledWith = liveEntries;
+    }
+
+    return *map;
+}
+}
+
+//===============================================================
+// Every tick: expire the oldest flows and insert as many new ones
+static void BM_ExpiringMapSteadyState(benchmark::State& state) {
+    auto const liveEntries = static_cast<std::size_t>(state.range(0));
+    auto& map = prefilled(liveEntries);
+    auto const ttl = liveEntries / kPerTick;
+    std::size_t expired = 0;
+
+    for (auto _ : state) {
+        auto const now = map.now() + 1;
+        expired += map.advance(now, [] (std::span<Map::Expired> batch) { benchmark::DoNotOptimize(batch.data()); });
+
+        for (auto const& addr : flowsAt(now + ttl - 1)) {
+            map.insert(addr, now, ttl);
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(expired));
+    state.counters["live"] = static_cast<double>(map.size());
+}
+BENCHMARK(BM_ExpiringMapSteadyState)->Arg(100000)->Arg(10000000)->Unit(benchmark::kMicrosecond);
+
+// Refreshing live flows, as on every packet
+static void BM_ExpiringMapRefresh(benchmark::State& state) {
+    auto const liveEntries = static_cast<std::size_t>(state.range(0));
+    auto& map = prefilled(liveEntries);
+    auto const ttl = liveEntries / kPerTick;
+    auto const flows = flowsAt(map.now() + ttl / 2);
+
+    for (auto _ : state) {
+        for (auto const& addr : flows) {
+            benchmark::DoNotOptimize(map.refresh(addr, ttl));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * kPerTick);
+}
+BENCHMARK(BM_ExpiringMapRefresh)->Arg(100000)->Arg(10000000)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,158 @@
+//
+//  ExpiringAddressMap_test.cpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+#include <gtest/gtest.h>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "ExpiringAddressMap.hpp"
+
+namespace
+{
+NetworkAddress peer(std::uint32_t i) {
+    return NetworkAddress::fromIPv4Array(std::span<std::uint32_t const>(&i, 1),
+                                         std::span<std::uint16_t const>()).front();
+}
+
+NetworkAddress peer6(std::uint16_t port) {
+    return *NetworkAddress::fromIPString("[2001:db8::1]:" + std::to_string(port));
+}
+}
+
+// Test inserting, finding, refreshing and erasing entries
+TEST(ExpiringAddressMapTest, InsertFindErase) {
+    ExpiringAddressMap<int> map(16);
+
+    ASSERT_NE(map.insert(peer6(1), 1, 10), nullptr);
+    ASSERT_NE(map.insert(peer6(2), 2, 10), nullptr);
+    EXPECT_EQ(map.size(), 2u);
+    EXPECT_EQ(*map.find(peer6(1)), 1);
+    EXPECT_EQ(map.find(peer6(3)), nullptr);
+
+    // inserting an existing address replaces the value
+    EXPECT_EQ(*map.insert(peer6(1), 3, 10), 3);
+    EXPECT_EQ(map.size(), 2u);
+
+    EXPECT_TRUE(map.erase(peer6(1)));
+    EXPECT_FALSE(map.erase(peer6(1)));
+    EXPECT_FALSE(map.refresh(peer6(1), 10));
+    EXPECT_EQ(map.find(peer6(1)), nullptr);
+    EXPECT_EQ(*map.find(peer6(2)), 2);
+    EXPECT_EQ(map.size(), 1u);
+
+    // UNIX socket addresses have no compact key
+    EXPECT_EQ(map.insert(NetworkAddress::fromUNIXSocketPath("/tmp/sock"), 4, 10), nullptr);
+}
+
+// Test that entries expire exactly after their time to live on every level of the wheel
+TEST(ExpiringAddressMapTest, ExpiresAfterTTL) {
+    using Ticks = ExpiringAddressMap<int>::Ticks;
+
+    for (Ticks const start : {0x0, 0xfffff0}) {
+        for (Ticks const ttl : {Ticks(1), Ticks(255), Ticks(256), Ticks(300), Ticks(65535), Ticks(65536), Ticks(70000), Ticks(20000000), ExpiringAddressMap<int>::kMaxTTL}) {
+            ExpiringAddressMap<int> map(4, start);
+            map.insert(peer(1), 42, ttl);
+
+            std::vector<int> expired;
+            auto const collect = [&expired] (std::span<ExpiringAddressMap<int>::Expired> batch) {
+                for (auto const& e : batch) {
+                    EXPECT_EQ(e.address.toAddress(), peer(1));
+                    expired.push_back(e.value);
+                }
+            };
+
+            EXPECT_EQ(map.advance(start + ttl - 1, collect), 0u) << start << " " << ttl;
+            EXPECT_TRUE(expired.empty());
+            EXPECT_EQ(map.advance(start + ttl, collect), 1u) << start << " " << ttl;
+            EXPECT_EQ(expired, std::vector<int> {42});
+            EXPECT_EQ(map.size(), 0u);
+            EXPECT_EQ(map.now(), start + ttl);
+        }
+    }
+}
+
+// Test the map against a reference of random inserts, refreshes, erases and advances
+TEST(ExpiringAddressMapTest, MatchesReference) {
+    using Map = ExpiringAddressMap<std::uint32_t>;
+    Map map(512, 12345);
+    std::map<std::uint32_t, Map::Ticks> reference;
+    std::mt19937 rng(7);
+
+    for (int round = 0; round < 2000; ++round) {
+        for (int op = 0; op < 8; ++op) {
+            auto const i = rng() % 1024;
+            auto const ttl = Map::Ticks(1) << (rng() % 22);
+            auto const expiry = map.now() + ttl + rng() % ttl;
+
+            switch (rng() % 3) {
+            case 0:
+                if (map.insert(peer(i), i, expiry - map.now()) != nullptr) {
+                    reference[i] = expiry;
+                } else {
+                    EXPECT_EQ(reference.size(), map.maxSize());
+                }
+                break;
+            case 1:
+                EXPECT_EQ(map.refresh(peer(i), expiry - map.now()), reference.contains(i));
+                if (reference.contains(i)) {
+                    reference[i] = expiry;
+                }
+                break;
+            default:
+                EXPECT_EQ(map.erase(peer(i)), reference.erase(i) == 1);
+            }
+        }
+
+        auto const now = map.now() + (rng() % (1u << (rng() % 20)));
+        std::map<std::uint32_t, Map::Ticks> expected;
+
+        for (auto it = reference.begin(); it != reference.end();) {
+            if (it->second <= now) {
+                expected.insert(*it);
+                it = reference.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        std::map<std::uint32_t, Map::Ticks> actual;
+        map.advance(now, [&actual] (std::span<Map::Expired> batch) {
+            for (auto const& e : batch) {
+                actual[e.value] = e.expiry;
+            }
+        });
+
+        for (auto& [i, expiry] : expected) {
+            EXPECT_EQ(actual[i], expiry) << i;
+        }
+
+        ASSERT_EQ(actual.size(), expected.size());
+        ASSERT_EQ(map.size(), reference.size());
+    }
+}
+
+// Test that the size is bounded and expired entries are handed out in batches
+TEST(ExpiringAddressMapTest, BoundedAndBatched) {
+    ExpiringAddressMap<int> map(200);
+
+    for (std::uint32_t i = 0; i < 200; ++i) {
+        ASSERT_NE(map.insert(peer(i), static_cast<int>(i), 5), nullptr);
+    }
+
+    EXPECT_EQ(map.insert(peer(200), 200, 5), nullptr);
+
+    std::vector<std::size_t> batches;
+    EXPECT_EQ(map.advance(5, [&batches] (auto batch) { batches.push_back(batch.size()); }), 200u);
+    EXPECT_EQ(batches, (std::vector<std::size_t> {64, 64, 64, 8}));
+
+    // the nodes are reused
+    EXPECT_NE(map.insert(peer(200), 200, 5), nullptr);
+}
@@ -0,0 +1,159 @@
+//
+//  Instrumentation.hpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+//  Internal header: only included by the library's translation units.
+//
+#pragma once
+#include <atomic>
+#include <chrono>
+
+#include <net/if.h>
+#include <sys/socket.h>
+
+#include "NetworkStatistics.hpp"
+
+//===============================================================
+// USDT tracepoints (provider "cxxnetaddr"). Every probe has the same three
+// arguments: the address family (AF_*), an interface index (0 if not
+// applicable) and the duration of the operation in nanoseconds. Each probe
+// has a semaphore which tracers set when attaching, so nothing - not even
+// the clock reads - is executed while no tracer is attached.
+#ifndef CXXNETADDR_ENABLE_USDT
+ #define CXXNETADDR_ENABLE_USDT 0
+#endif
+
+#if CXXNETADDR_ENABLE_USDT
+ #define _SDT_HAS_SEMAPHORES 1
+ #include <sys/sdt.h>
+
+ extern "C" {
+ extern unsigned short cxxnetaddr_getifaddrs_semaphore;
+ extern unsigned short cxxnetaddr_if_nametoindex_semaphore;
+ extern unsigned short cxxnetaddr_if_indextoname_semaphore;
+ extern unsigned short cxxnetaddr_parse_semaphore;
+ extern unsigned short cxxnetaddr_format_semaphore;
+ }
+
+ #define CXXNETADDR_PROBE_ENABLED(name) __builtin_expect(cxxnetaddr_##name##_semaphore != 0, 0)
+ #define CXXNETADDR_PROBE(name, family, intfIndex, nanoseconds) \
+    DTRACE_PROBE3(cxxnetaddr, name, static_cast<int>(family), static_cast<unsigned>(intfIndex), static_cast<unsigned long long>(nanoseconds))
+#else
+ #define CXXNETADDR_PROBE_ENABLED(name) false
+ #define CXXNETADDR_PROBE(name, family, intfIndex, nanoseconds) do {} while (false)
+#endif
+
+namespace instrumentation
+{
+using Api = NetworkStatistics::Api;
+using Syscall = NetworkStatistics::Syscall;
+
+#if CXXNETADDR_ENABLE_STATS
+//===============================================================
+// The counters of a single thread. Only the owning thread writes, so a
+// relaxed load/store pair is enough and no locked instruction is needed.
+struct ThreadCounters
+{
+    std::array<std::atomic<std::uint64_t>, static_cast<std::size_t>(Api::count)> calls = {};
+    std::array<std::atomic<std::uint64_t>, static_cast<std::size_t>(Api::count)> nanoseconds = {};
+    std::array<std::atomic<std::uint64_t>, static_cast<std::size_t>(Syscall::count)> syscalls = {};
+   #if CXXNETADDR_ENABLE_HISTOGRAMS
+    std::array<std::array<std::atomic<std::uint64_t>, LatencyHistogram::kNumBuckets>, static_cast<std::size_t>(Api::count)> latencies = {};
+   #endif
+};
+
+ThreadCounters& threadCounters() noexcept;
+
+inline void add(std::atomic<std::uint64_t>& counter, std::uint64_t value) noexcept {
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+inline void countSyscall(Syscall syscall) noexcept {
+    add(threadCounters().syscalls[static_cast<std::size_t>(syscall)], 1);
+}
+
+/** Counts a call to an API and the time spent in it. */
+class ApiScope
+{
+public:
+    explicit ApiScope(Api api) noexcept : index(static_cast<std::size_t>(api)), start(std::chrono::steady_clock::now()) {}
+
+    ~ApiScope() {
+        auto const elapsed = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+        auto& counters = threadCounters();
+        add(counters.calls[index], 1);
+        add(counters.nanoseconds[index], elapsed);
+
+       #if CXXNETADDR_ENABLE_HISTOGRAMS
+        add(counters.latencies[index][LatencyHistogram::bucketIndex(elapsed)], 1);
+       #endif
+    }
+
+    ApiScope(ApiScope const&) = delete;
+    ApiScope& operator=(ApiScope const&) = delete;
+
+private:
+    std::size_t index;
+    std::chrono::steady_clock::time_point start;
+};
+#else
+inline void countSyscall(Syscall) noexcept {}
+
+class ApiScope
+{
+public:
+    explicit ApiScope(Api) noexcept {}
+};
+#endif
+
+//===============================================================
+/** Measures the duration of an operation for a USDT probe, if enabled. */
+class ProbeTimer
+{
+public:
+    explicit ProbeTimer(bool enabled) noexcept : start(enabled ? now() : 0) {}
+
+    bool active() const noexcept { return start != 0; }
+    std::uint64_t elapsed() const noexcept { return now() - start; }
+
+private:
+    static std::uint64_t now() noexcept {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    std::uint64_t start;
+};
+
+//===============================================================
+// Instrumented wrappers of the interface name/index syscalls
+inline unsigned ifNameToIndex(char const* name) noexcept {
+    countSyscall(Syscall::ifNameToIndex);
+    ProbeTimer probe(CXXNETADDR_PROBE_ENABLED(if_nametoindex));
+    auto const index = ::if_nametoindex(name);
+
+    if (probe.active()) {
+        CXXNETADDR_PROBE(if_nametoindex, AF_UNSPEC, index, probe.elapsed());
+    }
+
+    return index;
+}
+
+inline char* ifIndexToName(unsigned index, char* name) noexcept {
+    countSyscall(Syscall::ifIndexToName);
+    ProbeTimer probe(CXXNETADDR_PROBE_ENABLED(if_indextoname));
+    auto* result = ::if_indextoname(index, name);
+
+    if (probe.active()) {
+        CXXNETADDR_PROBE(if_indextoname, AF_UNSPEC, index, probe.elapsed());
+    }
+
+    return result;
+}
+}
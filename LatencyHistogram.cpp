@@ -0,0 +1,54 @@
+//
+//  LatencyHistogram.cpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+#include <algorithm>
+#include <cmath>
+
+#include "LatencyHistogram.hpp"
+
+std::uint64_t LatencyHistogram::percentile(double fraction) const noexcept {
+    if (total == 0) {
+        return 0;
+    }
+
+    // the rank of the value, counting from one
+    auto const rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(std::clamp(fraction, 0.0, 1.0) * static_cast<double>(total))));
+    std::uint64_t seen = 0;
+
+    for (std::size_t i = 0; i < kNumBuckets; ++i) {
+        seen += buckets[i];
+
+        if (seen >= rank) {
+            return bucketUpperBound(i);
+        }
+    }
+
+    return bucketUpperBound(kNumBuckets - 1);
+}
+
+LatencyHistogram& LatencyHistogram::operator+=(LatencyHistogram const& other) noexcept {
+    for (std::size_t i = 0; i < kNumBuckets; ++i) {
+        buckets[i] += other.buckets[i];
+    }
+
+    total += other.total;
+    return *this;
+}
+
+LatencyHistogram LatencyHistogram::operator-(LatencyHistogram const& earlier) const noexcept {
+    auto result = *this;
+
+    for (std::size_t i = 0; i < kNumBuckets; ++i) {
+        result.buckets[i] -= earlier.buckets[i];
+    }
+
+    result.total -= earlier.total;
+    return result;
+}
@@ -0,0 +1,132 @@
+//
+//  LatencyHistogram.hpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+#pragma once
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @class LatencyHistogram
+ * @brief A histogram of durations with log-linear (HDR-style) buckets.
+ *
+ * Every power of two is split into kSubBuckets linear buckets, so that the
+ * relative error of any recorded value is at most 1/kSubBuckets while the
+ * whole range up to 2^kMaxValueBits nanoseconds (about 68 seconds) fits in
+ * a small, fixed number of buckets. Larger values are clamped into the
+ * last bucket.
+ *
+ * Histograms recorded independently (e.g. on different threads) can be
+ * merged by adding them.
+ */
+class LatencyHistogram
+{
+public:
+    static constexpr unsigned kSubBucketBits = 4;
+    static constexpr unsigned kMaxValueBits = 36;
+    static constexpr std::size_t kSubBuckets = std::size_t(1) << kSubBucketBits;
+    static constexpr std::size_t kNumBuckets = (kMaxValueBits - kSubBucketBits + 1) * kSubBuckets;
+
+    //===============================================================
+    /**
+     * @brief Gets the bucket a value is counted in.
+     *
+     * @param value The value (usually in nanoseconds).
+     * @return The index of the bucket, smaller than kNumBuckets.
+     */
+    static constexpr std::size_t bucketIndex(std::uint64_t value) noexcept {
+        if (value < kSubBuckets) {
+            return static_cast<std::size_t>(value);
+        }
+
+        auto const shift = static_cast<unsigned>(std::bit_width(value)) - kSubBucketBits - 1;
+
+        if (shift > kMaxValueBits - kSubBucketBits - 1) {
+            return kNumBuckets - 1;
+        }
+
+        return (shift + 1) * kSubBuckets + static_cast<std::size_t>((value >> shift) - kSubBuckets);
+    }
+
+    /**
+     * @brief Gets the smallest value counted in a bucket.
+     */
+    static constexpr std::uint64_t bucketLowerBound(std::size_t index) noexcept {
+        if (index < kSubBuckets) {
+            return index;
+        }
+
+        auto const shift = index / kSubBuckets - 1;
+        return (kSubBuckets + index % kSubBuckets) << shift;
+    }
+
+    /**
+     * @brief Gets the largest value counted in a bucket.
+     *
+     * The last bucket also contains all clamped values.
+     */
+    static constexpr std::uint64_t bucketUpperBound(std::size_t index) noexcept {
+        return index + 1 < kNumBuckets ? bucketLowerBound(index + 1) - 1 : UINT64_MAX;
+    }
+
+    //===============================================================
+    /**
+     * @brief Counts a value.
+     *
+     * @param value The value (usually in nanoseconds).
+     * @param count How often the value occurred.
+     */
+    void record(std::uint64_t value, std::uint64_t count = 1) noexcept {
+        buckets[bucketIndex(value)] += count;
+        total += count;
+    }
+
+    /**
+     * @brief Gets the number of values in a bucket.
+     */
+    std::uint64_t bucketCount(std::size_t index) const noexcept { return buckets[index]; }
+
+    /**
+     * @brief Gets the number of recorded values.
+     */
+    std::uint64_t count() const noexcept { return total; }
+
+    /**
+     * @brief Gets the value below or at which a fraction of all recorded values lie.
+     *
+     * The result is the upper bound of the bucket containing the value, so
+     * it overestimates the exact percentile by at most 1/kSubBuckets.
+     *
+     * @param fraction The fraction in [0, 1], e.g. 0.99 for the 99th percentile.
+     * @return The percentile or zero if the histogram is empty.
+     */
+    std::uint64_t percentile(double fraction) const noexcept;
+
+    /**
+     * @brief Gets the median, 99th and 99.9th percentile.
+     */
+    std::uint64_t p50() const noexcept  { return percentile(0.5); }
+    std::uint64_t p99() const noexcept  { return percentile(0.99); }
+    std::uint64_t p999() const noexcept { return percentile(0.999); }
+
+    //===============================================================
+    /** Merges the values of another histogram into this one. */
+    LatencyHistogram& operator+=(LatencyHistogram const& other) noexcept;
+
+    /** The values recorded between an earlier copy of a histogram and this one. */
+    LatencyHistogram operator-(LatencyHistogram const& earlier) const noexcept;
+
+    bool operator==(LatencyHistogram const&) const = default;
+
+private:
+    std::array<std::uint64_t, kNumBuckets> buckets = {};
+    std::uint64_t total = 0;
+};
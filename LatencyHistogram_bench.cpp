@@ -0,0 +1,82 @@
+//
+//  LatencyHistogram_bench.cpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "LatencyHistogram.hpp"
+
+namespace
+{
+// log-uniformly distributed durations between 1ns and ~1s
+std::vector<std::uint64_t> const& durations() {
+    static auto const result = [] {
+        std::mt19937_64 rng(42);
+        std::uniform_real_distribution<double> exponent(0.0, 30.0);
+        std::vector<std::uint64_t> values(4096);
+
+        for (auto& value : values) {
+            value = static_cast<std::uint64_t>(std::exp2(exponent(rng)));
+        }
+
+        return values;
+    }();
+
+    return result;
+}
+}
+
+//===============================================================
+static void BM_LatencyHistogramRecord(benchmark::State& state) {
+    auto const& values = durations();
+    LatencyHistogram histogram;
+    std::size_t i = 0;
+
+    for (auto _ : state) {
+        histogram.record(values[i++ % values.size()]);
+    }
+
+    benchmark::DoNotOptimize(histogram.count());
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LatencyHistogramRecord);
+
+static void BM_LatencyHistogramPercentile(benchmark::State& state) {
+    LatencyHistogram histogram;
+
+    for (auto value : durations()) {
+        histogram.record(value);
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(histogram.p999());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LatencyHistogramPercentile);
+
+static void BM_LatencyHistogramMerge(benchmark::State& state) {
+    LatencyHistogram histogram, total;
+
+    for (auto value : durations()) {
+        histogram.record(value);
+    }
+
+    for (auto _ : state) {
+        total += histogram;
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LatencyHistogramMerge);
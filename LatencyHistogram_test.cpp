@@ -0,0 +1,92 @@
+//
+//  LatencyHistogram_test.cpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+#include <gtest/gtest.h>
+
+#include "LatencyHistogram.hpp"
+#include "NetworkInterface.hpp"
+#include "NetworkStatistics.hpp"
+
+// Test that the buckets are contiguous and contain the values mapped to them
+TEST(LatencyHistogramTest, BucketsAreContiguous) {
+    EXPECT_EQ(LatencyHistogram::bucketLowerBound(0), 0u);
+
+    for (std::size_t i = 0; i + 1 < LatencyHistogram::kNumBuckets; ++i) {
+        EXPECT_EQ(LatencyHistogram::bucketUpperBound(i) + 1, LatencyHistogram::bucketLowerBound(i + 1)) << i;
+        EXPECT_EQ(LatencyHistogram::bucketIndex(LatencyHistogram::bucketLowerBound(i)), i);
+        EXPECT_EQ(LatencyHistogram::bucketIndex(LatencyHistogram::bucketUpperBound(i)), i);
+    }
+
+    EXPECT_EQ(LatencyHistogram::bucketIndex(UINT64_MAX), LatencyHistogram::kNumBuckets - 1);
+    EXPECT_EQ(LatencyHistogram::bucketIndex(std::uint64_t(1) << LatencyHistogram::kMaxValueBits), LatencyHistogram::kNumBuckets - 1);
+}
+
+// Test that the relative error of every bucket is bounded
+TEST(LatencyHistogramTest, RelativeErrorIsBounded) {
+    for (std::uint64_t value = 1; value < (std::uint64_t(1) << LatencyHistogram::kMaxValueBits); value = value * 3 / 2 + 1) {
+        auto const index = LatencyHistogram::bucketIndex(value);
+        auto const width = LatencyHistogram::bucketUpperBound(index) - LatencyHistogram::bucketLowerBound(index);
+        EXPECT_LE(static_cast<double>(width), static_cast<double>(value) / LatencyHistogram::kSubBuckets) << value;
+    }
+}
+
+// Test percentiles of a known distribution
+TEST(LatencyHistogramTest, Percentiles) {
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.p99(), 0u);
+
+    for (std::uint64_t value = 1; value <= 1000; ++value) {
+        histogram.record(value * 1000);
+    }
+
+    EXPECT_EQ(histogram.count(), 1000u);
+
+    for (auto [fraction, exact] : {std::pair{0.5, 500000.0}, std::pair{0.99, 990000.0}, std::pair{0.999, 999000.0}, std::pair{1.0, 1000000.0}}) {
+        auto const p = static_cast<double>(histogram.percentile(fraction));
+        EXPECT_GE(p, exact) << fraction;
+        EXPECT_LE(p, exact * (1.0 + 1.0 / LatencyHistogram::kSubBuckets)) << fraction;
+    }
+
+    EXPECT_LE(histogram.p50(), histogram.p99());
+    EXPECT_LE(histogram.p99(), histogram.p999());
+}
+
+// Test that histograms can be merged and subtracted
+TEST(LatencyHistogramTest, MergesAndSubtracts) {
+    LatencyHistogram a, b;
+    a.record(10, 5);
+    b.record(10);
+    b.record(1000000);
+
+    auto merged = a;
+    merged += b;
+
+    EXPECT_EQ(merged.count(), 7u);
+    EXPECT_EQ(merged.bucketCount(LatencyHistogram::bucketIndex(10)), 6u);
+    EXPECT_EQ(merged - a, b);
+}
+
+// Test that the library records latencies of its APIs (if enabled)
+TEST(LatencyHistogramTest, RecordsAPILatencies) {
+    if constexpr (! NetworkStatistics::histogramsEnabled) {
+        EXPECT_EQ(NetworkStatistics::latency(NetworkStatistics::Api::interfaceGetAll).count(), 0u);
+        GTEST_SKIP() << "library built without CXXNETADDR_ENABLE_HISTOGRAMS";
+    }
+
+    auto const before = NetworkStatistics::latency(NetworkStatistics::Api::interfaceGetAll);
+
+    for (int i = 0; i < 10; ++i) {
+        (void) NetworkInterface::getAllInterfaces();
+    }
+
+    auto const diff = NetworkStatistics::latency(NetworkStatistics::Api::interfaceGetAll) - before;
+    EXPECT_EQ(diff.count(), 10u);
+    EXPECT_GT(diff.p50(), 0u);
+}
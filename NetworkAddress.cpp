@@ -13,185 +13,558 @@
 #include <cassert>
 #include <array>
 #include <cstring>
-#include <stdexcept>
-#include <iomanip>
-#include <sstream>
 #include <algorithm>
+#include <charconv>
+#include <limits>
 
 #include <sys/types.h>
 #include <sys/un.h>
-#include <netdb.h>
 #include <arpa/inet.h>
 #include <netinet/in.h>
+#include <net/if.h>
 
 
-#if __APPLE__
- #include <net/if_dl.h>
- #include <net/if_types.h>
- static constexpr ::sa_family_t kFamilyLinkLevel = AF_LINK;
-#elif __linux__
- #include <linux/if_packet.h>
- static constexpr ::sa_family_t kFamilyLinkLevel = AF_PACKET;
-#endif
-
 #include <net/ethernet.h>
 
 #include "CxxUtilities.hpp"
+#include "Instrumentation.hpp"
 
 #include "NetworkAddress.hpp"
+#include "NetworkAddressImpl.hpp"
 #include "NetworkInterface.hpp"
 
 namespace
 {
+using namespace cxxnetaddr::detail;
+
 //===============================================================
-// Convert between our family enum and UNIX's sa_family_t
-constexpr NetworkAddress::Family unix2addr(::sa_family_t family) noexcept {
-    switch (family) {
-    case AF_UNIX:          return NetworkAddress::Family::unixSocket;
-    case kFamilyLinkLevel: return NetworkAddress::Family::ethernet;
-    case AF_INET:          return NetworkAddress::Family::ipv4;
-    case AF_INET6:         return NetworkAddress::Family::ipv6;
-    default: break;
+// Parsing and formatting of addresses. Unlike getaddrinfo/getnameinfo
+// these are pure functions: they do not take locks or consult NSS and
+// locale state, so they scale linearly with the number of threads.
+constexpr char kHexDigitsLower[] = "0123456789abcdef";
+constexpr char kHexDigitsUpper[] = "0123456789ABCDEF";
+
+char* writeDecimal(char* p, std::uint32_t value) noexcept {
+    return std::to_chars(p, p + 10, value).ptr;
+}
+
+char* writeIPv4(char* p, std::uint8_t const* octets) noexcept {
+    for (int i = 0; i < 4; ++i) {
+        if (i != 0) {
+            *p++ = '.';
+        }
+
+        p = writeDecimal(p, octets[i]);
+    }
+
+    return p;
+}
+
+// Same output as glibc's inet_ntop: the leftmost longest run of at least
+// two zero words is compressed and IPv4-mapped/compatible addresses end
+// in dotted-quad notation.
+char* writeIPv6(char* p, ::in6_addr const& addr, char const* digits = kHexDigitsLower) noexcept {
+    auto const* bytes = addr.s6_addr;
+    std::array<std::uint16_t, 8> words;
+
+    for (std::size_t i = 0; i < words.size(); ++i) {
+        words[i] = static_cast<std::uint16_t>((bytes[2 * i] << 8) | bytes[2 * i + 1]);
+    }
+
+    int bestBase = -1, bestLen = 0;
+    for (int i = 0, curBase = -1; i <= 8; ++i) {
+        if (i < 8 && words[static_cast<std::size_t>(i)] == 0) {
+            curBase = (curBase == -1 ? i : curBase);
+        } else if (curBase != -1) {
+            if (i - curBase > bestLen) {
+                bestBase = curBase;
+                bestLen = i - curBase;
+            }
+
+            curBase = -1;
+        }
+    }
+
+    if (bestLen < 2) {
+        bestBase = -1;
+    }
+
+    for (int i = 0; i < 8; ++i) {
+        if (bestBase != -1 && i >= bestBase && i < bestBase + bestLen) {
+            if (i == bestBase) {
+                *p++ = ':';
+            }
+
+            continue;
+        }
+
+        if (i != 0) {
+            *p++ = ':';
+        }
+
+        if (i == 6 && bestBase == 0 && (bestLen == 6 || (bestLen == 5 && words[5] == 0xffff))) {
+            return writeIPv4(p, bytes + 12);
+        }
+
+        auto const w = words[static_cast<std::size_t>(i)];
+        for (int shift = 12; shift >= 0; shift -= 4) {
+            if ((w >> shift) != 0 || shift == 0) {
+                *p++ = digits[(w >> shift) & 0xf];
+            }
+        }
+    }
+
+    if (bestBase != -1 && bestBase + bestLen == 8) {
+        *p++ = ':';
+    }
+
+    return p;
+}
+
+// all eight words with four digits each, e.g. 2001:0db8:0000:0000:0000:0000:0000:0001
+char* writeIPv6Expanded(char* p, ::in6_addr const& addr, char const* digits) noexcept {
+    for (std::size_t i = 0; i < sizeof(addr.s6_addr); ++i) {
+        if (i != 0 && i % 2 == 0) {
+            *p++ = ':';
+        }
+
+        *p++ = digits[addr.s6_addr[i] >> 4];
+        *p++ = digits[addr.s6_addr[i] & 0xf];
     }
 
-    return NetworkAddress::Family::unspecified;
+    return p;
 }
 
-constexpr ::sa_family_t addr2unix(NetworkAddress::Family family) noexcept {
-    switch (family) {
-    case NetworkAddress::Family::unixSocket: return AF_UNIX;
-    case NetworkAddress::Family::ethernet:   return kFamilyLinkLevel;
-    case NetworkAddress::Family::ipv4:       return AF_INET;
-    case NetworkAddress::Family::ipv6:       return AF_INET6;
+char* writeMAC(char* p, std::uint8_t const* mac, std::size_t len, char const* digits = kHexDigitsUpper) noexcept {
+    for (std::size_t i = 0; i < len; ++i) {
+        if (i != 0) {
+            *p++ = ':';
+        }
+
+        *p++ = digits[mac[i] >> 4];
+        *p++ = digits[mac[i] & 0xf];
+    }
+
+    return p;
+}
+
+using FormatOptions = NetworkAddress::FormatOptions;
+
+char const* hexDigits(FormatOptions::Case hexCase, char const* standard) noexcept {
+    switch (hexCase) {
+    case FormatOptions::Case::lower: return kHexDigitsLower;
+    case FormatOptions::Case::upper: return kHexDigitsUpper;
     default: break;
     }
 
-    return AF_UNSPEC;
+    return standard;
 }
 
-template <NetworkAddress::Family family>
-constexpr auto family2type(std::integral_constant<NetworkAddress::Family, family>) {
-    if constexpr (family == NetworkAddress::Family::unixSocket) return std::type_identity<sockaddr_un> ();
-   #if __APPLE__  
-    if constexpr (family == NetworkAddress::Family::ethernet)   return std::type_identity<sockaddr_dl> ();
-   #elif __linux__
-    if constexpr (family == NetworkAddress::Family::ethernet)   return std::type_identity<sockaddr_ll> ();
-   #endif
-    if constexpr (family == NetworkAddress::Family::ipv4)       return std::type_identity<sockaddr_in> ();
-    if constexpr (family == NetworkAddress::Family::ipv6)       return std::type_identity<sockaddr_in6>();
+std::to_chars_result copyChars(char* first, char* last, char const* begin, char const* end) noexcept {
+    auto const len = static_cast<std::size_t>(end - begin);
+
+    if (static_cast<std::size_t>(last - first) < len) {
+        return {last, std::errc::value_too_large};
+    }
+
+    std::memcpy(first, begin, len);
+    return {first + len, std::errc()};
 }
 
-void assertWrongFamilyType() {
-    // You are trying to use a NetworkAddress method that
-    // is not supported by the your NetworkAddress' family type
-    assert(false);
+//===============================================================
+int hexValue(char c) noexcept {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// strict dotted-quad as accepted by inet_pton: four decimal octets
+// without leading zeros
+bool parseIPv4(std::string_view str, std::uint8_t* octets) noexcept {
+    std::size_t count = 0;
+    unsigned value = 0;
+    bool sawDigit = false;
+
+    for (auto c : str) {
+        if (c >= '0' && c <= '9') {
+            if (sawDigit && value == 0) {
+                return false;
+            }
+
+            value = value * 10 + static_cast<unsigned>(c - '0');
+
+            if (value > 255) {
+                return false;
+            }
+
+            sawDigit = true;
+        } else if (c == '.' && sawDigit && count < 3) {
+            octets[count++] = static_cast<std::uint8_t>(value);
+            value = 0;
+            sawDigit = false;
+        } else {
+            return false;
+        }
+    }
+
+    if (! sawDigit || count != 3) {
+        return false;
+    }
+
+    octets[count] = static_cast<std::uint8_t>(value);
+    return true;
+}
+
+// IPv6 as accepted by inet_pton, including a trailing dotted-quad
+bool parseIPv6(std::string_view str, std::uint8_t* out) noexcept {
+    std::array<std::uint8_t, 16> tmp = {};
+    std::size_t tp = 0, i = 0, token = 0;
+    std::optional<std::size_t> colon;
+    unsigned value = 0, digits = 0;
+
+    if (! str.empty() && str.front() == ':') {
+        if (str.size() < 2 || str[1] != ':') {
+            return false;
+        }
+
+        i = 1;
+    }
+
+    for (; i < str.size(); ++i) {
+        auto const c = str[i];
+
+        if (auto const h = hexValue(c); h >= 0) {
+            if (++digits > 4) {
+                return false;
+            }
+
+            value = (value << 4) | static_cast<unsigned>(h);
+            continue;
+        }
+
+        if (c == ':') {
+            token = i + 1;
+
+            if (digits == 0) {
+                if (colon) {
+                    return false;
+                }
+
+                colon = tp;
+                continue;
+            }
+
+            if (i + 1 == str.size() || tp + 2 > tmp.size()) {
+                return false;
+            }
+
+            tmp[tp++] = static_cast<std::uint8_t>(value >> 8);
+            tmp[tp++] = static_cast<std::uint8_t>(value);
+            value = digits = 0;
+            continue;
+        }
+
+        if (c == '.' && tp + 4 <= tmp.size() && parseIPv4(str.substr(token), tmp.data() + tp)) {
+            tp += 4;
+            digits = 0;
+            break;
+        }
+
+        return false;
+    }
+
+    if (digits != 0) {
+        if (tp + 2 > tmp.size()) {
+            return false;
+        }
+
+        tmp[tp++] = static_cast<std::uint8_t>(value >> 8);
+        tmp[tp++] = static_cast<std::uint8_t>(value);
+    }
+
+    if (colon) {
+        if (tp == tmp.size()) {
+            return false;
+        }
+
+        auto const n = tp - *colon;
+        std::memmove(tmp.data() + tmp.size() - n, tmp.data() + *colon, n);
+        std::memset(tmp.data() + *colon, 0, tmp.size() - tp);
+        tp = tmp.size();
+    }
+
+    if (tp != tmp.size()) {
+        return false;
+    }
+
+    std::memcpy(out, tmp.data(), tmp.size());
+    return true;
+}
+
+std::optional<std::uint32_t> parseDecimal(std::string_view str, std::uint32_t max) noexcept {
+    std::uint32_t value = 0;
+    auto const* end = str.data() + str.size();
+
+    if (str.empty() || str.front() < '0' || str.front() > '9') {
+        return {};
+    }
+
+    if (auto const [ptr, ec] = std::from_chars(str.data(), end, value); ec != std::errc() || ptr != end || value > max) {
+        return {};
+    }
+
+    return value;
+}
+
+// numeric scope ids or interface names
+std::optional<std::uint32_t> parseScope(std::string_view zone) noexcept {
+    if (auto const numeric = parseDecimal(zone, std::numeric_limits<std::uint32_t>::max()); numeric) {
+        return numeric;
+    }
+
+    char name[IF_NAMESIZE];
+
+    if (zone.empty() || zone.size() >= sizeof(name)) {
+        return {};
+    }
+
+    std::memcpy(name, zone.data(), zone.size());
+    name[zone.size()] = '\0';
+
+    if (auto const index = instrumentation::ifNameToIndex(name); index != 0) {
+        return index;
+    }
+
+    return {};
 }
 
 //===============================================================
-template <NetworkAddress::Family, bool shouldCopyBack = true> struct SocketImpl;
+// Comparison of the meaningful fields of two addresses of the same family.
+// Padding, sin_zero, flow info etc. never take part. See operator<=>
+// for the resulting order.
+template <typename T>
+constexpr int compareValues(T a, T b) noexcept { return (a > b) - (a < b); }
+
+// address and port as a single number in host byte order
+std::uint64_t ipv4Key(::sockaddr_in const& sock) noexcept {
+    return (std::uint64_t(cxxutils::byteswap(sock.sin_addr.s_addr)) << 16) | cxxutils::byteswap(sock.sin_port);
+}
 
-template <typename S, typename Lambda>
-auto sockcall(S& s, Lambda && lambda) {
-    static constexpr auto kMaxEnumValue = std::integral_constant<NetworkAddress::Family, NetworkAddress::Family::unspecified>();
-    static constexpr auto kIsConstCall = std::is_const_v<std::remove_reference_t<S>>;
+int compareIPv6(::sockaddr_in6 const& a, ::sockaddr_in6 const& b) noexcept {
+    std::uint64_t wa[2], wb[2];
+    std::memcpy(wa, a.sin6_addr.s6_addr, sizeof(wa));
+    std::memcpy(wb, b.sin6_addr.s6_addr, sizeof(wb));
 
-    return cxxutils::constexpr_apply(unix2addr(s.ss_family), kMaxEnumValue, [_lambda = std::move(lambda), &s] (auto f) {
-        return _lambda(SocketImpl<decltype(f)::value, ! kIsConstCall>(s));
-    });
+    for (std::size_t i = 0; i < 2; ++i) {
+        if (wa[i] != wb[i]) {
+            return compareValues(cxxutils::byteswap(wa[i]), cxxutils::byteswap(wb[i]));
+        }
+    }
+
+    if (a.sin6_scope_id != b.sin6_scope_id) {
+        return compareValues(a.sin6_scope_id, b.sin6_scope_id);
+    }
+
+    return compareValues(cxxutils::byteswap(a.sin6_port), cxxutils::byteswap(b.sin6_port));
+}
+
+#if __APPLE__
+int compareLinkLevel(::sockaddr_dl const& a, ::sockaddr_dl const& b) noexcept {
+    if (a.sdl_alen != b.sdl_alen) {
+        return compareValues(a.sdl_alen, b.sdl_alen);
+    }
+
+    if (auto const r = std::memcmp(LLADDR(&a), LLADDR(&b), a.sdl_alen); r != 0) {
+        return compareValues(r, 0);
+    }
+
+    return compareValues(a.sdl_index, b.sdl_index);
+}
+#elif __linux__
+int compareLinkLevel(::sockaddr_ll const& a, ::sockaddr_ll const& b) noexcept {
+    if (a.sll_halen != b.sll_halen) {
+        return compareValues(a.sll_halen, b.sll_halen);
+    }
+
+    auto const len = std::min(static_cast<std::size_t>(a.sll_halen), sizeof(a.sll_addr));
+
+    if (auto const r = std::memcmp(a.sll_addr, b.sll_addr, len); r != 0) {
+        return compareValues(r, 0);
+    }
+
+    if (a.sll_ifindex != b.sll_ifindex) {
+        return compareValues(a.sll_ifindex, b.sll_ifindex);
+    }
+
+    return compareValues(cxxutils::byteswap(a.sll_protocol), cxxutils::byteswap(b.sll_protocol));
+}
+#endif
+
+// abstract names start with a NUL and therefore come first
+int compareUnixPaths(SocketStorage const& a, SocketStorage const& b) noexcept {
+    auto const lenA = a.unixSocket.sunPathLength, lenB = b.unixSocket.sunPathLength;
+
+    if (auto const r = std::memcmp(a.un.sun_path, b.un.sun_path, std::min(lenA, lenB)); r != 0) {
+        return compareValues(r, 0);
+    }
+
+    return compareValues(lenA, lenB);
+}
+
+int compareSameFamily(SocketStorage const& a, SocketStorage const& b) noexcept {
+    switch (a.ss.ss_family) {
+    case AF_INET:          return compareValues(ipv4Key(a.in4), ipv4Key(b.in4));
+    case AF_INET6:         return compareIPv6(a.in6, b.in6);
+    case kFamilyLinkLevel: return compareLinkLevel(a.ll, b.ll);
+    case AF_UNIX:          return compareUnixPaths(a, b);
+    default: break;
+    }
+
+    return 0;
 }
 
 //===============================================================
-// to avoid C++ undefined behavior, the type-erased sockaddr_storage
-// is memcpy to the actual type via RAII. As the actual type lives on the stack,
-// all tested compilers optimize away the memcpys.
-template <NetworkAddress::Family family, bool shouldCopyBack> 
-struct SocketMethods {
-    using Child = SocketImpl<family, shouldCopyBack>;
-    using Type = decltype(family2type(std::integral_constant<NetworkAddress::Family, family>()))::type;
-    using RefType = std::conditional_t<shouldCopyBack,::sockaddr_storage&, ::sockaddr_storage const&>;
+// Hashing of the same fields that are compared above
+constexpr std::uint64_t mixBits(std::uint64_t x) noexcept {
+    // the finalizer of MurmurHash3
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdull;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ull;
+    return x ^ (x >> 33);
+}
 
-    SocketMethods(RefType _storage) noexcept : storage(_storage) {
-        assert(storage.ss_family == addr2unix(family));
-        std::memcpy(&sock, &storage, sizeof(Type));
+constexpr std::uint64_t combine(std::uint64_t seed, std::uint64_t value) noexcept {
+    return mixBits(seed ^ (value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2)));
+}
+
+std::uint64_t hashBytes(std::uint64_t seed, std::uint8_t const* bytes, std::size_t len) noexcept {
+    for (; len >= sizeof(std::uint64_t); bytes += sizeof(std::uint64_t), len -= sizeof(std::uint64_t)) {
+        std::uint64_t word;
+        std::memcpy(&word, bytes, sizeof(word));
+        seed = combine(seed, word);
     }
 
-    ~SocketMethods() noexcept {
-        if constexpr (shouldCopyBack)
-            std::memcpy(&storage, &sock, sizeof(Type));
+    std::uint64_t tail = len;
+
+    for (std::size_t i = 0; i < len; ++i) {
+        tail = (tail << 8) | bytes[i];
     }
 
-    bool valid() const                         { return false; }
-    bool isMulticast() const                   { assertWrongFamilyType(); return false; }
-    bool isLinkLocal() const                   { assertWrongFamilyType(); return false; }
-    NetworkInterface interface() const         { assertWrongFamilyType(); return {}; }
-    std::uint16_t port() const                 { assertWrongFamilyType(); return 0; }
-    std::uint16_t protocol() const             { assertWrongFamilyType(); return 0; }
-    void setInterface(NetworkInterface const&) { assertWrongFamilyType(); }
-    void setPort(std::uint16_t)                { assertWrongFamilyType(); }
-    void setProtocol(std::uint16_t)            { assertWrongFamilyType(); }
-    ::in_addr get_sin_addr() const             { assertWrongFamilyType(); return {}; }
-    ::in6_addr get_sin6_addr() const           { assertWrongFamilyType(); return {}; }
+    return combine(seed, tail);
+}
 
+std::uint64_t hashSameFamily(SocketStorage const& s) noexcept {
+    std::uint64_t const seed = s.ss.ss_family;
+
+    switch (s.ss.ss_family) {
+    case AF_INET:
+        return combine(seed, ipv4Key(s.in4));
+    case AF_INET6:
+        return combine(hashBytes(seed, s.in6.sin6_addr.s6_addr, sizeof(s.in6.sin6_addr.s6_addr)),
+                       (std::uint64_t(s.in6.sin6_scope_id) << 16) | s.in6.sin6_port);
+    case kFamilyLinkLevel:
+       #if __APPLE__
+        return combine(hashBytes(seed, reinterpret_cast<std::uint8_t const*>(LLADDR(&s.ll)), s.ll.sdl_alen), s.ll.sdl_index);
+       #elif __linux__
+        return combine(hashBytes(seed, s.ll.sll_addr, std::min(static_cast<std::size_t>(s.ll.sll_halen), sizeof(s.ll.sll_addr))),
+                       (std::uint64_t(static_cast<std::uint32_t>(s.ll.sll_ifindex)) << 16) | s.ll.sll_protocol);
+       #endif
+    case AF_UNIX:
+        return hashBytes(seed, reinterpret_cast<std::uint8_t const*>(s.un.sun_path), s.unixSocket.sunPathLength);
+    default: break;
+    }
 
-    auto _this()       { return static_cast<Child*>      (this); }
-    auto _this() const { return static_cast<Child const*>(this); }
-    
-    RefType storage;
-    Type sock;
-};
+    // all unspecified addresses are equal
+    return 0;
+}
+
+// the scope id of IPv6 addresses for tracing, zero otherwise
+[[maybe_unused]] std::uint32_t scopeId(SocketStorage const& storage) noexcept {
+    return storage.ss.ss_family == AF_INET6 ? storage.in6.sin6_scope_id : 0;
+}
+
+//===============================================================
+template <NetworkAddress::Family, bool isMutable = true> struct SocketImpl;
+
+template <typename S, typename Lambda>
+auto sockcall(S& s, Lambda && lambda) {
+    return cxxnetaddr::detail::sockcall<SocketImpl>(s, std::move(lambda));
+}
 
 //===============================================================
 //===============================================================
 // The acutal implmentations of NetworkAddress' methods and
-// constructors, for all the different socket types, starts here
+// constructors, for all the different socket types, starts here.
+// The trivial accessors are in SocketAccessors (NetworkAddressImpl.hpp).
 
 //===============================================================
 // IPv4 and IPv6 common base class
-template <NetworkAddress::Family family, bool shouldCopyBack>
-struct IPSocketImpl : SocketMethods<family, shouldCopyBack>
+template <NetworkAddress::Family family, bool isMutable>
+struct IPSocketImpl : SocketAccessors<family, isMutable>
 {
-    using Base = SocketMethods<family, shouldCopyBack>;
-    using Child = Base::Child;
+    using Base = SocketAccessors<family, isMutable>;
 
     IPSocketImpl(Base::RefType _storage) noexcept : Base(_storage) {}
 
-    bool valid() const noexcept { return true; }
-    ::socklen_t socketLength() const noexcept { return static_cast<::socklen_t>(sizeof(typename Base::Type)); }
+    std::to_chars_result toChars(char* first, char* last, FormatOptions const& options) const {
+        char buffer[NetworkAddress::kMaxStringLength];
+        auto* p = buffer;
+        auto const port = Base::port();
 
-    std::string toString() const {
-        char host[256];
-        char service[8];
-        auto const& sck = Base::sock;
-
-        auto status = ::getnameinfo(reinterpret_cast<::sockaddr const*>(&sck),
-                                    socketLength(),
-                                    host, sizeof(host), service, sizeof(service), NI_NUMERICHOST | NI_NUMERICSERV);
-        
-        if (status != 0) {
-            throw std::runtime_error(::gai_strerror(status));
+        if (options.part == FormatOptions::Part::port) {
+            return copyChars(first, last, buffer, writeDecimal(p, port));
         }
 
-        auto result = std::string(host);
-        
-        if (Base::_this()->port() != 0) {
-            if constexpr (family == NetworkAddress::Family::ipv6) {
-                result = std::string("[") + result + std::string("]");
+        // brackets only separate the port
+        auto const withPort = port != 0 && options.part == FormatOptions::Part::all;
+
+        if constexpr (family == NetworkAddress::Family::ipv4) {
+            p = writeIPv4(p, reinterpret_cast<std::uint8_t const*>(&Base::sock.sin_addr.s_addr));
+        } else {
+            auto const& sck = Base::sock;
+            auto const* digits = hexDigits(options.hexCase, kHexDigitsLower);
+
+            if (withPort) {
+                *p++ = '[';
+            }
+
+            p = options.expandIPv6 ? writeIPv6Expanded(p, sck.sin6_addr, digits) : writeIPv6(p, sck.sin6_addr, digits);
+
+            // like getnameinfo: interface names for link-local scopes, numeric otherwise
+            if (sck.sin6_scope_id != 0) {
+                *p++ = '%';
+                auto const isLinkLocalScope = IN6_IS_ADDR_LINKLOCAL(&sck.sin6_addr) || IN6_IS_ADDR_MC_LINKLOCAL(&sck.sin6_addr);
+
+                if (isLinkLocalScope && instrumentation::ifIndexToName(sck.sin6_scope_id, p) != nullptr) {
+                    p += ::strnlen(p, IF_NAMESIZE);
+                } else {
+                    p = writeDecimal(p, sck.sin6_scope_id);
+                }
             }
 
-            result += std::string(":") + std::string(service);
+            if (withPort) {
+                *p++ = ']';
+            }
         }
 
-        return result;
+        if (withPort) {
+            *p++ = ':';
+            p = writeDecimal(p, port);
+        }
+
+        return copyChars(first, last, buffer, p);
     }
 };
 
 //===============================================================
 // IPv4 implementation of methods
-template <bool shouldCopyBack>
-struct SocketImpl<NetworkAddress::Family::ipv4, shouldCopyBack> : IPSocketImpl<NetworkAddress::Family::ipv4, shouldCopyBack> {
-    using Base = SocketMethods<NetworkAddress::Family::ipv4, shouldCopyBack>;
+template <bool isMutable>
+struct SocketImpl<NetworkAddress::Family::ipv4, isMutable> : IPSocketImpl<NetworkAddress::Family::ipv4, isMutable> {
+    using Base = SocketAccessors<NetworkAddress::Family::ipv4, isMutable>;
 
-    SocketImpl(Base::RefType _storage) noexcept : IPSocketImpl<NetworkAddress::Family::ipv4, shouldCopyBack>(_storage) {}
+    SocketImpl(Base::RefType _storage) noexcept : IPSocketImpl<NetworkAddress::Family::ipv4, isMutable>(_storage) {}
 
     void init(std::span<std::uint8_t const, 4> const& octets, std::uint16_t port) noexcept {
         std::uint32_t saddr;
@@ -208,24 +581,18 @@ struct SocketImpl<NetworkAddress::Family::ipv4, shouldCopyBack> : IPSocketImpl<N
               std::uint16_t port) noexcept {
         init(std::array<std::uint8_t, 4>{{o1, o2, o3, o4}}, port);
     }
-    
-    std::string toString() const                                { return IPSocketImpl<NetworkAddress::Family::ipv4, shouldCopyBack>::toString(); }
-    bool isMulticast() const noexcept                           { return (cxxutils::byteswap(Base::sock.sin_addr.s_addr) & 0xf0000000u) == 0xe0000000u; }
+
     void setInterface(NetworkInterface const&) noexcept         {}
     std::optional<NetworkInterface> interface() const noexcept  { return {}; }
-    bool isLinkLocal() const noexcept                           { return (cxxutils::byteswap(Base::sock.sin_addr.s_addr) & 0xffff0000u) == 0xa9fe0000u; }
-    std::uint16_t port() const noexcept                         { return cxxutils::byteswap(Base::sock.sin_port); }
-    void setPort(std::uint16_t p) noexcept                      { Base::sock.sin_port = cxxutils::byteswap(p); }
-    ::in_addr get_sin_addr() const noexcept                     { return Base::sock.sin_addr; }
 };
 
 //===============================================================
 // IPv6 implementation of methods
-template <bool shouldCopyBack>
-struct SocketImpl<NetworkAddress::Family::ipv6, shouldCopyBack> : IPSocketImpl<NetworkAddress::Family::ipv6, shouldCopyBack> {
-    using Base = SocketMethods<NetworkAddress::Family::ipv6, shouldCopyBack>;
+template <bool isMutable>
+struct SocketImpl<NetworkAddress::Family::ipv6, isMutable> : IPSocketImpl<NetworkAddress::Family::ipv6, isMutable> {
+    using Base = SocketAccessors<NetworkAddress::Family::ipv6, isMutable>;
 
-    SocketImpl(Base::RefType _storage) noexcept : IPSocketImpl<NetworkAddress::Family::ipv6, shouldCopyBack>(_storage) {}
+    SocketImpl(Base::RefType _storage) noexcept : IPSocketImpl<NetworkAddress::Family::ipv6, isMutable>(_storage) {}
 
     void init(std::span<std::uint16_t const, 8u> sw, std::uint16_t port, NetworkInterface const& intf) noexcept {
         static_assert(sizeof(Base::sock.sin6_addr.s6_addr) == sw.size() * sizeof(std::uint16_t));
@@ -248,22 +615,16 @@ struct SocketImpl<NetworkAddress::Family::ipv6, shouldCopyBack> : IPSocketImpl<N
         init(std::array<std::uint16_t, 8>{{w1, w2, w3, w4, w5, w6, w7, w8}}, port, intf);
     }
 
-    std::string toString() const                               { return IPSocketImpl<NetworkAddress::Family::ipv6, shouldCopyBack>::toString(); }
-    bool isMulticast() const noexcept                          { return (Base::sock.sin6_addr.s6_addr[0] == 0xff); }
     void setInterface(NetworkInterface const& intf) noexcept   { Base::sock.sin6_scope_id = intf.getIndex(); }
     std::optional<NetworkInterface> interface() const noexcept { return NetworkInterface::fromIntfIndex(Base::sock.sin6_scope_id); }
-    bool isLinkLocal() const noexcept                          { return (Base::sock.sin6_addr.s6_addr[0] == 0xfe) && (Base::sock.sin6_addr.s6_addr[1] == 0x80); }
-    std::uint16_t port() const noexcept                        { return cxxutils::byteswap(Base::sock.sin6_port); }
-    void setPort(std::uint16_t p) noexcept                     { Base::sock.sin6_port = cxxutils::byteswap(p); }
-    ::in6_addr get_sin6_addr() const noexcept                  { return Base::sock.sin6_addr; }
 };
 
 //===============================================================
 // Link-level implementation of methods
 #if __APPLE__ 
-template <bool shouldCopyBack>
-struct SocketImpl<NetworkAddress::Family::ethernet, shouldCopyBack> : SocketMethods<NetworkAddress::Family::ethernet, shouldCopyBack> {
-    using Base = SocketMethods<NetworkAddress::Family::ethernet, shouldCopyBack>;
+template <bool isMutable>
+struct SocketImpl<NetworkAddress::Family::ethernet, isMutable> : SocketAccessors<NetworkAddress::Family::ethernet, isMutable> {
+    using Base = SocketAccessors<NetworkAddress::Family::ethernet, isMutable>;
 
     SocketImpl(Base::RefType _storage) noexcept : Base(_storage) {}
 
@@ -281,31 +642,24 @@ struct SocketImpl<NetworkAddress::Family::ethernet, shouldCopyBack> : SocketMeth
         init(std::array<std::uint8_t, 6>{{o1, o2, o3, o4, o5, o6}}, protocol, intf);
     }
 
-    bool valid() const noexcept                                { return Base::sock.sdl_alen > 0; }
-    ::socklen_t socketLength() const                           { return sizeof(sockaddr_dl); }
-    bool isMulticast() const noexcept                          { typename Base::Type const& s = Base::sock; return (LLADDR(&s)[0] & 0x1) != 0; }
     void setInterface(NetworkInterface const& intf) noexcept   { Base::sock.sdl_index = intf.getIndex(); }
     std::optional<NetworkInterface> interface() const noexcept { return NetworkInterface::fromIntfIndex(Base::sock.sdl_index); }
-    bool isLinkLocal() const noexcept                          { return true; }
-    std::uint16_t protocol() const noexcept                    { return 0; }
-    void setProtocol(std::uint16_t) noexcept                   {}
-    std::string toString() const {
-        std::ostringstream ss;
+    std::to_chars_result toChars(char* first, char* last, FormatOptions const& options) const {
+        if (options.part == FormatOptions::Part::port) {
+            return {first, std::errc::invalid_argument};
+        }
 
+        char buffer[NetworkAddress::kMaxStringLength];
         typename Base::Type const& s = Base::sock;
-        auto const* mac = LLADDR(&s);
-
-        std::for_each(mac, mac + Base::sock.sdl_alen, [&ss] (char octet) {
-            ss << ':' << std::right << std::hex << std::uppercase << std::setfill('0') << std::setw(2) << static_cast<unsigned int>(static_cast<unsigned char>(octet));
-        });
-
-        return ss.str().empty() ? std::string() : ss.str().substr(1);
+        auto const len = std::min(static_cast<std::size_t>(Base::sock.sdl_alen), std::size_t(8));
+        auto const* digits = hexDigits(options.hexCase, kHexDigitsUpper);
+        return copyChars(first, last, buffer, writeMAC(buffer, reinterpret_cast<std::uint8_t const*>(LLADDR(&s)), len, digits));
     }
 };
 #elif __linux__
-template <bool shouldCopyBack>
-struct SocketImpl<NetworkAddress::Family::ethernet, shouldCopyBack> : SocketMethods<NetworkAddress::Family::ethernet, shouldCopyBack> {
-    using Base = SocketMethods<NetworkAddress::Family::ethernet, shouldCopyBack>;
+template <bool isMutable>
+struct SocketImpl<NetworkAddress::Family::ethernet, isMutable> : SocketAccessors<NetworkAddress::Family::ethernet, isMutable> {
+    using Base = SocketAccessors<NetworkAddress::Family::ethernet, isMutable>;
 
     SocketImpl(Base::RefType _storage) noexcept : Base(_storage) {}
 
@@ -323,79 +677,128 @@ struct SocketImpl<NetworkAddress::Family::ethernet, shouldCopyBack> : SocketMeth
         init(std::array<std::uint8_t, 6>{{o1, o2, o3, o4, o5, o6}}, protocol, intf);
     }
 
-    bool valid() const noexcept                                { return true; }
-    ::socklen_t socketLength() const                           { return sizeof(sockaddr_ll) - sizeof(std::declval<sockaddr_ll>().sll_addr) + Base::sock.sll_halen; }
-    bool isMulticast() const noexcept                          { return (Base::sock.sll_addr[0] & 0x1) != 0; }
     void setInterface(NetworkInterface const& intf) noexcept   { Base::sock.sll_ifindex = intf.getIndex(); }
     std::optional<NetworkInterface> interface() const noexcept { return NetworkInterface::fromIntfIndex(Base::sock.sll_ifindex); }
-    bool isLinkLocal() const noexcept                          { return true; }
-    std::uint16_t protocol() const noexcept                    { return cxxutils::byteswap(Base::sock.sll_protocol); }
-    void setProtocol(std::uint16_t p) noexcept                 { Base::sock.sll_protocol = cxxutils::byteswap(p); }
-    std::string toString() const {
-        std::ostringstream ss;
-
-        std::for_each(Base::sock.sll_addr, Base::sock.sll_addr + Base::sock.sll_halen, [&ss] (unsigned char octet) {
-            ss << ':' << std::right << std::hex << std::uppercase << std::setfill('0') << std::setw(2) << static_cast<unsigned int>(octet);
-        });
+    std::to_chars_result toChars(char* first, char* last, FormatOptions const& options) const {
+        if (options.part == FormatOptions::Part::port) {
+            return {first, std::errc::invalid_argument};
+        }
 
-        return ss.str().substr(1);
+        char buffer[NetworkAddress::kMaxStringLength];
+        auto const len = std::min(static_cast<std::size_t>(Base::sock.sll_halen), sizeof(Base::sock.sll_addr));
+        auto const* digits = hexDigits(options.hexCase, kHexDigitsUpper);
+        return copyChars(first, last, buffer, writeMAC(buffer, Base::sock.sll_addr, len, digits));
     }
 };
 #endif
 
 //===============================================================
 // unix socket implementation of methods
-template <bool shouldCopyBack>
-struct SocketImpl<NetworkAddress::Family::unixSocket, shouldCopyBack> : SocketMethods<NetworkAddress::Family::unixSocket, shouldCopyBack> {
-    using Base = SocketMethods<NetworkAddress::Family::unixSocket, shouldCopyBack>;
+template <bool isMutable>
+struct SocketImpl<NetworkAddress::Family::unixSocket, isMutable> : SocketAccessors<NetworkAddress::Family::unixSocket, isMutable> {
+    using Base = SocketAccessors<NetworkAddress::Family::unixSocket, isMutable>;
 
     SocketImpl(Base::RefType _storage) noexcept : Base(_storage) {}
 
-    void init(std::string const& path) noexcept {
-        static constexpr auto kMaxUnixPathLength = sizeof(::sockaddr_storage) - offsetof(::sockaddr_un, sun_path) - 1;
-        assert(path.size() <= kMaxUnixPathLength);
-        // see "man 7 unix" on length calculations here 
-        auto const len = std::min(path.size(), kMaxUnixPathLength);
-        std::memcpy(Base::sock.sun_path, path.substr(0, len).c_str(), len + 1);
+    // see "man 7 unix" on length calculations here: paths are terminated by
+    // a NUL (unless they fill sun_path), abstract names start with one and
+    // are delimited by the length. The stored length excludes the terminator.
+    bool init(std::string_view path, bool isAbstract) noexcept {
+        if (path.size() + 1 > sizeof(Base::sock.sun_path)) {
+            return false;
+        }
+
+        auto* dst = Base::sock.sun_path;
+
+        if (isAbstract) {
+            *dst++ = '\0';
+        }
+
+        std::memcpy(dst, path.data(), path.size());
+
+        if (! isAbstract) {
+            dst[path.size()] = '\0';
+        }
+
+        Base::storage.unixSocket.sunPathLength = static_cast<std::uint8_t>(isAbstract ? path.size() + 1 : path.size());
+        return true;
     }
 
-    bool valid() const                         { return true; }
+    // derives the length of a sockaddr_un copied from the sockets API,
+    // where len is unknown if it is the maximum value of socklen_t. The
+    // length of a path may include its NUL or not (as with SUN_LEN).
+    void initLength(::socklen_t len) noexcept {
+        static constexpr auto kPathOffset = offsetof(::sockaddr_un, sun_path);
+        auto const isLengthKnown = len != std::numeric_limits<::socklen_t>::max();
+        auto const max = std::min(len > kPathOffset ? len - kPathOffset : std::size_t(0), sizeof(Base::sock.sun_path));
+        auto const* path = Base::sock.sun_path;
+        std::size_t used = 0;
+
+        if (max > 0 && path[0] == '\0') {
+            used = isLengthKnown ? max : 1 + ::strnlen(path + 1, max - 1);
+        } else if (max > 0) {
+            used = ::strnlen(path, max);
+        }
 
-    ::socklen_t socketLength() const {
-        auto const len = offsetof(::sockaddr_un, sun_path) + ::strnlen(Base::sock.sun_path, sizeof(std::declval<::sockaddr_un>().sun_path)) + 1;
-        return static_cast<::socklen_t>(len);
+        Base::storage.unixSocket.sunPathLength = static_cast<std::uint8_t>(used);
     }
-    
-    std::string toString() const {
-        auto const len = strnlen(Base::sock.sun_path, sizeof(std::declval<::sockaddr_un>().sun_path));
-        return std::string(Base::sock.sun_path, Base::sock.sun_path + len);
+
+    NetworkInterface interface() const         { assertWrongFamilyType(); return {}; }
+    void setInterface(NetworkInterface const&) { assertWrongFamilyType(); }
+
+    std::to_chars_result toChars(char* first, char* last, FormatOptions const& options) const {
+        if (options.part == FormatOptions::Part::port) {
+            return {first, std::errc::invalid_argument};
+        }
+
+        auto const* path = Base::sock.sun_path;
+        auto const len = Base::sunPathLength();
+
+        if (! Base::isAbstract()) {
+            return copyChars(first, last, path, path + len);
+        }
+
+        // like ss and /proc/net/unix: the leading and any embedded NULs are shown as '@'
+        auto const result = copyChars(first, last, path, path + len);
+
+        if (result.ec == std::errc()) {
+            std::replace(first, result.ptr, '\0', '@');
+        }
+
+        return result;
     }
 };
 }
 
 //===============================================================
 // Glue-code invoking non type-erased methods
-NetworkAddress::NetworkAddress() : storage { .ss_family = AF_UNSPEC } {}
-NetworkAddress::NetworkAddress(::sa_family_t family) : storage { .ss_family = family } {}
-NetworkAddress::NetworkAddress(NetworkAddress const& o) { std::memcpy(&storage, &o.socket(), o.socketLength()); }
-NetworkAddress::NetworkAddress(NetworkAddress && o) { std::memcpy(&storage, &o.socket(), o.socketLength()); o.storage.ss_family = AF_UNSPEC; }
-NetworkAddress::NetworkAddress(::sockaddr const& other, ::socklen_t len) {
+NetworkAddress::NetworkAddress() : storage { .ss = { .ss_family = AF_UNSPEC } } {}
+NetworkAddress::NetworkAddress(::sa_family_t family) : storage { .ss = { .ss_family = family } } {}
+// copies are a fixed-size copy of the storage: cheaper than finding the
+// family's length and copies the state kept behind the socket address
+NetworkAddress::NetworkAddress(NetworkAddress const& o) : storage(o.storage) {}
+NetworkAddress::NetworkAddress(NetworkAddress && o) : storage(o.storage) { o.storage.ss.ss_family = AF_UNSPEC; }
+NetworkAddress::NetworkAddress(::sockaddr const& other, ::socklen_t len) : storage {} {
     static constexpr auto kUnspecifiedFamily = std::integral_constant<Family, Family::unspecified>();
     if (! cxxutils::constexpr_apply(unix2addr(other.sa_family), kUnspecifiedFamily, [this, len, &other] (auto f) {
         std::memcpy(&storage, &other, std::min(static_cast<std::size_t>(len), sizeof(typename decltype(family2type(f))::type)));
+
+        if constexpr (f == Family::unixSocket) {
+            SocketImpl<Family::unixSocket>(storage).initLength(len);
+        }
     })) {
         std::memcpy(&storage, &other, sizeof(::sockaddr));
     }
 }
 NetworkAddress::NetworkAddress(std::uint8_t o1, std::uint8_t o2, std::uint8_t o3, std::uint8_t o4,
-                               std::uint16_t port) : storage { .ss_family = AF_INET } {
+                               std::uint16_t port) : storage { .ss = { .ss_family = AF_INET } } {
     SocketImpl<NetworkAddress::Family::ipv4>(storage).init(o1, o2, o3, o4, port);
 }
-NetworkAddress::NetworkAddress(std::uint32_t saddr, std::uint16_t port) : storage { .ss_family = AF_INET } {
+NetworkAddress::NetworkAddress(std::uint32_t saddr, std::uint16_t port) : storage { .ss = { .ss_family = AF_INET } } {
     SocketImpl<NetworkAddress::Family::ipv4>(storage).init(cxxutils::byteswap(saddr), port);
 }
 #if __cplusplus >= 202002L
-NetworkAddress::NetworkAddress(std::span<std::uint8_t const, 4u> ipv4, std::uint16_t port) : storage { .ss_family = AF_INET } {
+NetworkAddress::NetworkAddress(std::span<std::uint8_t const, 4u> ipv4, std::uint16_t port) : storage { .ss = { .ss_family = AF_INET } } {
     SocketImpl<NetworkAddress::Family::ipv4>(storage).init(ipv4, port);
 }
 #endif
@@ -408,7 +811,7 @@ NetworkAddress::NetworkAddress(std::uint16_t w1, std::uint16_t w2, std::uint16_t
 NetworkAddress::NetworkAddress(std::uint16_t w1, std::uint16_t w2, std::uint16_t w3, std::uint16_t w4,
                                std::uint16_t w5, std::uint16_t w6, std::uint16_t w7, std::uint16_t w8,
                                std::uint16_t port, NetworkInterface const& intf)
-    : storage { .ss_family = AF_INET6 } {
+    : storage { .ss = { .ss_family = AF_INET6 } } {
     SocketImpl<NetworkAddress::Family::ipv6>(storage).init(w1, w2, w3, w4, w5, w6, w7, w8, port, intf);
 }
 
@@ -417,7 +820,7 @@ NetworkAddress::NetworkAddress(std::span<std::uint16_t const, 8u> ipv6, std::uin
     : NetworkAddress(ipv6, port, {})
 {}
 NetworkAddress::NetworkAddress(std::span<std::uint16_t const, 8u> ipv6, std::uint16_t port, NetworkInterface const& intf)
-    : storage { .ss_family = AF_INET6 } {
+    : storage { .ss = { .ss_family = AF_INET6 } } {
     SocketImpl<NetworkAddress::Family::ipv6>(storage).init(ipv6, port, intf);
 }
 #endif
@@ -430,7 +833,7 @@ NetworkAddress::NetworkAddress(std::uint8_t o1, std::uint8_t o2, std::uint8_t o3
 NetworkAddress::NetworkAddress(std::uint8_t o1, std::uint8_t o2, std::uint8_t o3,
                                std::uint8_t o4, std::uint8_t o5, std::uint8_t o6,
                                std::uint16_t protocol, NetworkInterface const& intf)
-    : storage { .ss_family = kFamilyLinkLevel } {
+    : storage { .ss = { .ss_family = kFamilyLinkLevel } } {
     SocketImpl<NetworkAddress::Family::ethernet>(storage).init(o1, o2, o3, o4, o5, o6, protocol, intf);
 }
 #if __cplusplus >= 202002L
@@ -438,39 +841,53 @@ NetworkAddress::NetworkAddress(std::span<std::uint8_t const, 6u> mac, std::uint1
     : NetworkAddress(mac, protocol, {})
 {}
 NetworkAddress::NetworkAddress(std::span<std::uint8_t const, 6u> mac, std::uint16_t protocol, NetworkInterface const& intf)
-    : storage { .ss_family = kFamilyLinkLevel } {
+    : storage { .ss = { .ss_family = kFamilyLinkLevel } } {
     SocketImpl<NetworkAddress::Family::ethernet>(storage).init(mac, protocol, intf);
 }
 #endif
 
-NetworkAddress::NetworkAddress(std::string const& path) : storage { .ss_family = AF_UNIX } {
-    SocketImpl<NetworkAddress::Family::unixSocket>(storage).init(path);
+NetworkAddress::NetworkAddress(std::string_view path, bool isAbstract) : storage { .ss = { .ss_family = AF_UNIX } } {
+    if (! SocketImpl<NetworkAddress::Family::unixSocket>(storage).init(path, isAbstract)) {
+        storage.ss.ss_family = AF_UNSPEC;
+    }
 }
 
 NetworkAddress& NetworkAddress::operator=(NetworkAddress && o) {
-    std::memcpy(&storage, &o.socket(), o.socketLength());
-    o.storage.ss_family = AF_UNSPEC;
+    storage = o.storage;
+    o.storage.ss.ss_family = AF_UNSPEC;
     return *this;
 }
 
 NetworkAddress& NetworkAddress::operator=(NetworkAddress const& o) {
-    std::memcpy(&storage, &o.socket(), o.socketLength());
+    storage = o.storage;
     return *this;
 }
 
 int NetworkAddress::cmp(NetworkAddress const& o) const {
-    auto const len1 = static_cast<int>(*sockcall(  storage, [] (auto s) { return s.socketLength(); }));
-    auto const len2 = static_cast<int>(*sockcall(o.storage, [] (auto s) { return s.socketLength(); }));
+    auto const f1 = family(), f2 = o.family();
+
+    if (f1 != f2) {
+        return compareValues(static_cast<int>(f1), static_cast<int>(f2));
+    }
+
+    return compareSameFamily(storage, o.storage);
+}
+
+bool NetworkAddress::operator==(NetworkAddress const& o) const {
+    if (storage.ss.ss_family != o.storage.ss.ss_family) {
+        return family() == Family::unspecified && o.family() == Family::unspecified;
+    }
 
-    if (len1 == len2) {
-        return std::memcmp(&storage, &o.storage, len1);
+    if (storage.ss.ss_family == AF_INET) {
+        return storage.in4.sin_addr.s_addr == o.storage.in4.sin_addr.s_addr && storage.in4.sin_port == o.storage.in4.sin_port;
     }
 
-    return len1 - len2;
+    return compareSameFamily(storage, o.storage) == 0;
 }
 
-bool NetworkAddress::operator==(NetworkAddress const& o) const { return cmp(o) == 0; }
-bool NetworkAddress::operator!=(NetworkAddress const& o) const { return cmp(o) != 0; }
+bool NetworkAddress::operator!=(NetworkAddress const& o) const { return ! (*this == o); }
+
+std::size_t NetworkAddress::hash() const noexcept { return static_cast<std::size_t>(hashSameFamily(storage)); }
 
 #if __cplusplus >= 202002L
 std::strong_ordering NetworkAddress::operator<=>(NetworkAddress const& o) const {
@@ -488,35 +905,83 @@ bool NetworkAddress::operator<=(NetworkAddress const& o) const { return cmp(o) <
 bool NetworkAddress::operator>=(NetworkAddress const& o) const { return cmp(o) >= 0; }
 #endif
 
-bool NetworkAddress::valid() const {
-    if (family() == Family::unspecified) {
-        return false;
-    }
+std::vector<NetworkAddress> NetworkAddress::fromIPv4Array(std::span<std::uint32_t const> saddrs,
+                                                          std::span<std::uint16_t const> ports) {
+    std::vector<NetworkAddress> result(saddrs.size(), NetworkAddress(static_cast<::sa_family_t>(AF_INET)));
+    fillIPv4Array(saddrs, ports, result);
+    return result;
+}
 
-    if (auto isvalid = sockcall(storage, [] (auto s) { return s.valid(); }); isvalid.has_value()) {
-        return *isvalid;
-    }
+std::pmr::vector<NetworkAddress> NetworkAddress::fromIPv4Array(std::pmr::memory_resource* resource,
+                                                               std::span<std::uint32_t const> saddrs,
+                                                               std::span<std::uint16_t const> ports) {
+    std::pmr::vector<NetworkAddress> result(saddrs.size(), NetworkAddress(static_cast<::sa_family_t>(AF_INET)), resource);
+    fillIPv4Array(saddrs, ports, result);
+    return result;
+}
+
+void NetworkAddress::fillIPv4Array(std::span<std::uint32_t const> saddrs, std::span<std::uint16_t const> ports,
+                                   std::span<NetworkAddress> result) noexcept {
+    assert(ports.empty() || ports.size() == saddrs.size());
+    static constexpr std::size_t kBlockSize = 64;
+    auto const hasPorts = ports.size() >= saddrs.size();
+
+    // convert to network byte order in blocks that stay in L1
+    for (std::size_t first = 0; first < saddrs.size(); first += kBlockSize) {
+        auto const n = std::min(kBlockSize, saddrs.size() - first);
+        std::array<std::uint32_t, kBlockSize> addrBlock;
+        std::array<std::uint16_t, kBlockSize> portBlock = {};
+
+        cxxutils::byteswapArray(saddrs.subspan(first, n), std::span<std::uint32_t>(addrBlock));
 
-    return false;
+        if (hasPorts) {
+            cxxutils::byteswapArray(ports.subspan(first, n), std::span<std::uint16_t>(portBlock));
+        }
+
+        for (std::size_t i = 0; i < n; ++i) {
+            auto& sock = result[first + i].storage.in4;
+            sock.sin_addr.s_addr = addrBlock[i];
+            sock.sin_port = portBlock[i];
+        }
+    }
 }
 
-::sa_family_t NetworkAddress::family2POSIX(Family family) noexcept                             { return addr2unix(family); }
-NetworkAddress::Family NetworkAddress::POSIX2Family(::sa_family_t family) noexcept             { return unix2addr(family); }
-NetworkAddress NetworkAddress::fromUNIXSocketPath(std::string const& path)                     { return NetworkAddress(path); }
+NetworkAddress NetworkAddress::fromUNIXSocketPath(std::string_view path)                        { return NetworkAddress(path, false); }
+#if __linux__
+NetworkAddress NetworkAddress::fromAbstractUNIXSocketName(std::string_view name)                { return NetworkAddress(name, true); }
+#endif
 NetworkAddress NetworkAddress::fromPOSIXSocketAddress(::sockaddr const& addr, ::socklen_t len) { return NetworkAddress(addr, len); }
 
-NetworkAddress::Family NetworkAddress::family() const             { return unix2addr(storage.ss_family); }
-sa_family_t NetworkAddress::posixFamily() const                   { return family() != Family::unspecified ? storage.ss_family : AF_UNSPEC; }
-std::string NetworkAddress::toString() const                      { return *sockcall(storage, [] (auto s) { return s.toString(); }); }
-::sockaddr const& NetworkAddress::socket() const                  { return *reinterpret_cast<::sockaddr const*>(&storage); }
-::socklen_t NetworkAddress::socketLength() const                  { return *sockcall(storage, [] (auto s) { return s.socketLength(); }); }
-bool NetworkAddress::isMulticast() const                          { return *sockcall(storage, [] (auto s) { return s.isMulticast(); }); }
 std::optional<NetworkInterface> NetworkAddress::interface() const { return  sockcall(storage, [] (auto s) { return s.interface(); }); }
-bool NetworkAddress::isLinkLocal() const                          { return *sockcall(storage, [] (auto s) { return s.isLinkLocal(); }); }
-std::uint16_t NetworkAddress::port() const                        { return *sockcall(storage, [] (auto s) { return s.port(); }); }
-std::uint16_t NetworkAddress::protocol() const                    { return *sockcall(storage, [] (auto s) { return s.protocol(); }); }
-struct ::in_addr NetworkAddress::get_sin_addr() const             { return *sockcall(storage, [] (auto s) { return s.get_sin_addr(); }); }
-struct ::in6_addr NetworkAddress::get_sin6_addr() const           { return *sockcall(storage, [] (auto s) { return s.get_sin6_addr(); }); }
+
+std::string NetworkAddress::toString() const {
+    char buffer[kMaxStringLength];
+    auto const [end, ec] = toChars(buffer, buffer + sizeof(buffer));
+    return ec == std::errc() ? std::string(buffer, end) : std::string();
+}
+
+std::pmr::string NetworkAddress::toString(std::pmr::memory_resource* resource) const {
+    char buffer[kMaxStringLength];
+    auto const [end, ec] = toChars(buffer, buffer + sizeof(buffer));
+    return ec == std::errc() ? std::pmr::string(buffer, end, resource) : std::pmr::string(resource);
+}
+
+std::to_chars_result NetworkAddress::toChars(char* first, char* last) const {
+    return toChars(first, last, FormatOptions());
+}
+
+std::to_chars_result NetworkAddress::toChars(char* first, char* last, FormatOptions const& options) const {
+    instrumentation::ApiScope apiScope(instrumentation::Api::addressToChars);
+    instrumentation::ProbeTimer probe(CXXNETADDR_PROBE_ENABLED(format));
+
+    auto const result = sockcall(storage, [first, last, &options] (auto s) { return s.toChars(first, last, options); });
+
+    if (probe.active()) {
+        CXXNETADDR_PROBE(format, storage.ss.ss_family, scopeId(storage), probe.elapsed());
+    }
+
+    return result ? *result : std::to_chars_result{first, std::errc::invalid_argument};
+}
 
 NetworkAddress NetworkAddress::withInterface(NetworkInterface const& intf) const { 
     NetworkAddress result(*this);
@@ -539,102 +1004,104 @@ NetworkAddress NetworkAddress::withProtocol(std::uint16_t protocol) const {
     return result;
 }
     
-std::optional<NetworkAddress> NetworkAddress::fromIPString(std::string const& ipString,
+std::optional<NetworkAddress> NetworkAddress::fromIPString(std::string_view ipString,
                                                            std::uint16_t defaultPort,
                                                            bool parsePortInString) {
-    auto const parts = std::invoke([&ipString] () -> std::array<std::string, 2> {
-        auto const result = std::invoke([&ipString] () -> std::array<std::string, 2> {
-            auto const firstloc = ipString.find(':');
-            auto const lastloc = ipString.rfind(':');
-            auto const bracket = ipString.rfind(']');
-
-            if (lastloc == std::string::npos || ((firstloc != lastloc) && ((bracket == std::string::npos) || (bracket > lastloc)))) {
-                return {{ipString, {}}};
-            }
+    instrumentation::ApiScope apiScope(instrumentation::Api::addressFromIPString);
+    instrumentation::ProbeTimer probe(CXXNETADDR_PROBE_ENABLED(parse));
 
-            auto ipPart = ipString.substr(0, lastloc);
-            auto portPort = ipString.substr(lastloc + 1);
+    auto result = parseIPString(ipString, defaultPort, parsePortInString);
 
-            return  {{ipPart, portPort}};
-        });
-
-        if (result[0].front() == '[' && result[0].back() == ']') {
-            return  {{result[0].substr(1, result[0].size() - 2), result[1]}};
-        }
+    if (probe.active()) {
+        CXXNETADDR_PROBE(parse, result ? result->storage.ss.ss_family : AF_UNSPEC, result ? scopeId(result->storage) : 0, probe.elapsed());
+    }
 
-        return result;
-    });
+    return result;
+}
 
-    ::addrinfo hints = {};
-    
-    hints.ai_flags = AI_NUMERICSERV | AI_NUMERICHOST;
-    auto const portString = parsePortInString && (! parts[1].empty()) ? parts[1] : std::to_string(defaultPort);
+std::optional<NetworkAddress> NetworkAddress::parseIPString(std::string_view ipString,
+                                                            std::uint16_t defaultPort,
+                                                            bool parsePortInString) {
+    auto [host, portString] = std::invoke([ipString] () -> std::array<std::string_view, 2> {
+        auto const firstloc = ipString.find(':');
+        auto const lastloc = ipString.rfind(':');
+        auto const bracket = ipString.rfind(']');
 
-    std::unique_ptr<addrinfo, void (*)(addrinfo*)> ainfo(std::invoke([&] () -> addrinfo* 
-    {
-        addrinfo* r = nullptr;
-        auto retval = ::getaddrinfo(parts[0].c_str(), portString.c_str(), &hints, &r);
-        if (retval != 0) {
-            return nullptr;
+        if (lastloc == std::string_view::npos || ((firstloc != lastloc) && ((bracket == std::string_view::npos) || (bracket > lastloc)))) {
+            return {{ipString, {}}};
         }
 
-        return r;
-    }), freeaddrinfo);
+        return {{ipString.substr(0, lastloc), ipString.substr(lastloc + 1)}};
+    });
 
-    if (ainfo == nullptr) {
-        return {};
+    if (host.size() >= 2 && host.front() == '[' && host.back() == ']') {
+        host = host.substr(1, host.size() - 2);
     }
 
-    NetworkAddress result;
-    std::memcpy(&result.storage, ainfo->ai_addr, ainfo->ai_addrlen);
+    auto port = defaultPort;
 
-    return result;
-}
+    if (parsePortInString && (! portString.empty())) {
+        if (auto const p = parseDecimal(portString, 0xffff); p) {
+            port = static_cast<std::uint16_t>(*p);
+        } else {
+            return {};
+        }
+    }
+
+    if (std::array<std::uint8_t, 4> octets; parseIPv4(host, octets.data())) {
+        return NetworkAddress(std::span<std::uint8_t const, 4>(octets), port);
+    }
 
-std::optional<NetworkAddress> NetworkAddress::fromMACString(std::string const& macString) {
-    auto const parts = std::invoke([&macString] () {
-        std::istringstream ss(macString);
-        std::vector<std::string> result;
+    std::uint32_t scope = 0;
 
-        for (std::string s; std::getline(ss, s, ':');) {
-            result.emplace_back(s);
+    if (auto const percent = host.find('%'); percent != std::string_view::npos) {
+        if (auto const s = parseScope(host.substr(percent + 1)); s) {
+            scope = *s;
+        } else {
+            return {};
         }
 
-        return result;
-    });
+        host = host.substr(0, percent);
+    }
 
-    static constexpr std::size_t kEthernetMACLen = 6;
+    ::sockaddr_in6 sin6 = {};
 
-    if (parts.size() != kEthernetMACLen) {
+    if (! parseIPv6(host, sin6.sin6_addr.s6_addr)) {
         return {};
     }
 
+    sin6.sin6_family = AF_INET6;
+    sin6.sin6_port = cxxutils::byteswap(port);
+    sin6.sin6_scope_id = scope;
 
-    std::array<std::uint8_t, kEthernetMACLen> mac;
-    for (std::size_t i = 0; i < kEthernetMACLen; ++i) {
-        auto const& part = parts[i];
-
-        if (part.empty() || part.size() > 2) {
-            return {};
-        }
-
-        auto const num = std::invoke([&part] () -> std::optional<int> {
-            std::istringstream ss(part);
-            int result;
+    return NetworkAddress(reinterpret_cast<::sockaddr const&>(sin6), sizeof(sin6));
+}
 
-            if (ss >> std::hex >> result) {
-                return result;
-            }
-            
-            return {};
-        });
+std::optional<NetworkAddress> NetworkAddress::fromMACString(std::string_view macString) {
+    instrumentation::ApiScope apiScope(instrumentation::Api::addressFromMACString);
+    static constexpr std::size_t kEthernetMACLen = 6;
 
-        if ((! num) || *num < 0 || *num > 255) {
+    std::array<std::uint8_t, kEthernetMACLen> mac;
+    std::size_t octet = 0, digits = 0;
+    unsigned value = 0;
+
+    for (auto c : macString) {
+        if (auto const h = hexValue(c); h >= 0 && digits < 2) {
+            value = (value << 4) | static_cast<unsigned>(h);
+            ++digits;
+        } else if (c == ':' && digits != 0 && octet + 1 < kEthernetMACLen) {
+            mac[octet++] = static_cast<std::uint8_t>(value);
+            value = 0;
+            digits = 0;
+        } else {
             return {};
         }
+    }
 
-        mac[i] = static_cast<std::uint8_t>(*num);
+    if (digits == 0 || octet + 1 != kEthernetMACLen) {
+        return {};
     }
 
+    mac[octet] = static_cast<std::uint8_t>(value);
     return NetworkAddress(mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
 }
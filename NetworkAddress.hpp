@@ -10,21 +10,117 @@
 //  14467 Potsdam, Germany
 //
 #pragma once
+#include <charconv>
 #include <cstdint>
+#include <functional>
+#include <memory>
+#include <memory_resource>
 #include <string>
+#include <string_view>
+#if defined(__has_include) && __has_include(<format>)
+ #include <format>
+#endif
 #include <optional>
 #include <numeric>
+#include <type_traits>
 
 #if __cplusplus >= 202002L
 #include <span>
+#include <vector>
 #include <compare>
 #endif
 
 #include <sys/socket.h>
+#include <sys/un.h>
 #include <netinet/ip.h>
 
+#if __APPLE__
+ #include <net/if_dl.h>
+#elif __linux__
+ #include <linux/if_packet.h>
+#endif
+
 class NetworkInterface;
 
+namespace cxxnetaddr::detail
+{
+/**
+ * The storage of a NetworkAddress with direct, typed access to each kind
+ * of socket address. All of them start with the family field and, like
+ * the sockets API itself, the library relies on the compiler's guarantee
+ * (GCC, Clang) that union members may be read after writing another one.
+ */
+union SocketStorage
+{
+    ::sockaddr_storage ss;
+    ::sockaddr         sa;
+    ::sockaddr_in      in4;
+    ::sockaddr_in6     in6;
+    ::sockaddr_un      un;
+   #if __APPLE__
+    ::sockaddr_dl      ll;
+   #elif __linux__
+    ::sockaddr_ll      ll;
+   #endif
+
+    // UNIX socket addresses keep the number of bytes used in sun_path (for
+    // paths without the terminating NUL) behind the sockaddr_un, so that
+    // their length is known without a scan
+    struct { ::sockaddr_un sock; std::uint8_t sunPathLength; } unixSocket;
+};
+
+static_assert(sizeof(SocketStorage) == sizeof(::sockaddr_storage));
+static_assert(sizeof(::sockaddr_un::sun_path) <= UINT8_MAX);
+
+/**
+ * A reference to a callable visiting values of type T, so that templates
+ * accepting any callable can pass it on to an enumeration compiled into
+ * the library. The callable may be const and may return void or a bool;
+ * returning false asks the enumeration to stop.
+ */
+template <typename T>
+class VisitorRef
+{
+public:
+    template <typename Fn, typename = std::enable_if_t<! std::is_same_v<std::remove_cv_t<Fn>, VisitorRef>>>
+    VisitorRef(Fn& fn) noexcept
+        : context(const_cast<void*>(static_cast<void const*>(std::addressof(fn)))), trampoline(&invoke<Fn>) {}
+
+    /** Calls the visitor and returns false if it asks to stop. */
+    bool operator()(T const& value) const { return trampoline(context, value); }
+
+private:
+    // casts the context back to the callable's actual, possibly const, type
+    template <typename Fn>
+    static bool invoke(void* ctx, T const& value) {
+        auto& fn = *static_cast<Fn*>(ctx);
+
+        if constexpr (std::is_void_v<std::invoke_result_t<Fn&, T const&>>) {
+            fn(value);
+            return true;
+        } else {
+            return static_cast<bool>(fn(value));
+        }
+    }
+
+    void* context;
+    bool (*trampoline)(void*, T const&);
+};
+}
+
+// With CXXNETADDR_INLINE the trivial accessors (family(), port(), socket(),
+// valid(), ...) are defined in NetworkAddressImpl.hpp and can be inlined
+// into the caller without link-time optimisation.
+#ifndef CXXNETADDR_INLINE
+ #define CXXNETADDR_INLINE 0
+#endif
+
+#if CXXNETADDR_INLINE
+ #define CXXNETADDR_INLINE_API inline
+#else
+ #define CXXNETADDR_INLINE_API
+#endif
+
 /**
  * @class NetworkAddress
  * @brief Represents a network address (IPv4, IPv6, MAC, or UNIX socket).
@@ -53,12 +149,12 @@ public:
     /**
      * @brief Convert family to a POSIX sa_family_t
      */
-    static ::sa_family_t family2POSIX(Family family) noexcept;
+    CXXNETADDR_INLINE_API static ::sa_family_t family2POSIX(Family family) noexcept;
 
     /**
      * @brief Convert family to a POSIX sa_family_t
      */
-    static Family POSIX2Family(::sa_family_t family) noexcept;
+    CXXNETADDR_INLINE_API static Family POSIX2Family(::sa_family_t family) noexcept;
 
     //===============================================================
     /**
@@ -89,6 +185,35 @@ public:
      */
     NetworkAddress(std::uint32_t saddr, std::uint16_t port = 0);
 
+    /**
+     * @brief Constructs IPv4 addresses from arrays of 32-bit integers and ports.
+     *
+     * Equivalent to constructing each address with NetworkAddress(saddr, port)
+     * but converts the byte order of whole blocks with SIMD instructions.
+     *
+     * @param saddrs The IPv4 addresses as 32-bit integers in host byte order.
+     * @param ports The port of each address, or empty for port zero. Must otherwise
+     *              have the same size as saddrs.
+     * @return A vector with one address per element of saddrs.
+     */
+    static std::vector<NetworkAddress> fromIPv4Array(std::span<std::uint32_t const> saddrs,
+                                                     std::span<std::uint16_t const> ports = {});
+
+    /**
+     * @brief Constructs IPv4 addresses from arrays of 32-bit integers and ports.
+     *
+     * Same as fromIPv4Array(saddrs, ports) but the vector is allocated from
+     * a memory resource.
+     *
+     * @param resource The memory resource to allocate the vector from.
+     * @param saddrs The IPv4 addresses as 32-bit integers in host byte order.
+     * @param ports The port of each address, or empty for port zero.
+     * @return A vector with one address per element of saddrs.
+     */
+    static std::pmr::vector<NetworkAddress> fromIPv4Array(std::pmr::memory_resource* resource,
+                                                          std::span<std::uint32_t const> saddrs,
+                                                          std::span<std::uint16_t const> ports = {});
+
 #if __cplusplus >= 202002L
     /**
      * @brief Constructs an IPv4 address from a span of octets.
@@ -186,9 +311,26 @@ public:
      * @brief Constructs a UNIX socket address from a file path.
      *
      * @param path The UNIX socket file path.
-     * @return A NetworkAddress representing the UNIX socket.
+     * @return A NetworkAddress representing the UNIX socket or an invalid
+     *         address if the path (with its terminating NUL) does not fit
+     *         into sun_path.
      */
-    static NetworkAddress fromUNIXSocketPath(std::string const& path);
+    static NetworkAddress fromUNIXSocketPath(std::string_view path);
+
+#if __linux__
+    /**
+     * @brief Constructs a UNIX socket address in Linux' abstract namespace.
+     *
+     * Abstract addresses are not bound to the file system. The name is
+     * delimited by its length and may contain any bytes; toString() shows
+     * it with a leading '@'.
+     *
+     * @param name The name without the leading NUL.
+     * @return A NetworkAddress representing the UNIX socket or an invalid
+     *         address if the name does not fit into sun_path.
+     */
+    static NetworkAddress fromAbstractUNIXSocketName(std::string_view name);
+#endif
 
     //===============================================================
     /** Methods applicable to all address types */
@@ -208,21 +350,21 @@ public:
      *
      * @return True if valid, false otherwise.
      */
-    bool valid() const;
+    CXXNETADDR_INLINE_API bool valid() const;
 
     /**
      * @brief Gets the address family of the NetworkAddress.
      *
      * @return The address family.
      */
-    Family family() const;
+    CXXNETADDR_INLINE_API Family family() const;
 
     /**
      * @brief Gets the address' posix family
      *  
      * @return The an sa_family_t representing the address family. 
      */
-    sa_family_t posixFamily() const;
+    CXXNETADDR_INLINE_API sa_family_t posixFamily() const;
 
     /**
      * @brief Converts the NetworkAddress to a string representation.
@@ -231,19 +373,106 @@ public:
      */
     std::string toString() const;
 
+    /**
+     * @brief Converts the NetworkAddress to a string representation.
+     *
+     * @param resource The memory resource to allocate the string from.
+     * @return The string representation of the address.
+     */
+    std::pmr::string toString(std::pmr::memory_resource* resource) const;
+
+    /** The maximum number of characters written by toChars(). */
+    static constexpr std::size_t kMaxStringLength = 128;
+
+    /**
+     * @brief Writes the string representation of the address into a buffer.
+     *
+     * Same output as toString() but without allocating. The output is not
+     * null-terminated. A buffer of kMaxStringLength characters is always
+     * large enough.
+     *
+     * @param first The start of the buffer.
+     * @param last The end of the buffer.
+     * @return The end of the written characters, or last and
+     *         std::errc::value_too_large if the buffer is too small.
+     */
+    std::to_chars_result toChars(char* first, char* last) const;
+
+    /**
+     * @struct FormatOptions
+     * @brief Options for toChars() and std::format.
+     */
+    struct FormatOptions
+    {
+        /** The parts of an address to write. */
+        enum class Part { all, address, port };
+
+        /** The case of hex digits: standard is lower case for IPv6 and upper case for MACs. */
+        enum class Case { standard, lower, upper };
+
+        Part part = Part::all;
+        Case hexCase = Case::standard;
+
+        /** Write IPv6 addresses as eight groups of four digits, without compression. */
+        bool expandIPv6 = false;
+
+        /**
+         * @brief Parses a format spec as used in std::format, e.g. the "af" of "{:af}".
+         *
+         * - 'a': the address only, i.e. no port and no brackets
+         * - 'p': the port only (IP addresses only)
+         * - 'u'/'l': upper/lower case hex digits
+         * - 'f': fully expanded IPv6 addresses
+         *
+         * @param first The start of the spec.
+         * @param last The end of the format string.
+         * @param options The options to set.
+         * @return The end of the spec (the closing brace or last), or nullptr if the
+         *         spec is invalid.
+         */
+        static constexpr char const* parse(char const* first, char const* last, FormatOptions& options) noexcept {
+            for (; first != last && *first != '}'; ++first) {
+                switch (*first) {
+                case 'a': options.part = Part::address; break;
+                case 'p': options.part = Part::port;    break;
+                case 'u': options.hexCase = Case::upper; break;
+                case 'l': options.hexCase = Case::lower; break;
+                case 'f': options.expandIPv6 = true;    break;
+                default: return nullptr;
+                }
+            }
+
+            return first;
+        }
+    };
+
+    /**
+     * @brief Writes parts of the address into a buffer, formatted with options.
+     *
+     * toChars(first, last) is the same as calling this with default options.
+     *
+     * @param first The start of the buffer.
+     * @param last The end of the buffer.
+     * @param options The parts to write and how.
+     * @return The end of the written characters, or last and std::errc::value_too_large
+     *         if the buffer is too small, or std::errc::invalid_argument if the address
+     *         is unspecified or has no port but only the port is requested.
+     */
+    std::to_chars_result toChars(char* first, char* last, FormatOptions const& options) const;
+
     /**
      * @brief Gets a const reference to the underlying sockaddr.
      *
      * @return A const reference to the sockaddr.
      */
-    ::sockaddr const& socket() const;
+    CXXNETADDR_INLINE_API ::sockaddr const& socket() const;
 
     /**
      * @brief Gets the length of the underlying sockaddr.
      *
      * @return The length of the sockaddr structure.
      */
-    ::socklen_t socketLength() const;
+    CXXNETADDR_INLINE_API ::socklen_t socketLength() const;
 
     //===============================================================
     /** Methods applicable to IP and MAC addresses */
@@ -253,7 +482,7 @@ public:
      *
      * @return True if multicast, false otherwise.
      */
-    bool isMulticast() const;
+    CXXNETADDR_INLINE_API bool isMulticast() const;
 
     /**
      * @brief Gets the associated network interface.
@@ -277,7 +506,7 @@ public:
      *
      * @return True if link-local, false otherwise.
      */
-    bool isLinkLocal() const;
+    CXXNETADDR_INLINE_API bool isLinkLocal() const;
 
     //===============================================================
     /** Methods applicable to IP addresses */
@@ -292,7 +521,7 @@ public:
      * @param parsePortInString Whether to parse the port from the string.
      * @return An optional NetworkAddress.
      */
-    static std::optional<NetworkAddress> fromIPString(std::string const& ipString,
+    static std::optional<NetworkAddress> fromIPString(std::string_view ipString,
                                                       std::uint16_t defaultPort = 0,
                                                       bool parsePortInString = true);
 
@@ -301,7 +530,7 @@ public:
      *
      * @return The port number.
      */
-    std::uint16_t port() const;
+    CXXNETADDR_INLINE_API std::uint16_t port() const;
 
     /**
      * @brief Creates a new NetworkAddress with the specified port.
@@ -318,7 +547,7 @@ public:
      * @brief Gets the sin_addr field of sockaddr_in
      * @return The sin_addr field of sockaddr_in
      */
-    struct ::in_addr get_sin_addr() const;
+    CXXNETADDR_INLINE_API struct ::in_addr get_sin_addr() const;
 
     //===============================================================
     /** Methods applicable to IPv6 addresses */
@@ -327,7 +556,7 @@ public:
      * @brief Gets the sin6_addr field of sockaddr_in6
      * @return The sin6_addr field of sockaddr_in6
      */
-    struct ::in6_addr get_sin6_addr() const;
+    CXXNETADDR_INLINE_API struct ::in6_addr get_sin6_addr() const;
 
     //===============================================================
     /** Methods applicable to MAC addresses */
@@ -338,14 +567,14 @@ public:
      * @param macString The MAC address string.
      * @return An optional NetworkAddress.
      */
-    static std::optional<NetworkAddress> fromMACString(std::string const& macString);
+    static std::optional<NetworkAddress> fromMACString(std::string_view macString);
 
     /**
      * @brief Gets the protocol identifier.
      *
      * @return The protocol identifier.
      */
-    std::uint16_t protocol() const;
+    CXXNETADDR_INLINE_API std::uint16_t protocol() const;
 
     /**
      * @brief Creates a new NetworkAddress with the specified protocol.
@@ -361,9 +590,33 @@ public:
     NetworkAddress& operator=(NetworkAddress&&);
     NetworkAddress& operator=(NetworkAddress const&);
 
+    /**
+     * @brief Hashes the fields compared by operator==.
+     *
+     * Equal addresses have equal hashes. Also available as std::hash<NetworkAddress>.
+     */
+    std::size_t hash() const noexcept;
+
+    /**
+     * @brief Compares the meaningful fields of two addresses.
+     *
+     * Padding and fields that do not identify an endpoint (e.g. sin_zero
+     * and the IPv6 flow info) are ignored. All addresses of an unspecified
+     * family compare equal.
+     */
     bool operator==(NetworkAddress const& other) const;
     bool operator!=(NetworkAddress const& other) const;
 #if __cplusplus >= 202002L
+    /**
+     * @brief Orders addresses by family and then by their fields.
+     *
+     * Families are ordered as in the Family enum (unspecified last). Within
+     * a family the order is stable across platforms and runs:
+     * - ipv4: address, then port (both numerically)
+     * - ipv6: address (numerically), then scope id, then port
+     * - ethernet: address length, address bytes, interface index, then protocol
+     * - unixSocket: abstract names before paths, then lexicographically
+     */
     std::strong_ordering operator<=>(NetworkAddress const&) const;
 #else
     bool operator< (NetworkAddress const& other) const;
@@ -373,9 +626,56 @@ public:
 #endif
 
 private:
+    friend class AddressRange;
+    friend struct CompactAddress;
+
     NetworkAddress(::sockaddr const& addr, ::socklen_t len);
     NetworkAddress(::sa_family_t family);
-    NetworkAddress(std::string const& path);
+    NetworkAddress(std::string_view path, bool isAbstract);
     int cmp(NetworkAddress const& other) const;
-    ::sockaddr_storage storage;
+    static std::optional<NetworkAddress> parseIPString(std::string_view, std::uint16_t, bool);
+    static void fillIPv4Array(std::span<std::uint32_t const>, std::span<std::uint16_t const>, std::span<NetworkAddress>) noexcept;
+    cxxnetaddr::detail::SocketStorage storage;
+};
+
+template <>
+struct std::hash<NetworkAddress>
+{
+    std::size_t operator()(NetworkAddress const& addr) const noexcept { return addr.hash(); }
+};
+
+#if defined(__cpp_lib_format)
+/**
+ * Formats addresses without an intermediate string: std::format("{}", addr)
+ * gives the same text as addr.toString(). See NetworkAddress::FormatOptions
+ * for the supported format specs, e.g. "{:a}" for the address without port.
+ */
+template <>
+struct std::formatter<NetworkAddress>
+{
+    constexpr auto parse(std::format_parse_context& ctx) {
+        auto const* end = NetworkAddress::FormatOptions::parse(std::to_address(ctx.begin()), std::to_address(ctx.end()), options);
+
+        if (end == nullptr) {
+            throw std::format_error("invalid format spec for NetworkAddress");
+        }
+
+        return ctx.begin() + (end - std::to_address(ctx.begin()));
+    }
+
+    template <typename FormatContext>
+    auto format(NetworkAddress const& addr, FormatContext& ctx) const {
+        char buffer[NetworkAddress::kMaxStringLength];
+        auto const [end, ec] = addr.toChars(buffer, buffer + sizeof(buffer), options);
+
+        // like toString(): nothing for addresses without text
+        return std::copy(buffer, ec == std::errc() ? end : buffer, ctx.out());
+    }
+
+    NetworkAddress::FormatOptions options;
 };
+#endif
+
+#if CXXNETADDR_INLINE
+ #include "NetworkAddressImpl.hpp"
+#endif
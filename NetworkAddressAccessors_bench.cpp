@@ -0,0 +1,83 @@
+//
+//  NetworkAddressAccessors_bench.cpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+//  Built twice: as cxxnetaddr_accessor_bench against the library as
+//  configured and as cxxnetaddr_accessor_bench_inline with CXXNETADDR_INLINE,
+//  to compare the per-call overhead of the trivial accessors.
+//
+#include <benchmark/benchmark.h>
+#include <vector>
+
+#include "NetworkAddress.hpp"
+
+namespace
+{
+std::vector<NetworkAddress> const& addresses() {
+    static auto const result = [] {
+        std::vector<NetworkAddress> addrs;
+
+        for (std::uint16_t i = 0; i < 1024; ++i) {
+            if ((i & 1) == 0) {
+                addrs.emplace_back(10, 0, static_cast<std::uint8_t>(i >> 8), static_cast<std::uint8_t>(i), i);
+            } else {
+                addrs.emplace_back(0x2001, 0xdb8, 0, 0, 0, 0, 0, i, i);
+            }
+        }
+
+        return addrs;
+    }();
+
+    return result;
+}
+
+template <typename Fn>
+void runOverAddresses(benchmark::State& state, Fn && fn) {
+    auto const& addrs = addresses();
+    state.SetLabel(CXXNETADDR_INLINE ? "inline" : "out-of-line");
+
+    for (auto _ : state) {
+        std::uint64_t sum = 0;
+
+        for (auto const& addr : addrs) {
+            sum += fn(addr);
+        }
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(addrs.size()));
+}
+}
+
+//===============================================================
+static void BM_AccessorFamily(benchmark::State& state) {
+    runOverAddresses(state, [] (NetworkAddress const& addr) { return static_cast<std::uint64_t>(addr.family()); });
+}
+BENCHMARK(BM_AccessorFamily);
+
+static void BM_AccessorPosixFamily(benchmark::State& state) {
+    runOverAddresses(state, [] (NetworkAddress const& addr) { return static_cast<std::uint64_t>(addr.posixFamily()); });
+}
+BENCHMARK(BM_AccessorPosixFamily);
+
+static void BM_AccessorPort(benchmark::State& state) {
+    runOverAddresses(state, [] (NetworkAddress const& addr) { return static_cast<std::uint64_t>(addr.port()); });
+}
+BENCHMARK(BM_AccessorPort);
+
+static void BM_AccessorSocket(benchmark::State& state) {
+    runOverAddresses(state, [] (NetworkAddress const& addr) { return static_cast<std::uint64_t>(addr.socket().sa_family) + addr.socketLength(); });
+}
+BENCHMARK(BM_AccessorSocket);
+
+static void BM_AccessorValid(benchmark::State& state) {
+    runOverAddresses(state, [] (NetworkAddress const& addr) { return static_cast<std::uint64_t>(addr.valid()); });
+}
+BENCHMARK(BM_AccessorValid);
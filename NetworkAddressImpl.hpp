@@ -0,0 +1,274 @@
+//
+//  NetworkAddressImpl.hpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+//  Implementation header: the machinery dispatching on a NetworkAddress'
+//  family and the definitions of its trivial accessors. Only included by
+//  NetworkAddress.cpp and - in CXXNETADDR_INLINE mode - by NetworkAddress.hpp
+//  so that the accessors can be inlined into the caller.
+//
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#include <netinet/in.h>
+
+#if __APPLE__
+ #include <net/if_types.h>
+#endif
+
+#include "CxxUtilities.hpp"
+#include "NetworkAddress.hpp"
+
+namespace cxxnetaddr::detail
+{
+#if __APPLE__
+inline constexpr ::sa_family_t kFamilyLinkLevel = AF_LINK;
+#elif __linux__
+inline constexpr ::sa_family_t kFamilyLinkLevel = AF_PACKET;
+#endif
+
+//===============================================================
+// Convert between our family enum and UNIX's sa_family_t
+constexpr NetworkAddress::Family unix2addr(::sa_family_t family) noexcept {
+    switch (family) {
+    case AF_UNIX:          return NetworkAddress::Family::unixSocket;
+    case kFamilyLinkLevel: return NetworkAddress::Family::ethernet;
+    case AF_INET:          return NetworkAddress::Family::ipv4;
+    case AF_INET6:         return NetworkAddress::Family::ipv6;
+    default: break;
+    }
+
+    return NetworkAddress::Family::unspecified;
+}
+
+constexpr ::sa_family_t addr2unix(NetworkAddress::Family family) noexcept {
+    switch (family) {
+    case NetworkAddress::Family::unixSocket: return AF_UNIX;
+    case NetworkAddress::Family::ethernet:   return kFamilyLinkLevel;
+    case NetworkAddress::Family::ipv4:       return AF_INET;
+    case NetworkAddress::Family::ipv6:       return AF_INET6;
+    default: break;
+    }
+
+    return AF_UNSPEC;
+}
+
+template <NetworkAddress::Family family>
+constexpr auto family2type(std::integral_constant<NetworkAddress::Family, family>) {
+    if constexpr (family == NetworkAddress::Family::unixSocket) return std::type_identity<sockaddr_un> ();
+   #if __APPLE__
+    if constexpr (family == NetworkAddress::Family::ethernet)   return std::type_identity<sockaddr_dl> ();
+   #elif __linux__
+    if constexpr (family == NetworkAddress::Family::ethernet)   return std::type_identity<sockaddr_ll> ();
+   #endif
+    if constexpr (family == NetworkAddress::Family::ipv4)       return std::type_identity<sockaddr_in> ();
+    if constexpr (family == NetworkAddress::Family::ipv6)       return std::type_identity<sockaddr_in6>();
+}
+
+inline void assertWrongFamilyType() {
+    // You are trying to use a NetworkAddress method that
+    // is not supported by the your NetworkAddress' family type
+    assert(false);
+}
+
+//===============================================================
+// Calls lambda with an Impl<family> wrapping the storage, where Impl is
+// SocketAccessors here and the full SocketImpl in NetworkAddress.cpp
+template <template <NetworkAddress::Family, bool> class Impl, typename S, typename Lambda>
+auto sockcall(S& s, Lambda && lambda) {
+    static constexpr auto kMaxEnumValue = std::integral_constant<NetworkAddress::Family, NetworkAddress::Family::unspecified>();
+    static constexpr auto kIsConstCall = std::is_const_v<std::remove_reference_t<S>>;
+
+    return cxxutils::constexpr_apply(unix2addr(s.ss.ss_family), kMaxEnumValue, [_lambda = std::move(lambda), &s] (auto f) {
+        return _lambda(Impl<decltype(f)::value, ! kIsConstCall>(s));
+    });
+}
+
+//===============================================================
+// The member of the storage union for a family
+template <NetworkAddress::Family family, typename S>
+constexpr auto& typedSocket(S& s) noexcept {
+    if constexpr (family == NetworkAddress::Family::unixSocket) return (s.un);
+    if constexpr (family == NetworkAddress::Family::ethernet)   return (s.ll);
+    if constexpr (family == NetworkAddress::Family::ipv4)       return (s.in4);
+    if constexpr (family == NetworkAddress::Family::ipv6)       return (s.in6);
+}
+
+//===============================================================
+// Typed access to the storage: sock refers directly to the storage's
+// member for the family, so reads are plain loads and writes plain
+// stores - no copies, whether or not the calls are inlined.
+template <NetworkAddress::Family family, bool isMutable>
+struct SocketMethods {
+    using Type = decltype(family2type(std::integral_constant<NetworkAddress::Family, family>()))::type;
+    using RefType = std::conditional_t<isMutable, SocketStorage&, SocketStorage const&>;
+
+    SocketMethods(RefType _storage) noexcept : storage(_storage), sock(typedSocket<family>(_storage)) {
+        assert(storage.ss.ss_family == addr2unix(family));
+    }
+
+    bool valid() const                         { return false; }
+    bool isMulticast() const                   { assertWrongFamilyType(); return false; }
+    bool isLinkLocal() const                   { assertWrongFamilyType(); return false; }
+    std::uint16_t port() const                 { assertWrongFamilyType(); return 0; }
+    std::uint16_t protocol() const             { assertWrongFamilyType(); return 0; }
+    void setPort(std::uint16_t)                { assertWrongFamilyType(); }
+    void setProtocol(std::uint16_t)            { assertWrongFamilyType(); }
+    ::in_addr get_sin_addr() const             { assertWrongFamilyType(); return {}; }
+    ::in6_addr get_sin6_addr() const           { assertWrongFamilyType(); return {}; }
+
+    RefType storage;
+    std::conditional_t<isMutable, Type&, Type const&> sock;
+};
+
+//===============================================================
+// The trivial, per-family accessors. NetworkAddress.cpp derives the
+// remaining methods (initialisation, interfaces, formatting) from these.
+template <NetworkAddress::Family, bool isMutable = true> struct SocketAccessors;
+
+template <bool isMutable>
+struct SocketAccessors<NetworkAddress::Family::ipv4, isMutable> : SocketMethods<NetworkAddress::Family::ipv4, isMutable> {
+    using Base = SocketMethods<NetworkAddress::Family::ipv4, isMutable>;
+
+    SocketAccessors(Base::RefType _storage) noexcept : Base(_storage) {}
+
+    bool valid() const noexcept                                { return true; }
+    ::socklen_t socketLength() const noexcept                  { return static_cast<::socklen_t>(sizeof(typename Base::Type)); }
+    bool isMulticast() const noexcept                          { return (cxxutils::byteswap(Base::sock.sin_addr.s_addr) & 0xf0000000u) == 0xe0000000u; }
+    bool isLinkLocal() const noexcept                          { return (cxxutils::byteswap(Base::sock.sin_addr.s_addr) & 0xffff0000u) == 0xa9fe0000u; }
+    std::uint16_t port() const noexcept                        { return cxxutils::byteswap(Base::sock.sin_port); }
+    void setPort(std::uint16_t p) noexcept                     { Base::sock.sin_port = cxxutils::byteswap(p); }
+    ::in_addr get_sin_addr() const noexcept                    { return Base::sock.sin_addr; }
+};
+
+template <bool isMutable>
+struct SocketAccessors<NetworkAddress::Family::ipv6, isMutable> : SocketMethods<NetworkAddress::Family::ipv6, isMutable> {
+    using Base = SocketMethods<NetworkAddress::Family::ipv6, isMutable>;
+
+    SocketAccessors(Base::RefType _storage) noexcept : Base(_storage) {}
+
+    bool valid() const noexcept                                { return true; }
+    ::socklen_t socketLength() const noexcept                  { return static_cast<::socklen_t>(sizeof(typename Base::Type)); }
+    bool isMulticast() const noexcept                          { return (Base::sock.sin6_addr.s6_addr[0] == 0xff); }
+    bool isLinkLocal() const noexcept                          { return (Base::sock.sin6_addr.s6_addr[0] == 0xfe) && (Base::sock.sin6_addr.s6_addr[1] == 0x80); }
+    std::uint16_t port() const noexcept                        { return cxxutils::byteswap(Base::sock.sin6_port); }
+    void setPort(std::uint16_t p) noexcept                     { Base::sock.sin6_port = cxxutils::byteswap(p); }
+    ::in6_addr get_sin6_addr() const noexcept                  { return Base::sock.sin6_addr; }
+};
+
+#if __APPLE__
+template <bool isMutable>
+struct SocketAccessors<NetworkAddress::Family::ethernet, isMutable> : SocketMethods<NetworkAddress::Family::ethernet, isMutable> {
+    using Base = SocketMethods<NetworkAddress::Family::ethernet, isMutable>;
+
+    SocketAccessors(Base::RefType _storage) noexcept : Base(_storage) {}
+
+    bool valid() const noexcept                                { return Base::sock.sdl_alen > 0; }
+    ::socklen_t socketLength() const                           { return sizeof(sockaddr_dl); }
+    bool isMulticast() const noexcept                          { typename Base::Type const& s = Base::sock; return (LLADDR(&s)[0] & 0x1) != 0; }
+    bool isLinkLocal() const noexcept                          { return true; }
+    std::uint16_t protocol() const noexcept                    { return 0; }
+    void setProtocol(std::uint16_t) noexcept                   {}
+};
+#elif __linux__
+template <bool isMutable>
+struct SocketAccessors<NetworkAddress::Family::ethernet, isMutable> : SocketMethods<NetworkAddress::Family::ethernet, isMutable> {
+    using Base = SocketMethods<NetworkAddress::Family::ethernet, isMutable>;
+
+    SocketAccessors(Base::RefType _storage) noexcept : Base(_storage) {}
+
+    bool valid() const noexcept                                { return true; }
+    ::socklen_t socketLength() const                           { return sizeof(sockaddr_ll) - sizeof(std::declval<sockaddr_ll>().sll_addr) + Base::sock.sll_halen; }
+    bool isMulticast() const noexcept                          { return (Base::sock.sll_addr[0] & 0x1) != 0; }
+    bool isLinkLocal() const noexcept                          { return true; }
+    std::uint16_t protocol() const noexcept                    { return cxxutils::byteswap(Base::sock.sll_protocol); }
+    void setProtocol(std::uint16_t p) noexcept                 { Base::sock.sll_protocol = cxxutils::byteswap(p); }
+};
+#endif
+
+template <bool isMutable>
+struct SocketAccessors<NetworkAddress::Family::unixSocket, isMutable> : SocketMethods<NetworkAddress::Family::unixSocket, isMutable> {
+    using Base = SocketMethods<NetworkAddress::Family::unixSocket, isMutable>;
+
+    SocketAccessors(Base::RefType _storage) noexcept : Base(_storage) {}
+
+    bool valid() const                         { return true; }
+    std::size_t sunPathLength() const noexcept { return Base::storage.unixSocket.sunPathLength; }
+    bool isAbstract() const noexcept           { return sunPathLength() > 0 && Base::sock.sun_path[0] == '\0'; }
+
+    // a path's terminating NUL counts if it fits into sun_path
+    ::socklen_t socketLength() const {
+        auto const len = sunPathLength() + (sunPathLength() > 0 && ! isAbstract() ? 1 : 0);
+        return static_cast<::socklen_t>(offsetof(::sockaddr_un, sun_path) + std::min(len, sizeof(Base::sock.sun_path)));
+    }
+};
+}
+
+//===============================================================
+// Trivial accessors: inline in CXXNETADDR_INLINE mode, otherwise only
+// compiled in NetworkAddress.cpp
+CXXNETADDR_INLINE_API ::sa_family_t NetworkAddress::family2POSIX(Family family) noexcept     { return cxxnetaddr::detail::addr2unix(family); }
+CXXNETADDR_INLINE_API NetworkAddress::Family NetworkAddress::POSIX2Family(::sa_family_t family) noexcept { return cxxnetaddr::detail::unix2addr(family); }
+
+CXXNETADDR_INLINE_API bool NetworkAddress::valid() const {
+    using cxxnetaddr::detail::SocketAccessors;
+
+    if (family() == Family::unspecified) {
+        return false;
+    }
+
+    if (auto isvalid = cxxnetaddr::detail::sockcall<SocketAccessors>(storage, [] (auto s) { return s.valid(); }); isvalid.has_value()) {
+        return *isvalid;
+    }
+
+    return false;
+}
+
+CXXNETADDR_INLINE_API NetworkAddress::Family NetworkAddress::family() const { return cxxnetaddr::detail::unix2addr(storage.ss.ss_family); }
+CXXNETADDR_INLINE_API sa_family_t NetworkAddress::posixFamily() const       { return family() != Family::unspecified ? storage.ss.ss_family : AF_UNSPEC; }
+CXXNETADDR_INLINE_API ::sockaddr const& NetworkAddress::socket() const      { return storage.sa; }
+
+CXXNETADDR_INLINE_API ::socklen_t NetworkAddress::socketLength() const {
+    using cxxnetaddr::detail::SocketAccessors;
+    return *cxxnetaddr::detail::sockcall<SocketAccessors>(storage, [] (auto s) { return s.socketLength(); });
+}
+
+CXXNETADDR_INLINE_API bool NetworkAddress::isMulticast() const {
+    using cxxnetaddr::detail::SocketAccessors;
+    return *cxxnetaddr::detail::sockcall<SocketAccessors>(storage, [] (auto s) { return s.isMulticast(); });
+}
+
+CXXNETADDR_INLINE_API bool NetworkAddress::isLinkLocal() const {
+    using cxxnetaddr::detail::SocketAccessors;
+    return *cxxnetaddr::detail::sockcall<SocketAccessors>(storage, [] (auto s) { return s.isLinkLocal(); });
+}
+
+CXXNETADDR_INLINE_API std::uint16_t NetworkAddress::port() const {
+    using cxxnetaddr::detail::SocketAccessors;
+    return *cxxnetaddr::detail::sockcall<SocketAccessors>(storage, [] (auto s) { return s.port(); });
+}
+
+CXXNETADDR_INLINE_API std::uint16_t NetworkAddress::protocol() const {
+    using cxxnetaddr::detail::SocketAccessors;
+    return *cxxnetaddr::detail::sockcall<SocketAccessors>(storage, [] (auto s) { return s.protocol(); });
+}
+
+CXXNETADDR_INLINE_API struct ::in_addr NetworkAddress::get_sin_addr() const {
+    using cxxnetaddr::detail::SocketAccessors;
+    return *cxxnetaddr::detail::sockcall<SocketAccessors>(storage, [] (auto s) { return s.get_sin_addr(); });
+}
+
+CXXNETADDR_INLINE_API struct ::in6_addr NetworkAddress::get_sin6_addr() const {
+    using cxxnetaddr::detail::SocketAccessors;
+    return *cxxnetaddr::detail::sockcall<SocketAccessors>(storage, [] (auto s) { return s.get_sin6_addr(); });
+}
@@ -0,0 +1,322 @@
+//
+//  NetworkAddress_bench.cpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <string>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netdb.h>
+
+#include "NetworkAddress.hpp"
+
+namespace
+{
+constexpr std::size_t kCorpusSize = 4096;
+
+//===============================================================
+// Realistic, deterministic corpora: mostly IPv4 with a good share of
+// IPv6 (compressed, with ports, with zones and IPv4-mapped) and MACs.
+struct Corpus
+{
+    std::vector<std::string> ipStrings;      // IP addresses with and without ports
+    std::vector<std::string> plainIPStrings; // IP addresses without ports or zones
+    std::vector<std::string> macStrings;
+    std::vector<NetworkAddress> addresses;   // the parsed ipStrings and macStrings
+    std::vector<NetworkAddress> ipAddresses; // the parsed ipStrings
+
+    Corpus() {
+        std::mt19937_64 rng(42);
+        auto const word = [&rng] { return static_cast<unsigned>(rng() & 0xffff); };
+        auto const hex = [] (unsigned v) { char buf[8]; std::snprintf(buf, sizeof(buf), "%x", v); return std::string(buf); };
+
+        for (std::size_t i = 0; i < kCorpusSize; ++i) {
+            std::string ip;
+            auto const kind = rng() % 10;
+
+            if (kind < 6) {
+                auto const v = static_cast<std::uint32_t>(rng());
+                ip = std::to_string(v >> 24) + "." + std::to_string((v >> 16) & 0xff) + "." + std::to_string((v >> 8) & 0xff) + "." + std::to_string(v & 0xff);
+                plainIPStrings.push_back(ip);
+                ipStrings.push_back(kind < 3 ? ip : ip + ":" + std::to_string(1024 + rng() % 64000));
+            } else if (kind < 8) {
+                ip = "2001:db8:" + hex(word()) + ":" + hex(word()) + "::" + hex(word());
+                plainIPStrings.push_back(ip);
+                ipStrings.push_back(kind == 6 ? ip : "[" + ip + "]:" + std::to_string(1024 + rng() % 64000));
+            } else if (kind == 8) {
+                ip = "fe80::" + hex(word()) + ":" + hex(word());
+                plainIPStrings.push_back(ip);
+                ipStrings.push_back(ip + "%lo");
+            } else {
+                ip = "::ffff:10.0." + std::to_string(rng() & 0xff) + "." + std::to_string(rng() & 0xff);
+                plainIPStrings.push_back(ip);
+                ipStrings.push_back(ip);
+            }
+
+            char mac[18];
+            auto const m = rng();
+            std::snprintf(mac, sizeof(mac), "%02x:%02x:%02x:%02x:%02x:%02x",
+                          unsigned(m & 0xff), unsigned((m >> 8) & 0xff), unsigned((m >> 16) & 0xff),
+                          unsigned((m >> 24) & 0xff), unsigned((m >> 32) & 0xff), unsigned((m >> 40) & 0xff));
+            macStrings.emplace_back(mac);
+        }
+
+        for (std::size_t i = 0; i < kCorpusSize; ++i) {
+            addresses.push_back(i % 8 == 7 ? *NetworkAddress::fromMACString(macStrings[i])
+                                           : *NetworkAddress::fromIPString(ipStrings[i]));
+            ipAddresses.push_back(*NetworkAddress::fromIPString(ipStrings[i]));
+        }
+    }
+};
+
+Corpus const& corpus() {
+    static Corpus const c;
+    return c;
+}
+
+template <typename Fn>
+void runOverCorpus(benchmark::State& state, std::size_t n, Fn&& fn) {
+    std::size_t i = 0;
+
+    for (auto _ : state) {
+        fn(i);
+        i = (i + 1) % n;
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+//===============================================================
+// Thread-scaling variants: every thread walks the corpus from a
+// different offset. ops_per_thread stays flat if an API scales linearly.
+int const kMaxThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+template <typename Fn>
+void runScaling(benchmark::State& state, std::size_t n, Fn&& fn) {
+    auto i = (static_cast<std::size_t>(state.thread_index()) * 997) % n;
+
+    for (auto _ : state) {
+        fn(i);
+        i = (i + 1) % n;
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.counters["ops_per_thread"] = benchmark::Counter(static_cast<double>(state.iterations()),
+                                                          benchmark::Counter::kIsRate | benchmark::Counter::kAvgThreads);
+}
+}
+
+//===============================================================
+// Parsing
+static void BM_FromIPString(benchmark::State& state) {
+    auto const& c = corpus();
+    runOverCorpus(state, kCorpusSize, [&c] (std::size_t i) { benchmark::DoNotOptimize(NetworkAddress::fromIPString(c.ipStrings[i])); });
+}
+BENCHMARK(BM_FromIPString);
+
+static void BM_FromIPStringNoPort(benchmark::State& state) {
+    auto const& c = corpus();
+    runOverCorpus(state, kCorpusSize, [&c] (std::size_t i) { benchmark::DoNotOptimize(NetworkAddress::fromIPString(c.plainIPStrings[i], 0, false)); });
+}
+BENCHMARK(BM_FromIPStringNoPort);
+
+static void BM_Baseline_InetPton(benchmark::State& state) {
+    auto const& c = corpus();
+    runOverCorpus(state, kCorpusSize, [&c] (std::size_t i) {
+        auto const& s = c.plainIPStrings[i];
+        ::in6_addr buf;
+        auto const isIPv6 = s.find(':') != std::string::npos;
+        benchmark::DoNotOptimize(::inet_pton(isIPv6 ? AF_INET6 : AF_INET, s.c_str(), &buf));
+        benchmark::DoNotOptimize(buf);
+    });
+}
+BENCHMARK(BM_Baseline_InetPton);
+
+static void BM_FromMACString(benchmark::State& state) {
+    auto const& c = corpus();
+    runOverCorpus(state, kCorpusSize, [&c] (std::size_t i) { benchmark::DoNotOptimize(NetworkAddress::fromMACString(c.macStrings[i])); });
+}
+BENCHMARK(BM_FromMACString);
+
+//===============================================================
+// Formatting
+static void BM_ToString(benchmark::State& state) {
+    auto const& c = corpus();
+    runOverCorpus(state, kCorpusSize, [&c] (std::size_t i) { benchmark::DoNotOptimize(c.addresses[i].toString()); });
+}
+BENCHMARK(BM_ToString);
+
+static void BM_Baseline_InetNtop(benchmark::State& state) {
+    auto const& c = corpus();
+    std::vector<std::pair<int, ::in6_addr>> raw;
+
+    for (auto const& addr : c.addresses) {
+        ::in6_addr buf = {};
+
+        if (addr.family() == NetworkAddress::Family::ipv4) {
+            auto const sin = addr.get_sin_addr();
+            std::memcpy(&buf, &sin, sizeof(sin));
+            raw.emplace_back(AF_INET, buf);
+        } else if (addr.family() == NetworkAddress::Family::ipv6) {
+            raw.emplace_back(AF_INET6, addr.get_sin6_addr());
+        }
+    }
+
+    runOverCorpus(state, raw.size(), [&raw] (std::size_t i) {
+        char buf[INET6_ADDRSTRLEN];
+        benchmark::DoNotOptimize(::inet_ntop(raw[i].first, &raw[i].second, buf, sizeof(buf)));
+        benchmark::ClobberMemory();
+    });
+}
+BENCHMARK(BM_Baseline_InetNtop);
+
+//===============================================================
+// Batch construction
+static void BM_FromIPv4Array(benchmark::State& state) {
+    std::vector<std::uint32_t> saddrs(kCorpusSize);
+    std::vector<std::uint16_t> ports(kCorpusSize);
+    std::mt19937_64 rng(42);
+    std::generate(saddrs.begin(), saddrs.end(), [&rng] { return static_cast<std::uint32_t>(rng()); });
+    std::generate(ports.begin(), ports.end(), [&rng] { return static_cast<std::uint16_t>(rng()); });
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(NetworkAddress::fromIPv4Array(saddrs, ports));
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(kCorpusSize));
+}
+BENCHMARK(BM_FromIPv4Array);
+
+static void BM_Baseline_IPv4Constructor(benchmark::State& state) {
+    std::vector<std::uint32_t> saddrs(kCorpusSize);
+    std::vector<std::uint16_t> ports(kCorpusSize);
+    std::mt19937_64 rng(42);
+    std::generate(saddrs.begin(), saddrs.end(), [&rng] { return static_cast<std::uint32_t>(rng()); });
+    std::generate(ports.begin(), ports.end(), [&rng] { return static_cast<std::uint16_t>(rng()); });
+
+    for (auto _ : state) {
+        std::vector<NetworkAddress> result;
+        result.reserve(kCorpusSize);
+
+        for (std::size_t i = 0; i < kCorpusSize; ++i) {
+            result.emplace_back(saddrs[i], ports[i]);
+        }
+
+        benchmark::DoNotOptimize(result);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(kCorpusSize));
+}
+BENCHMARK(BM_Baseline_IPv4Constructor);
+
+//===============================================================
+// Value semantics and accessors
+static void BM_Copy(benchmark::State& state) {
+    auto const& c = corpus();
+    runOverCorpus(state, kCorpusSize, [&c] (std::size_t i) {
+        NetworkAddress copy(c.addresses[i]);
+        benchmark::DoNotOptimize(copy);
+    });
+}
+BENCHMARK(BM_Copy);
+
+static void BM_Move(benchmark::State& state) {
+    auto const& c = corpus();
+    runOverCorpus(state, kCorpusSize, [&c] (std::size_t i) {
+        NetworkAddress src(c.addresses[i]);
+        NetworkAddress dst(std::move(src));
+        benchmark::DoNotOptimize(dst);
+    });
+}
+BENCHMARK(BM_Move);
+
+static void BM_Equality(benchmark::State& state) {
+    auto const& c = corpus();
+    runOverCorpus(state, kCorpusSize - 1, [&c] (std::size_t i) { benchmark::DoNotOptimize(c.addresses[i] == c.addresses[i + 1]); });
+}
+BENCHMARK(BM_Equality);
+
+static void BM_ThreeWayCompare(benchmark::State& state) {
+    auto const& c = corpus();
+    runOverCorpus(state, kCorpusSize - 1, [&c] (std::size_t i) { benchmark::DoNotOptimize(c.addresses[i] <=> c.addresses[i + 1]); });
+}
+BENCHMARK(BM_ThreeWayCompare);
+
+static void BM_Port(benchmark::State& state) {
+    auto const& c = corpus();
+    runOverCorpus(state, kCorpusSize, [&c] (std::size_t i) { benchmark::DoNotOptimize(c.ipAddresses[i].port()); });
+}
+BENCHMARK(BM_Port);
+
+static void BM_Family(benchmark::State& state) {
+    auto const& c = corpus();
+    runOverCorpus(state, kCorpusSize, [&c] (std::size_t i) { benchmark::DoNotOptimize(c.addresses[i].family()); });
+}
+BENCHMARK(BM_Family);
+
+static void BM_WithPort(benchmark::State& state) {
+    auto const& c = corpus();
+    runOverCorpus(state, kCorpusSize, [&c] (std::size_t i) { benchmark::DoNotOptimize(c.ipAddresses[i].withPort(8080)); });
+}
+BENCHMARK(BM_WithPort);
+
+//===============================================================
+// Thread scaling
+static void BM_Scaling_FromIPString(benchmark::State& state) {
+    auto const& c = corpus();
+    runScaling(state, kCorpusSize, [&c] (std::size_t i) { benchmark::DoNotOptimize(NetworkAddress::fromIPString(c.ipStrings[i])); });
+}
+BENCHMARK(BM_Scaling_FromIPString)->ThreadRange(1, kMaxThreads)->UseRealTime();
+
+static void BM_Scaling_ToString(benchmark::State& state) {
+    auto const& c = corpus();
+    runScaling(state, kCorpusSize, [&c] (std::size_t i) { benchmark::DoNotOptimize(c.addresses[i].toString()); });
+}
+BENCHMARK(BM_Scaling_ToString)->ThreadRange(1, kMaxThreads)->UseRealTime();
+
+static void BM_Scaling_ToChars(benchmark::State& state) {
+    auto const& c = corpus();
+    runScaling(state, kCorpusSize, [&c] (std::size_t i) {
+        char buffer[NetworkAddress::kMaxStringLength];
+        benchmark::DoNotOptimize(c.addresses[i].toChars(buffer, buffer + sizeof(buffer)));
+        benchmark::ClobberMemory();
+    });
+}
+BENCHMARK(BM_Scaling_ToChars)->ThreadRange(1, kMaxThreads)->UseRealTime();
+
+static void BM_Scaling_Baseline_Getaddrinfo(benchmark::State& state) {
+    auto const& c = corpus();
+    runScaling(state, kCorpusSize, [&c] (std::size_t i) {
+        ::addrinfo hints = {};
+        hints.ai_flags = AI_NUMERICHOST | AI_NUMERICSERV;
+        ::addrinfo* result = nullptr;
+
+        if (::getaddrinfo(c.plainIPStrings[i].c_str(), "0", &hints, &result) == 0) {
+            ::freeaddrinfo(result);
+        }
+    });
+}
+BENCHMARK(BM_Scaling_Baseline_Getaddrinfo)->ThreadRange(1, kMaxThreads)->UseRealTime();
+
+static void BM_Scaling_Baseline_Getnameinfo(benchmark::State& state) {
+    auto const& c = corpus();
+    runScaling(state, kCorpusSize, [&c] (std::size_t i) {
+        auto const& addr = c.ipAddresses[i];
+        char host[NI_MAXHOST], service[NI_MAXSERV];
+        benchmark::DoNotOptimize(::getnameinfo(&addr.socket(), addr.socketLength(), host, sizeof(host),
+                                               service, sizeof(service), NI_NUMERICHOST | NI_NUMERICSERV));
+    });
+}
+BENCHMARK(BM_Scaling_Baseline_Getnameinfo)->ThreadRange(1, kMaxThreads)->UseRealTime();
@@ -11,7 +11,14 @@
 //
 #include <gtest/gtest.h>
 #include <arpa/inet.h>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
 #include <netinet/in.h>
+#include <sys/un.h>
 
 #include "NetworkAddress.hpp"
 #include "NetworkInterface.hpp"
@@ -253,3 +260,282 @@ TEST(NetworkAddressTest, UnicastAddressIsNotMulticast) {
     EXPECT_FALSE(ipv6Addr.isMulticast());
     EXPECT_FALSE(macAddr.isMulticast());
 }
+
+// Test that formatting matches inet_ntop and parsing matches inet_pton
+TEST(NetworkAddressTest, MatchesInetPtonAndNtop) {
+    std::srand(1);
+    for (int i = 0; i < 2000; ++i) {
+        ::in6_addr raw = {};
+        for (auto& b : raw.s6_addr) {
+            // plenty of zero runs and the IPv4-mapped prefix
+            b = (std::rand() % 3 == 0 ? static_cast<std::uint8_t>(std::rand()) : 0);
+        }
+
+        if (i % 5 == 0) {
+            raw.s6_addr[10] = raw.s6_addr[11] = 0xff;
+        }
+
+        char expected[INET6_ADDRSTRLEN];
+        ASSERT_NE(::inet_ntop(AF_INET6, &raw, expected, sizeof(expected)), nullptr);
+
+        auto const addr = NetworkAddress::fromIPString(expected, 0, false);
+        ASSERT_TRUE(addr.has_value()) << expected;
+        EXPECT_EQ(std::memcmp(addr->get_sin6_addr().s6_addr, raw.s6_addr, 16), 0) << expected;
+        EXPECT_EQ(addr->toString(), expected);
+    }
+
+    for (auto const* invalid : {"", "1.2.3", "1.2.3.4.5", "01.2.3.4", "256.1.1.1", "1.2.3.4%lo", "1:2:3:4:5:6:7:8:9",
+                                "1::2::3", ":1::2", "1:2:3:4:5:6:7:", "12345::", "::1.2.3", "fe80::1%", "[::1]:65536",
+                                "1.2.3.4:port", "g::1"}) {
+        EXPECT_FALSE(NetworkAddress::fromIPString(invalid).has_value()) << invalid;
+    }
+}
+
+// Test scope ids in parsing and formatting
+TEST(NetworkAddressTest, ScopeIds) {
+    auto const linkLocal = NetworkAddress::fromIPString("fe80::1%lo");
+    ASSERT_TRUE(linkLocal.has_value());
+    EXPECT_EQ(linkLocal->interface()->getName(), "lo");
+    EXPECT_EQ(linkLocal->toString(), "fe80::1%lo");
+    EXPECT_EQ(linkLocal->withPort(80).toString(), "[fe80::1%lo]:80");
+
+    auto const numeric = NetworkAddress::fromIPString("[2001:db8::1%7]:8080");
+    ASSERT_TRUE(numeric.has_value());
+    EXPECT_EQ(numeric->toString(), "[2001:db8::1%7]:8080");
+}
+
+// Test toChars with a too small buffer
+TEST(NetworkAddressTest, ToCharsBufferTooSmall) {
+    NetworkAddress const addr(192, 168, 1, 1, 8080);
+    char buffer[NetworkAddress::kMaxStringLength];
+
+    auto const [end, ec] = addr.toChars(buffer, buffer + sizeof(buffer));
+    ASSERT_EQ(ec, std::errc());
+    EXPECT_EQ(std::string(buffer, end), "192.168.1.1:8080");
+
+    EXPECT_EQ(addr.toChars(buffer, buffer + 15).ec, std::errc::value_too_large);
+    EXPECT_EQ(NetworkAddress().toChars(buffer, buffer + sizeof(buffer)).ec, std::errc::invalid_argument);
+}
+
+// Test that malformed MAC addresses are rejected
+TEST(NetworkAddressTest, FromMACStringRejectsMalformed) {
+    EXPECT_EQ(NetworkAddress::fromMACString("0:a:b:c:d:e")->toString(), "00:0A:0B:0C:0D:0E");
+
+    for (auto const* invalid : {"", "00:1A:2B:3C:4D", "00:1A:2B:3C:4D:5E:", "00:1A:2B:3C:4D:5E:6F", "001:1A:2B:3C:4D:5E",
+                                "00::2B:3C:4D:5E", "00:1A:2B:3C:4D:5G", " 0:1A:2B:3C:4D:5E"}) {
+        EXPECT_FALSE(NetworkAddress::fromMACString(invalid).has_value()) << invalid;
+    }
+}
+
+// Test that comparisons ignore padding and the IPv6 flow info
+TEST(NetworkAddressTest, ComparisonIgnoresPadding) {
+    ::sockaddr_in sin = {};
+    sin.sin_family = AF_INET;
+    sin.sin_port = htons(80);
+    sin.sin_addr.s_addr = htonl(0x0a000001);
+    std::memset(sin.sin_zero, 0xab, sizeof(sin.sin_zero));
+
+    EXPECT_EQ(NetworkAddress::fromPOSIXSocketAddress(reinterpret_cast<::sockaddr const&>(sin), sizeof(sin)),
+              NetworkAddress(10, 0, 0, 1, 80));
+
+    auto const addr = *NetworkAddress::fromIPString("[2001:db8::1]:443");
+    ::sockaddr_in6 sin6;
+    std::memcpy(&sin6, &addr.socket(), sizeof(sin6));
+    sin6.sin6_flowinfo = htonl(0x12345);
+
+    auto const withFlow = NetworkAddress::fromPOSIXSocketAddress(reinterpret_cast<::sockaddr const&>(sin6), sizeof(sin6));
+    EXPECT_EQ(withFlow, addr);
+    EXPECT_EQ(withFlow <=> addr, std::strong_ordering::equal);
+}
+
+// Test the documented ordering of addresses
+TEST(NetworkAddressTest, ComparisonOrder) {
+    // families in enum order, unspecified last
+    std::vector<NetworkAddress> const ordered = {
+        NetworkAddress(10, 0, 0, 1, 443),
+        NetworkAddress(10, 0, 0, 2, 80),
+        NetworkAddress(192, 168, 0, 1, 80),
+        *NetworkAddress::fromIPString("::1"),
+        *NetworkAddress::fromIPString("[::1]:80"),
+        *NetworkAddress::fromIPString("2001:db8::1"),
+        *NetworkAddress::fromIPString("ff02::1"),
+        NetworkAddress(0x00, 0x1A, 0x2B, 0x3C, 0x4D, 0x5E),
+        NetworkAddress(0x00, 0x1A, 0x2B, 0x3C, 0x4D, 0x5F),
+        NetworkAddress::fromUNIXSocketPath("/tmp/a"),
+        NetworkAddress::fromUNIXSocketPath("/tmp/b"),
+        NetworkAddress()
+    };
+
+    for (std::size_t i = 0; i < ordered.size(); ++i) {
+        for (std::size_t j = 0; j < ordered.size(); ++j) {
+            EXPECT_EQ(ordered[i] <=> ordered[j], i <=> j) << ordered[i].toString() << " vs " << ordered[j].toString();
+            EXPECT_EQ(ordered[i] == ordered[j], i == j);
+        }
+    }
+}
+
+// Test the batch construction of IPv4 addresses
+TEST(NetworkAddressTest, FromIPv4Array) {
+    std::vector<std::uint32_t> saddrs;
+    std::vector<std::uint16_t> ports;
+
+    for (std::uint32_t i = 0; i < 150; ++i) {
+        saddrs.push_back(0xc0a80000u + i * 257);
+        ports.push_back(static_cast<std::uint16_t>(1000 + i));
+    }
+
+    auto const addrs = NetworkAddress::fromIPv4Array(saddrs, ports);
+    ASSERT_EQ(addrs.size(), saddrs.size());
+
+    for (std::size_t i = 0; i < addrs.size(); ++i) {
+        EXPECT_EQ(addrs[i], NetworkAddress(saddrs[i], ports[i]));
+        EXPECT_EQ(addrs[i].port(), ports[i]);
+    }
+
+    auto const noPorts = NetworkAddress::fromIPv4Array(saddrs);
+    EXPECT_EQ(noPorts[42], NetworkAddress(saddrs[42]));
+    EXPECT_EQ(noPorts[42].toString(), NetworkAddress(saddrs[42]).toString());
+    EXPECT_TRUE(NetworkAddress::fromIPv4Array({}).empty());
+}
+
+// Test the length of UNIX socket addresses and too long paths
+TEST(NetworkAddressTest, UNIXSocketPathLength) {
+    auto const addr = NetworkAddress::fromUNIXSocketPath(std::string_view("/tmp/socket"));
+    EXPECT_EQ(addr.socketLength(), offsetof(::sockaddr_un, sun_path) + 12);
+
+    auto const copy = addr;
+    EXPECT_EQ(copy.socketLength(), addr.socketLength());
+    EXPECT_EQ(copy.toString(), "/tmp/socket");
+
+    auto const roundTrip = NetworkAddress::fromPOSIXSocketAddress(addr.socket(), addr.socketLength());
+    EXPECT_EQ(roundTrip, addr);
+    EXPECT_EQ(roundTrip.socketLength(), addr.socketLength());
+    EXPECT_EQ(NetworkAddress::fromPOSIXSocketAddress(addr.socket()), addr);
+
+    std::string const longest(sizeof(::sockaddr_un::sun_path) - 1, 'x');
+    EXPECT_TRUE(NetworkAddress::fromUNIXSocketPath(longest).valid());
+    EXPECT_EQ(NetworkAddress::fromUNIXSocketPath(longest).toString(), longest);
+    EXPECT_FALSE(NetworkAddress::fromUNIXSocketPath(longest + "x").valid());
+}
+
+// Test UNIX socket paths whose length excludes the NUL or that fill sun_path
+TEST(NetworkAddressTest, UNIXSocketPathWithoutNUL) {
+    ::sockaddr_un sun = {};
+    sun.sun_family = AF_UNIX;
+    std::memcpy(sun.sun_path, "/tmp/sock", 9);
+
+    // SUN_LEN: the length of the path without its terminating NUL
+    auto const withoutNUL = NetworkAddress::fromPOSIXSocketAddress(reinterpret_cast<::sockaddr const&>(sun),
+                                                                   static_cast<::socklen_t>(offsetof(::sockaddr_un, sun_path) + 9));
+    EXPECT_EQ(withoutNUL.toString(), "/tmp/sock");
+    EXPECT_EQ(withoutNUL, NetworkAddress::fromUNIXSocketPath("/tmp/sock"));
+    EXPECT_EQ(withoutNUL.socketLength(), offsetof(::sockaddr_un, sun_path) + 10);
+
+    // a path filling all of sun_path has no NUL at all
+    std::string const full(sizeof(sun.sun_path), 'y');
+    std::memcpy(sun.sun_path, full.data(), full.size());
+
+    for (auto const len : {static_cast<::socklen_t>(sizeof(sun)), std::numeric_limits<::socklen_t>::max()}) {
+        auto const addr = NetworkAddress::fromPOSIXSocketAddress(reinterpret_cast<::sockaddr const&>(sun), len);
+        EXPECT_EQ(addr.toString(), full);
+        EXPECT_EQ(addr.socketLength(), sizeof(sun));
+        EXPECT_NE(addr, NetworkAddress::fromUNIXSocketPath(full.substr(1)));
+    }
+}
+
+#if __linux__
+// Test UNIX socket addresses in the abstract namespace
+TEST(NetworkAddressTest, AbstractUNIXSocketName) {
+    auto const addr = NetworkAddress::fromAbstractUNIXSocketName("broker");
+    ASSERT_TRUE(addr.valid());
+    EXPECT_EQ(addr.family(), NetworkAddress::Family::unixSocket);
+    EXPECT_EQ(addr.socketLength(), offsetof(::sockaddr_un, sun_path) + 7);
+    EXPECT_EQ(addr.toString(), "@broker");
+    EXPECT_NE(addr, NetworkAddress::fromUNIXSocketPath("broker"));
+    EXPECT_LT(addr, NetworkAddress::fromUNIXSocketPath("broker"));
+    EXPECT_EQ(NetworkAddress::fromAbstractUNIXSocketName(std::string_view("a\0b", 3)).toString(), "@a@b");
+
+    auto const roundTrip = NetworkAddress::fromPOSIXSocketAddress(addr.socket(), addr.socketLength());
+    EXPECT_EQ(roundTrip, addr);
+
+    // the name is delimited by the length, not by a NUL
+    EXPECT_NE(NetworkAddress::fromPOSIXSocketAddress(addr.socket(), addr.socketLength() - 1), addr);
+}
+#endif
+
+// Test that equal addresses have equal hashes
+TEST(NetworkAddressTest, HashMatchesEquality) {
+    std::hash<NetworkAddress> const hasher;
+    auto const addr = *NetworkAddress::fromIPString("[2001:db8::1]:443");
+    ::sockaddr_in6 sin6;
+    std::memcpy(&sin6, &addr.socket(), sizeof(sin6));
+    sin6.sin6_flowinfo = htonl(0x12345);
+
+    EXPECT_EQ(hasher(NetworkAddress::fromPOSIXSocketAddress(reinterpret_cast<::sockaddr const&>(sin6), sizeof(sin6))), hasher(addr));
+    EXPECT_EQ(hasher(NetworkAddress(10, 0, 0, 1, 80)), hasher(NetworkAddress(10, 0, 0, 1, 80)));
+    EXPECT_EQ(hasher(NetworkAddress::fromUNIXSocketPath("/tmp/a")), hasher(NetworkAddress::fromUNIXSocketPath("/tmp/a")));
+
+    // distinct addresses spread over the hash values
+    std::vector<std::size_t> hashes;
+
+    for (std::uint32_t i = 0; i < 1000; ++i) {
+        hashes.push_back(hasher(NetworkAddress(0x0a000000u + i, 80)) % 1024);
+    }
+
+    std::sort(hashes.begin(), hashes.end());
+    EXPECT_GT(std::unique(hashes.begin(), hashes.end()) - hashes.begin(), 500);
+    EXPECT_NE(hasher(NetworkAddress(10, 0, 0, 1, 80)), hasher(NetworkAddress(10, 0, 0, 1, 81)));
+    EXPECT_NE(hasher(NetworkAddress(0x00, 0x1A, 0x2B, 0x3C, 0x4D, 0x5E)), hasher(NetworkAddress(0x00, 0x1A, 0x2B, 0x3C, 0x4D, 0x5F)));
+}
+
+// Test the format options of toChars
+TEST(NetworkAddressTest, ToCharsFormatOptions) {
+    auto const format = [] (NetworkAddress const& addr, char const* spec) {
+        NetworkAddress::FormatOptions options;
+        auto const* specEnd = spec + std::strlen(spec);
+        EXPECT_EQ(NetworkAddress::FormatOptions::parse(spec, specEnd, options), specEnd) << spec;
+
+        char buffer[NetworkAddress::kMaxStringLength];
+        auto const [end, ec] = addr.toChars(buffer, buffer + sizeof(buffer), options);
+        return ec == std::errc() ? std::string(buffer, end) : std::string("<error>");
+    };
+
+    NetworkAddress const ipv4(192, 168, 1, 1, 8080);
+    auto const ipv6 = *NetworkAddress::fromIPString("[2001:db8::ab]:443");
+    NetworkAddress const mac(0x00, 0x1A, 0x2B, 0x3C, 0x4D, 0x5E);
+
+    EXPECT_EQ(format(ipv4, ""), ipv4.toString());
+    EXPECT_EQ(format(ipv4, "a"), "192.168.1.1");
+    EXPECT_EQ(format(ipv4, "p"), "8080");
+    EXPECT_EQ(format(ipv6, ""), "[2001:db8::ab]:443");
+    EXPECT_EQ(format(ipv6, "a"), "2001:db8::ab");
+    EXPECT_EQ(format(ipv6, "p"), "443");
+    EXPECT_EQ(format(ipv6, "u"), "[2001:DB8::AB]:443");
+    EXPECT_EQ(format(ipv6, "f"), "[2001:0db8:0000:0000:0000:0000:0000:00ab]:443");
+    EXPECT_EQ(format(ipv6, "af"), "2001:0db8:0000:0000:0000:0000:0000:00ab");
+    EXPECT_EQ(format(*NetworkAddress::fromIPString("::ffff:1.2.3.4"), "f"), "0000:0000:0000:0000:0000:ffff:0102:0304");
+    EXPECT_EQ(format(mac, ""), "00:1A:2B:3C:4D:5E");
+    EXPECT_EQ(format(mac, "l"), "00:1a:2b:3c:4d:5e");
+    EXPECT_EQ(format(mac, "a"), "00:1A:2B:3C:4D:5E");
+    EXPECT_EQ(format(mac, "p"), "<error>");
+    EXPECT_EQ(format(NetworkAddress::fromUNIXSocketPath("/tmp/socket"), "a"), "/tmp/socket");
+
+    // the spec ends at the closing brace; unknown characters are invalid
+    NetworkAddress::FormatOptions options;
+    char const spec[] = "ap}";
+    EXPECT_EQ(NetworkAddress::FormatOptions::parse(spec, spec + 3, options), spec + 2);
+    EXPECT_EQ(options.part, NetworkAddress::FormatOptions::Part::port);
+    char const invalid[] = "x}";
+    EXPECT_EQ(NetworkAddress::FormatOptions::parse(invalid, invalid + 2, options), nullptr);
+}
+
+#if defined(__cpp_lib_format)
+// Test std::format support
+TEST(NetworkAddressTest, StdFormat) {
+    NetworkAddress const ipv4(192, 168, 1, 1, 8080);
+    EXPECT_EQ(std::format("{}", ipv4), ipv4.toString());
+    EXPECT_EQ(std::format("{:a} port {:p}", ipv4, ipv4), "192.168.1.1 port 8080");
+    EXPECT_EQ(std::format("{:l}", NetworkAddress(0x00, 0x1A, 0x2B, 0x3C, 0x4D, 0x5E)), "00:1a:2b:3c:4d:5e");
+    EXPECT_EQ(std::format("{}", NetworkAddress()), "");
+}
+#endif
@@ -28,18 +28,40 @@
 #endif
 
 #include "CxxUtilities.hpp"
+#include "Instrumentation.hpp"
 #include "NetworkInterface.hpp"
 
 namespace
 {
+using instrumentation::Api;
+using instrumentation::Syscall;
+
 std::unique_ptr<::ifaddrs, void (*)(::ifaddrs*)> getifaddrs_wrapper() {
+    instrumentation::countSyscall(Syscall::getifaddrs);
+    instrumentation::ProbeTimer probe(CXXNETADDR_PROBE_ENABLED(getifaddrs));
+
     ::ifaddrs* addrs;
-    if (::getifaddrs(&addrs) < 0) {
+    auto const status = ::getifaddrs(&addrs);
+
+    if (probe.active()) {
+        CXXNETADDR_PROBE(getifaddrs, AF_UNSPEC, 0, probe.elapsed());
+    }
+
+    if (status < 0) {
         return {nullptr, nullptr};
     }
 
     return {addrs, ::freeifaddrs};
 }
+
+bool isInterfaceAddress(::ifaddrs const& intf) noexcept {
+    if (intf.ifa_addr == nullptr) {
+        return false;
+    }
+
+    auto const family = intf.ifa_addr->sa_family;
+    return family == kFamilyLinkLevel || family == AF_INET || family == AF_INET6;
+}
 }
 
 NetworkInterface::NetworkInterface() = default;
@@ -52,11 +74,17 @@ NetworkInterface& NetworkInterface::operator=(NetworkInterface && intf) {
     return *this;
 }
 bool NetworkInterface::isValid() const                    { return !name.empty(); }
-std::uint32_t NetworkInterface::getIndex() const          { return ::if_nametoindex(name.c_str()); }
 std::string const &NetworkInterface::getName() const      { return name; }
 
+std::uint32_t NetworkInterface::getIndex() const {
+    instrumentation::ApiScope apiScope(Api::interfaceGetIndex);
+    return instrumentation::ifNameToIndex(name.c_str());
+}
+
 std::optional<NetworkInterface> NetworkInterface::fromString(std::string const& intf) {
-    if (::if_nametoindex(intf.c_str()) == 0) {
+    instrumentation::ApiScope apiScope(Api::interfaceFromString);
+
+    if (instrumentation::ifNameToIndex(intf.c_str()) == 0) {
         return {};
     }
 
@@ -64,8 +92,10 @@ std::optional<NetworkInterface> NetworkInterface::fromString(std::string const&
 }
 
 std::optional<NetworkInterface> NetworkInterface::fromIntfIndex(std::uint32_t index) {
+    instrumentation::ApiScope apiScope(Api::interfaceFromIndex);
+
     char buffer[IF_NAMESIZE + 1];
-    if (auto const* str = ::if_indextoname(index, buffer); str != nullptr) {
+    if (auto const* str = instrumentation::ifIndexToName(index, buffer); str != nullptr) {
         return NetworkInterface(std::string(str));
     }
 
@@ -73,35 +103,48 @@ std::optional<NetworkInterface> NetworkInterface::fromIntfIndex(std::uint32_t in
 }
 
 std::vector<NetworkInterface> NetworkInterface::getAllInterfaces() {
-    if (auto intfs = getifaddrs_wrapper(); intfs != nullptr) {
-        std::vector<NetworkInterface> result;
+    std::vector<NetworkInterface> result;
+    forEachInterface([&result] (NetworkInterface const& intf) { result.push_back(intf); });
+    return result;
+}
 
-        for (auto* intf = intfs.get(); intf != nullptr; intf = intf->ifa_next) {
-            auto const family = intf->ifa_addr->sa_family;
+std::pmr::vector<NetworkInterface> NetworkInterface::getAllInterfaces(std::pmr::memory_resource* resource) {
+    std::pmr::vector<NetworkInterface> result(resource);
+    forEachInterface([&result] (NetworkInterface const& intf) { result.push_back(intf); });
+    return result;
+}
+
+void NetworkInterface::visitInterfaces(cxxnetaddr::detail::VisitorRef<NetworkInterface> visitor) {
+    instrumentation::ApiScope apiScope(Api::interfaceGetAll);
 
-            if (family != kFamilyLinkLevel && family != AF_INET && family != AF_INET6) {
+    if (auto intfs = getifaddrs_wrapper(); intfs != nullptr) {
+        for (auto* intf = intfs.get(); intf != nullptr; intf = intf->ifa_next) {
+            if (! isInterfaceAddress(*intf)) {
                 continue;
             }
 
-            std::string name(intf->ifa_name);
+            // skip names already seen in an earlier entry
+            auto isDuplicate = false;
 
-            if (std::find_if(result.begin(), result.end(), [&name] (auto x) { return x.name == name; }) == result.end()) {
-                result.emplace_back(NetworkInterface(std::string(intf->ifa_name)));
+            for (auto* prev = intfs.get(); prev != intf && (! isDuplicate); prev = prev->ifa_next) {
+                isDuplicate = isInterfaceAddress(*prev) && std::strcmp(prev->ifa_name, intf->ifa_name) == 0;
             }
-        }
 
-        return result;
+            if (! isDuplicate && ! visitor(NetworkInterface(intf->ifa_name))) {
+                return;
+            }
+        }
     }
-
-    return {};
 }
 
 NetworkInterface::Type NetworkInterface::getType() const {
+    instrumentation::ApiScope apiScope(Api::interfaceGetType);
+
     if (auto intfs = getifaddrs_wrapper(); intfs != nullptr && (! name.empty())) {
         auto has_mac = false;
 
         for (auto* intf = intfs.get(); intf != nullptr; intf = intf->ifa_next) {
-            if (std::string(intf->ifa_name) != name) {
+            if (intf->ifa_addr == nullptr || name != intf->ifa_name) {
                 continue;
             }
 
@@ -118,6 +161,8 @@ NetworkInterface::Type NetworkInterface::getType() const {
                 ::ifreq req = {};
                 std::strcpy(req.ifr_name, intf->ifa_name);
 
+                instrumentation::countSyscall(Syscall::socket);
+                instrumentation::countSyscall(Syscall::ioctl);
                 auto sock = cxxutils::callAtEndOfScope(::socket(AF_INET, SOCK_STREAM, 0), [] (int fd) { ::close(fd); });
                 if (::ioctl(sock, /*SIOCGIWNAME*/0x8B01, &req) != -1) {
                     return Type::wifi;
@@ -133,51 +178,46 @@ NetworkInterface::Type NetworkInterface::getType() const {
 }
 
 std::optional<NetworkAddress> NetworkInterface::getIPAddress(bool preferIPv6) const {
+    instrumentation::ApiScope apiScope(Api::interfaceGetIPAddress);
+    auto const preferred = preferIPv6 ? NetworkAddress::Family::ipv6 : NetworkAddress::Family::ipv4;
     std::optional<NetworkAddress> addr;
 
-    if (auto intfs = getifaddrs_wrapper(); intfs != nullptr) {
-        for (auto* intf = intfs.get(); intf != nullptr; intf = intf->ifa_next) {
-            if (std::string(intf->ifa_name) != name) {
-                continue;
-            }
-
-            auto const family = intf->ifa_addr->sa_family;
-
-            if (family != AF_INET && family != AF_INET6) {
-                continue;
-            }
+    // the first address of the preferred family, otherwise the last IP address
+    forEachAddress(NetworkAddress::Family::unspecified, [&addr, preferred] (NetworkAddress const& candidate) {
+        auto const family = candidate.family();
 
-            if ((family == AF_INET6 && preferIPv6) || (family == AF_INET && (! preferIPv6))) {
-                auto retval = NetworkAddress::fromPOSIXSocketAddress(*intf->ifa_addr);
-                
-                if (retval.valid()) {
-                    return retval;
-                }
-            }
-
-            addr  = NetworkAddress::fromPOSIXSocketAddress(*intf->ifa_addr);
+        if (family == NetworkAddress::Family::ipv4 || family == NetworkAddress::Family::ipv6) {
+            addr = candidate;
         }
-    }
+
+        return family != preferred;
+    });
 
     return addr;
 }
 
 std::optional<NetworkAddress> NetworkInterface::getMACAddress() const {
-    auto const macs = getAddresses(NetworkAddress::Family::ethernet);
-    
-    if (macs.empty()) {
-        return {};
-    }
-
-    return macs.front();
+    return findAddress(NetworkAddress::Family::ethernet, [] (NetworkAddress const&) { return true; });
 }
 
 std::vector<NetworkAddress> NetworkInterface::getAddresses(NetworkAddress::Family family) const {
     std::vector<NetworkAddress> result;
+    forEachAddress(family, [&result] (NetworkAddress const& addr) { result.push_back(addr); });
+    return result;
+}
 
-     if (auto intfs = getifaddrs_wrapper(); intfs != nullptr) {
+std::pmr::vector<NetworkAddress> NetworkInterface::getAddresses(std::pmr::memory_resource* resource, NetworkAddress::Family family) const {
+    std::pmr::vector<NetworkAddress> result(resource);
+    forEachAddress(family, [&result] (NetworkAddress const& addr) { result.push_back(addr); });
+    return result;
+}
+
+void NetworkInterface::visitAddresses(NetworkAddress::Family family, cxxnetaddr::detail::VisitorRef<NetworkAddress> visitor) const {
+    instrumentation::ApiScope apiScope(Api::interfaceGetAddresses);
+
+    if (auto intfs = getifaddrs_wrapper(); intfs != nullptr) {
         for (auto* intf = intfs.get(); intf != nullptr; intf = intf->ifa_next) {
-            if (std::string(intf->ifa_name) != name) {
+            if (intf->ifa_addr == nullptr || name != intf->ifa_name) {
                 continue;
             }
 
@@ -189,14 +229,12 @@ std::vector<NetworkAddress> NetworkInterface::getAddresses(NetworkAddress::Famil
                  (family == NetworkAddress::Family::unspecified)) {
                 auto addr = NetworkAddress::fromPOSIXSocketAddress(*intf->ifa_addr);
 
-                if (addr.valid()) {
-                    result.emplace_back(addr);
+                if (addr.valid() && ! visitor(addr)) {
+                    return;
                 }
             }
         }
     }
-
-    return result;
 }
 
 bool NetworkInterface::operator==(NetworkInterface const& o) const { return name == o.name; }
@@ -12,6 +12,7 @@
 #pragma once
 #include <vector>
 #include <compare>
+#include <memory_resource>
 #include <optional>
 #include <string>
 
@@ -76,6 +77,31 @@ public:
      */
     static std::vector<NetworkInterface> getAllInterfaces();
 
+    /**
+     * @brief Retrieves all available network interfaces.
+     *
+     * Same as getAllInterfaces() but the vector is allocated from a
+     * memory resource. Interface names always fit into std::string's
+     * small buffer so the interfaces themselves do not allocate.
+     *
+     * @param resource The memory resource to allocate the vector from.
+     * @return A vector of NetworkInterface objects.
+     */
+    static std::pmr::vector<NetworkInterface> getAllInterfaces(std::pmr::memory_resource* resource);
+
+    /**
+     * @brief Calls a function for every available network interface.
+     *
+     * Unlike getAllInterfaces() no vector is built. The function may return
+     * void or a bool - returning false stops the enumeration early.
+     *
+     * @param fn The function to call with each NetworkInterface const&.
+     */
+    template <typename Fn>
+    static void forEachInterface(Fn && fn) {
+        visitInterfaces(cxxnetaddr::detail::VisitorRef<NetworkInterface>(fn));
+    }
+
     //===============================================================
     /**
      * @brief Checks if the NetworkInterface is valid.
@@ -134,6 +160,58 @@ public:
      */
     std::vector<NetworkAddress> getAddresses(NetworkAddress::Family family = NetworkAddress::Family::unspecified) const;
 
+    /**
+     * @brief Retrieves all addresses associated with the interface.
+     *
+     * Same as getAddresses(family) but the vector is allocated from a
+     * memory resource.
+     *
+     * @param resource The memory resource to allocate the vector from.
+     * @param family The address family to filter by.
+     * @return A vector of NetworkAddress objects.
+     */
+    std::pmr::vector<NetworkAddress> getAddresses(std::pmr::memory_resource* resource,
+                                                  NetworkAddress::Family family = NetworkAddress::Family::unspecified) const;
+
+    /**
+     * @brief Calls a function for every address associated with the interface.
+     *
+     * Unlike getAddresses() no vector is built. The function may return
+     * void or a bool - returning false stops the enumeration early.
+     *
+     * @param family The address family to filter by (Family::unspecified for all).
+     * @param fn The function to call with each NetworkAddress const&.
+     */
+    template <typename Fn>
+    void forEachAddress(NetworkAddress::Family family, Fn && fn) const {
+        visitAddresses(family, cxxnetaddr::detail::VisitorRef<NetworkAddress>(fn));
+    }
+
+    /**
+     * @brief Finds the first address of the interface matching a predicate.
+     *
+     * The enumeration stops at the first match.
+     *
+     * @param family The address family to filter by (Family::unspecified for all).
+     * @param predicate Returns true for the address to find.
+     * @return The address or std::nullopt if no address matches.
+     */
+    template <typename Predicate>
+    std::optional<NetworkAddress> findAddress(NetworkAddress::Family family, Predicate && predicate) const {
+        std::optional<NetworkAddress> result;
+
+        forEachAddress(family, [&result, &predicate] (NetworkAddress const& addr) {
+            if (predicate(addr)) {
+                result = addr;
+                return false;
+            }
+
+            return true;
+        });
+
+        return result;
+    }
+
     //===============================================================
     NetworkInterface(NetworkInterface const&);
     NetworkInterface(NetworkInterface&&);
@@ -154,5 +232,31 @@ public:
 
 private:
     NetworkInterface(std::string const& name);
+
+    // type-erased enumeration: the visitor returns false to stop
+    static void visitInterfaces(cxxnetaddr::detail::VisitorRef<NetworkInterface> visitor);
+    void visitAddresses(NetworkAddress::Family family, cxxnetaddr::detail::VisitorRef<NetworkAddress> visitor) const;
+
     std::string name = {};
 };
+
+#if defined(__cpp_lib_format)
+/** Formats an interface as its name, e.g. std::format("{}", intf). */
+template <>
+struct std::formatter<NetworkInterface>
+{
+    constexpr auto parse(std::format_parse_context& ctx) {
+        if (ctx.begin() != ctx.end() && *ctx.begin() != '}') {
+            throw std::format_error("invalid format spec for NetworkInterface");
+        }
+
+        return ctx.begin();
+    }
+
+    template <typename FormatContext>
+    auto format(NetworkInterface const& intf, FormatContext& ctx) const {
+        auto const& name = intf.getName();
+        return std::copy(name.begin(), name.end(), ctx.out());
+    }
+};
+#endif
@@ -0,0 +1,128 @@
+//
+//  NetworkInterface_bench.cpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <thread>
+
+#include <net/if.h>
+
+#include "NetworkInterface.hpp"
+
+namespace
+{
+// the loopback interface exists on every machine the benchmarks run on
+NetworkInterface const& loopback() {
+    static auto const intf = *NetworkInterface::fromString("lo");
+    return intf;
+}
+
+int const kMaxThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+void setScalingCounters(benchmark::State& state) {
+    state.SetItemsProcessed(state.iterations());
+    state.counters["ops_per_thread"] = benchmark::Counter(static_cast<double>(state.iterations()),
+                                                          benchmark::Counter::kIsRate | benchmark::Counter::kAvgThreads);
+}
+}
+
+//===============================================================
+static void BM_GetAllInterfaces(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(NetworkInterface::getAllInterfaces());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GetAllInterfaces);
+
+static void BM_InterfaceFromString(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(NetworkInterface::fromString("lo"));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_InterfaceFromString);
+
+static void BM_InterfaceFromIntfIndex(benchmark::State& state) {
+    auto const index = loopback().getIndex();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(NetworkInterface::fromIntfIndex(index));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_InterfaceFromIntfIndex);
+
+static void BM_Baseline_IfNameToIndex(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(::if_nametoindex("lo"));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Baseline_IfNameToIndex);
+
+static void BM_GetAddresses(benchmark::State& state) {
+    auto const& intf = loopback();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(intf.getAddresses());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GetAddresses);
+
+static void BM_FindAddress(benchmark::State& state) {
+    auto const& intf = loopback();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(intf.findAddress(NetworkAddress::Family::unspecified, [] (NetworkAddress const&) { return true; }));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FindAddress);
+
+static void BM_GetIPAddress(benchmark::State& state) {
+    auto const& intf = loopback();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(intf.getIPAddress());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GetIPAddress);
+
+//===============================================================
+// Thread scaling
+static void BM_Scaling_InterfaceFromString(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(NetworkInterface::fromString("lo"));
+    }
+
+    setScalingCounters(state);
+}
+BENCHMARK(BM_Scaling_InterfaceFromString)->ThreadRange(1, kMaxThreads)->UseRealTime();
+
+static void BM_Scaling_InterfaceFromIntfIndex(benchmark::State& state) {
+    auto const index = loopback().getIndex();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(NetworkInterface::fromIntfIndex(index));
+    }
+
+    setScalingCounters(state);
+}
+BENCHMARK(BM_Scaling_InterfaceFromIntfIndex)->ThreadRange(1, kMaxThreads)->UseRealTime();
@@ -10,6 +10,8 @@
 //  14467 Potsdam, Germany
 //
 #include <gtest/gtest.h>
+#include <netinet/in.h>
+
 #include "NetworkInterface.hpp"
 
 // Test creating an invalid NetworkInterface
@@ -68,3 +70,71 @@ TEST(NetworkInterfaceTest, GetNameInvalidInterface) {
     NetworkInterface intf;
     EXPECT_EQ(intf.getName(), "");
 }
+
+// Test that the visitors enumerate the same as the vector-returning getters
+TEST(NetworkInterfaceTest, ForEachMatchesGetters) {
+    std::vector<NetworkInterface> intfs;
+    NetworkInterface::forEachInterface([&intfs] (NetworkInterface const& intf) { intfs.push_back(intf); });
+    EXPECT_EQ(intfs, NetworkInterface::getAllInterfaces());
+
+    for (auto const& intf : intfs) {
+        std::vector<NetworkAddress> addrs;
+        intf.forEachAddress(NetworkAddress::Family::unspecified, [&addrs] (NetworkAddress const& addr) { addrs.push_back(addr); });
+        EXPECT_EQ(addrs, intf.getAddresses());
+    }
+}
+
+// Test that returning false from a visitor stops the enumeration
+TEST(NetworkInterfaceTest, ForEachStopsEarly) {
+    if (NetworkInterface::getAllInterfaces().empty()) {
+        GTEST_SKIP() << "no network interfaces";
+    }
+
+    int calls = 0;
+    NetworkInterface::forEachInterface([&calls] (NetworkInterface const&) { ++calls; return false; });
+    EXPECT_EQ(calls, 1);
+}
+
+// Test that const visitors can be passed
+TEST(NetworkInterfaceTest, ForEachAcceptsConstVisitors) {
+    std::size_t interfaces = 0, addresses = 0;
+    auto const countAddress = [&addresses] (NetworkAddress const&) { ++addresses; };
+    auto const countInterface = [&interfaces, &countAddress] (NetworkInterface const& intf) {
+        ++interfaces;
+        intf.forEachAddress(NetworkAddress::Family::unspecified, countAddress);
+    };
+
+    NetworkInterface::forEachInterface(countInterface);
+    EXPECT_EQ(interfaces, NetworkInterface::getAllInterfaces().size());
+
+    std::size_t expected = 0;
+    for (auto const& intf : NetworkInterface::getAllInterfaces()) {
+        expected += intf.getAddresses().size();
+    }
+
+    EXPECT_EQ(addresses, expected);
+}
+
+// Test finding the IPv4 loopback address
+TEST(NetworkInterfaceTest, FindAddress) {
+    auto const loopback = NetworkInterface::fromString("lo");
+
+    if (! loopback.has_value()) {
+        GTEST_SKIP() << "Interface 'lo' not found";
+    }
+
+    auto const addr = loopback->findAddress(NetworkAddress::Family::ipv4, [] (NetworkAddress const& a) { return a.get_sin_addr().s_addr == htonl(INADDR_LOOPBACK); });
+    ASSERT_TRUE(addr.has_value());
+    EXPECT_EQ(addr->toString(), "127.0.0.1");
+    EXPECT_EQ(loopback->getIPAddress(), addr);
+
+    EXPECT_FALSE(loopback->findAddress(NetworkAddress::Family::ipv4, [] (NetworkAddress const&) { return false; }).has_value());
+}
+
+#if defined(__cpp_lib_format)
+// Test std::format support
+TEST(NetworkInterfaceTest, StdFormat) {
+    auto const intf = *NetworkInterface::fromString("lo");
+    EXPECT_EQ(std::format("{}", intf), "lo");
+}
+#endif
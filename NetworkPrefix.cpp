@@ -0,0 +1,304 @@
+//
+//  NetworkPrefix.cpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+#include <bit>
+#include <cassert>
+#include <charconv>
+#include <cstring>
+#include <limits>
+
+#include <netinet/in.h>
+
+#include "CxxUtilities.hpp"
+#include "NetworkPrefix.hpp"
+
+namespace
+{
+using Index = AddressRange::Index;
+
+constexpr auto kMaxIndex = std::numeric_limits<Index>::max();
+
+unsigned bitWidth(Index v) noexcept {
+    auto const hi = static_cast<std::uint64_t>(v >> 64);
+    return hi != 0 ? 64u + static_cast<unsigned>(std::bit_width(hi)) : static_cast<unsigned>(std::bit_width(static_cast<std::uint64_t>(v)));
+}
+
+unsigned addressBits(NetworkAddress::Family family) noexcept {
+    switch (family) {
+    case NetworkAddress::Family::ipv4: return 32;
+    case NetworkAddress::Family::ipv6: return 128;
+    default: break;
+    }
+
+    return 0;
+}
+
+Index hostMask(unsigned bits, unsigned length) noexcept {
+    auto const hostBits = bits - length;
+    return hostBits == 0 ? 0 : (kMaxIndex >> (128 - hostBits));
+}
+
+// splitmix64 finalizer
+std::uint64_t mix64(std::uint64_t x) noexcept {
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+}
+
+//===============================================================
+AddressRange::AddressRange() = default;
+
+AddressRange::AddressRange(NetworkAddress const& first, NetworkAddress const& last) {
+    auto const bits = addressBits(first.family());
+
+    if (bits == 0 || first.family() != last.family()) {
+        return;
+    }
+
+    auto const lo = keyOf(first);
+    auto const hi = keyOf(last);
+
+    if (hi < lo) {
+        return;
+    }
+
+    prototype = first;
+    base = lo;
+    count = (hi - lo == kMaxIndex ? kMaxIndex : hi - lo + 1);
+    end_ = count;
+}
+
+Index AddressRange::keyOf(NetworkAddress const& addr) noexcept {
+    if (addr.family() == NetworkAddress::Family::ipv4) {
+        return cxxutils::byteswap(addr.get_sin_addr().s_addr);
+    }
+
+    Index key = 0;
+    for (auto octet : addr.get_sin6_addr().s6_addr) {
+        key = (key << 8) | octet;
+    }
+
+    return key;
+}
+
+void AddressRange::setKey(NetworkAddress& addr, Index key) noexcept {
+    if (addr.storage.ss.ss_family == AF_INET) {
+        addr.storage.in4.sin_addr.s_addr = cxxutils::byteswap(static_cast<std::uint32_t>(key));
+        return;
+    }
+
+    auto& octets = addr.storage.in6.sin6_addr.s6_addr;
+    for (auto i = std::size(octets); i-- > 0; key >>= 8) {
+        octets[i] = static_cast<std::uint8_t>(key);
+    }
+}
+
+// Cycle-walking Feistel network: a bijection on [0, 2^(2*half)) which is
+// re-applied until the result falls into [0, count). As the domain is at
+// most four times larger than count this takes a few rounds on average.
+Index AddressRange::permute(Index i) const noexcept {
+    if (count <= 1) {
+        return i;
+    }
+
+    auto const half = std::max(1u, (bitWidth(count - 1) + 1) / 2);
+    auto const mask = (Index(1) << half) - 1;
+    auto x = i;
+
+    do {
+        auto l = x >> half;
+        auto r = x & mask;
+
+        for (auto key : roundKeys) {
+            auto const f = Index(mix64(static_cast<std::uint64_t>(r) ^ key)) & mask;
+            auto const next = l ^ f;
+            l = r;
+            r = next;
+        }
+
+        x = (l << half) | r;
+    } while (x >= count);
+
+    return x;
+}
+
+Index AddressRange::keyAt(Index i) const noexcept {
+    return base + stride * (isShuffled ? permute(i) : i);
+}
+
+NetworkAddress AddressRange::operator[](Index i) const {
+    assert(i < size());
+    auto result = prototype;
+    setKey(result, keyAt(begin_ + i));
+    return result;
+}
+
+AddressRange::Iterator AddressRange::begin() const { return Iterator(*this, begin_); }
+AddressRange::Iterator AddressRange::end() const   { return Iterator(*this, end_); }
+
+//===============================================================
+AddressRange AddressRange::strided(Index step) const {
+    assert(step != 0);
+    auto result = *this;
+    result.stride = stride * step;
+    result.count = count / step + (count % step != 0 ? 1 : 0);
+    result.begin_ = 0;
+    result.end_ = result.count;
+    return result;
+}
+
+AddressRange AddressRange::shuffled(std::uint64_t seed) const {
+    auto result = *this;
+    result.isShuffled = true;
+
+    for (auto& key : result.roundKeys) {
+        seed += 0x9e3779b97f4a7c15ull;
+        key = mix64(seed);
+    }
+
+    result.begin_ = 0;
+    result.end_ = count;
+    return result;
+}
+
+AddressRange AddressRange::shard(Index shardIndex, Index numShards) const {
+    assert(numShards != 0 && shardIndex < numShards);
+    auto const total = size();
+    auto const quotient = total / numShards;
+    auto const remainder = total % numShards;
+
+    auto result = *this;
+    result.begin_ = begin_ + shardIndex * quotient + std::min(shardIndex, remainder);
+    result.end_ = result.begin_ + quotient + (shardIndex < remainder ? 1 : 0);
+    return result;
+}
+
+//===============================================================
+AddressRange::Iterator::Iterator(AddressRange const& r, Index pos) : range(&r), position(pos), current(r.prototype) {
+    if (position < range->end_) {
+        key = range->keyAt(position);
+        AddressRange::setKey(current, key);
+    }
+}
+
+AddressRange::Iterator& AddressRange::Iterator::operator++() {
+    if (++position < range->end_) {
+        key = range->isShuffled ? range->keyAt(position) : key + range->stride;
+        AddressRange::setKey(current, key);
+    }
+
+    return *this;
+}
+
+//===============================================================
+NetworkPrefix::NetworkPrefix() = default;
+
+NetworkPrefix::NetworkPrefix(NetworkAddress const& addr, unsigned length) {
+    auto const bits = addressBits(addr.family());
+
+    if (bits == 0 || length > bits) {
+        return;
+    }
+
+    network = addr.withPort(0);
+    prefixLength = length;
+    AddressRange::setKey(network, AddressRange::keyOf(addr) & ~hostMask(bits, length));
+}
+
+std::optional<NetworkPrefix> NetworkPrefix::fromString(std::string_view str) {
+    auto const slash = str.rfind('/');
+
+    if (slash == std::string_view::npos) {
+        return {};
+    }
+
+    auto const addr = NetworkAddress::fromIPString(str.substr(0, slash), 0, false);
+    unsigned length = 0;
+    auto const* first = str.data() + slash + 1;
+    auto const* last = str.data() + str.size();
+    auto const [ptr, ec] = std::from_chars(first, last, length);
+
+    if (! addr || first == last || ec != std::errc() || ptr != last) {
+        return {};
+    }
+
+    if (NetworkPrefix prefix(*addr, length); prefix.valid()) {
+        return prefix;
+    }
+
+    return {};
+}
+
+bool NetworkPrefix::contains(NetworkAddress const& addr) const {
+    if (! valid() || addr.family() != network.family()) {
+        return false;
+    }
+
+    auto const mask = ~hostMask(addressBits(network.family()), prefixLength);
+    return (AddressRange::keyOf(addr) & mask) == AddressRange::keyOf(network);
+}
+
+NetworkAddress NetworkPrefix::last() const {
+    if (! valid()) {
+        return {};
+    }
+
+    auto result = network;
+    AddressRange::setKey(result, AddressRange::keyOf(network) | hostMask(addressBits(network.family()), prefixLength));
+    return result;
+}
+
+AddressRange NetworkPrefix::addresses() const {
+    return valid() ? AddressRange(network, last()) : AddressRange();
+}
+
+std::string NetworkPrefix::toString() const {
+    char buffer[kMaxStringLength];
+    auto const [end, ec] = toChars(buffer, buffer + sizeof(buffer));
+    return ec == std::errc() ? std::string(buffer, end) : std::string();
+}
+
+std::pmr::string NetworkPrefix::toString(std::pmr::memory_resource* resource) const {
+    char buffer[kMaxStringLength];
+    auto const [end, ec] = toChars(buffer, buffer + sizeof(buffer));
+    return ec == std::errc() ? std::pmr::string(buffer, end, resource) : std::pmr::string(resource);
+}
+
+std::to_chars_result NetworkPrefix::toChars(char* first, char* last) const {
+    if (! valid()) {
+        return {first, std::errc::invalid_argument};
+    }
+
+    auto result = network.toChars(first, last);
+
+    if (result.ec != std::errc()) {
+        return result;
+    }
+
+    if (result.ptr == last) {
+        return {last, std::errc::value_too_large};
+    }
+
+    *result.ptr++ = '/';
+    return std::to_chars(result.ptr, last, prefixLength);
+}
+
+bool NetworkPrefix::operator==(NetworkPrefix const& o) const {
+    return prefixLength == o.prefixLength && network == o.network;
+}
+
+std::strong_ordering NetworkPrefix::operator<=>(NetworkPrefix const& o) const {
+    if (auto const r = network <=> o.network; r != 0) {
+        return r;
+    }
+
+    return prefixLength <=> o.prefixLength;
+}
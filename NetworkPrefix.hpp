@@ -0,0 +1,297 @@
+//
+//  NetworkPrefix.hpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+#pragma once
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "NetworkAddress.hpp"
+
+class NetworkPrefix;
+
+/**
+ * @class AddressRange
+ * @brief A lazy view over a contiguous range of IPv4 or IPv6 addresses.
+ *
+ * No addresses are materialized: iterating increments a 32/128-bit key
+ * and writes it into the iterator's current NetworkAddress in place.
+ * Ranges can be traversed with a stride, in a pseudo-random order (a
+ * keyed Feistel permutation, so every address is still visited exactly
+ * once) and split into disjoint shards for parallel workers.
+ */
+class AddressRange
+{
+public:
+    /** Index and size type able to hold the size of any IPv6 range. */
+    using Index = unsigned __int128;
+
+    class Iterator;
+
+    //===============================================================
+    /**
+     * @brief Default constructor.
+     *
+     * Creates an empty range.
+     */
+    AddressRange();
+
+    /**
+     * @brief Creates the range of all addresses between first and last (inclusive).
+     *
+     * The range is empty if the two addresses are not of the same IP family
+     * or if last is smaller than first. The addresses produced by the range
+     * have the port (and for IPv6 the scope) of first.
+     *
+     * @param first The first address of the range.
+     * @param last The last address of the range.
+     */
+    AddressRange(NetworkAddress const& first, NetworkAddress const& last);
+
+    //===============================================================
+    /**
+     * @brief Gets the number of addresses in the range.
+     *
+     * The size is saturated at the maximum of Index for the full IPv6
+     * address space.
+     *
+     * @return The number of addresses.
+     */
+    Index size() const noexcept { return end_ - begin_; }
+
+    /**
+     * @brief Checks if the range contains no addresses.
+     *
+     * @return True if empty, false otherwise.
+     */
+    bool empty() const noexcept { return begin_ == end_; }
+
+    /**
+     * @brief Gets the address at a position of the traversal order.
+     *
+     * @param i The position. Must be smaller than size().
+     * @return The address at position i.
+     */
+    NetworkAddress operator[](Index i) const;
+
+    Iterator begin() const;
+    Iterator end() const;
+
+    //===============================================================
+    /**
+     * @brief Creates a view visiting every step-th address of this range.
+     *
+     * Striding applies to the whole (unsharded) range and is applied
+     * before any shuffling.
+     *
+     * @param step The distance between two visited addresses. Must be non-zero.
+     * @return The strided range.
+     */
+    AddressRange strided(Index step) const;
+
+    /**
+     * @brief Creates a view visiting the addresses in a pseudo-random order.
+     *
+     * The order is a bijection determined by the seed, so each address is
+     * visited exactly once. Shuffling applies to the whole (unsharded) range.
+     *
+     * @param seed The seed of the permutation.
+     * @return The shuffled range.
+     */
+    AddressRange shuffled(std::uint64_t seed) const;
+
+    /**
+     * @brief Splits the traversal into numShards disjoint parts.
+     *
+     * The shards of a range together visit every address exactly once and
+     * differ in size by at most one.
+     *
+     * @param shardIndex The part to return.
+     * @param numShards The number of parts. Must be non-zero.
+     * @return The shard.
+     */
+    AddressRange shard(Index shardIndex, Index numShards) const;
+
+    //===============================================================
+    class Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = NetworkAddress;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = NetworkAddress const*;
+        using reference         = NetworkAddress const&;
+
+        Iterator() = default;
+
+        reference operator*() const noexcept  { return current; }
+        pointer operator->() const noexcept   { return &current; }
+        Iterator& operator++();
+        Iterator operator++(int)              { auto copy = *this; ++(*this); return copy; }
+
+        bool operator==(Iterator const& o) const noexcept { return position == o.position; }
+        bool operator!=(Iterator const& o) const noexcept { return position != o.position; }
+
+    private:
+        friend class AddressRange;
+        Iterator(AddressRange const& range, Index pos);
+
+        AddressRange const* range = nullptr;
+        Index position = 0;
+        Index key = 0;
+        NetworkAddress current;
+    };
+
+private:
+    friend class NetworkPrefix;
+    friend class AddressPool;
+
+    Index keyAt(Index i) const noexcept;
+    Index permute(Index i) const noexcept;
+    static Index keyOf(NetworkAddress const& addr) noexcept;
+    static void setKey(NetworkAddress& addr, Index key) noexcept;
+
+    NetworkAddress prototype;
+    Index base = 0, stride = 1, count = 0;
+    Index begin_ = 0, end_ = 0;
+    bool isShuffled = false;
+    std::array<std::uint64_t, 4> roundKeys = {};
+};
+
+/**
+ * @class NetworkPrefix
+ * @brief Represents an IPv4 or IPv6 network prefix such as 10.0.0.0/8.
+ */
+class NetworkPrefix
+{
+public:
+    /**
+     * @brief Default constructor.
+     *
+     * Creates an invalid NetworkPrefix object.
+     */
+    NetworkPrefix();
+
+    /**
+     * @brief Creates a prefix from an address and a prefix length.
+     *
+     * The host bits and the port of the address are cleared. The prefix is
+     * invalid if the address is not an IP address or if the length exceeds
+     * the address' number of bits.
+     *
+     * @param addr An address within the prefix.
+     * @param length The prefix length in bits.
+     */
+    NetworkPrefix(NetworkAddress const& addr, unsigned length);
+
+    /**
+     * @brief Parses a prefix in CIDR notation, e.g. "10.0.0.0/8" or "2001:db8::/32".
+     *
+     * @param str The prefix string.
+     * @return An optional NetworkPrefix.
+     */
+    static std::optional<NetworkPrefix> fromString(std::string_view str);
+
+    //===============================================================
+    /**
+     * @brief Checks if the NetworkPrefix is valid.
+     *
+     * @return True if valid, false otherwise.
+     */
+    bool valid() const noexcept { return network.valid(); }
+
+    /**
+     * @brief Gets the address family of the prefix.
+     *
+     * @return The address family.
+     */
+    NetworkAddress::Family family() const { return network.family(); }
+
+    /**
+     * @brief Gets the network address (the first address) of the prefix.
+     *
+     * @return The network address.
+     */
+    NetworkAddress const& address() const noexcept { return network; }
+
+    /**
+     * @brief Gets the prefix length.
+     *
+     * @return The prefix length in bits.
+     */
+    unsigned length() const noexcept { return prefixLength; }
+
+    /**
+     * @brief Checks if an address is within the prefix. The port is ignored.
+     *
+     * @param addr The address to check.
+     * @return True if the address is within the prefix.
+     */
+    bool contains(NetworkAddress const& addr) const;
+
+    /**
+     * @brief Gets the last address of the prefix.
+     *
+     * @return The last address.
+     */
+    NetworkAddress last() const;
+
+    /**
+     * @brief Gets a lazy view over all addresses of the prefix.
+     *
+     * @return The range of addresses.
+     */
+    AddressRange addresses() const;
+
+    /**
+     * @brief Converts the prefix to CIDR notation.
+     *
+     * @return The string representation of the prefix.
+     */
+    std::string toString() const;
+
+    /**
+     * @brief Converts the prefix to CIDR notation.
+     *
+     * @param resource The memory resource to allocate the string from.
+     * @return The string representation of the prefix.
+     */
+    std::pmr::string toString(std::pmr::memory_resource* resource) const;
+
+    /** The maximum number of characters written by toChars(). */
+    static constexpr std::size_t kMaxStringLength = NetworkAddress::kMaxStringLength + 4;
+
+    /**
+     * @brief Writes the prefix in CIDR notation into a buffer.
+     *
+     * Same output as toString() but without allocating. The output is not
+     * null-terminated.
+     *
+     * @param first The start of the buffer.
+     * @param last The end of the buffer.
+     * @return The end of the written characters, or last and
+     *         std::errc::value_too_large if the buffer is too small.
+     */
+    std::to_chars_result toChars(char* first, char* last) const;
+
+    //===============================================================
+    bool operator==(NetworkPrefix const& other) const;
+    std::strong_ordering operator<=>(NetworkPrefix const& other) const;
+
+private:
+    NetworkAddress network;
+    unsigned prefixLength = 0;
+};
@@ -0,0 +1,105 @@
+//
+//  NetworkPrefix_test.cpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+#include <gtest/gtest.h>
+#include <set>
+#include <vector>
+
+#include "NetworkPrefix.hpp"
+
+namespace
+{
+NetworkPrefix prefix(std::string const& str) {
+    return *NetworkPrefix::fromString(str);
+}
+
+std::vector<std::string> collect(AddressRange const& range) {
+    std::vector<std::string> result;
+
+    for (auto const& addr : range) {
+        result.push_back(addr.toString());
+    }
+
+    return result;
+}
+}
+
+// Test parsing and formatting of prefixes
+TEST(NetworkPrefixTest, ParsesCIDRNotation) {
+    EXPECT_EQ(prefix("10.1.2.3/8").toString(), "10.0.0.0/8");
+    EXPECT_EQ(prefix("2001:db8::1/32").toString(), "2001:db8::/32");
+    EXPECT_EQ(prefix("0.0.0.0/0").toString(), "0.0.0.0/0");
+    EXPECT_EQ(prefix("192.168.1.7/32").length(), 32u);
+
+    EXPECT_FALSE(NetworkPrefix::fromString("10.0.0.0"));
+    EXPECT_FALSE(NetworkPrefix::fromString("10.0.0.0/33"));
+    EXPECT_FALSE(NetworkPrefix::fromString("10.0.0.0/"));
+    EXPECT_FALSE(NetworkPrefix::fromString("10.0.0.0/8x"));
+    EXPECT_FALSE(NetworkPrefix::fromString("::/129"));
+    EXPECT_FALSE(NetworkPrefix::fromString("foo/8"));
+    EXPECT_FALSE(NetworkPrefix().valid());
+}
+
+// Test membership and bounds
+TEST(NetworkPrefixTest, ContainsAndLast) {
+    auto const p = prefix("172.16.0.0/12");
+    EXPECT_TRUE(p.contains(NetworkAddress(172, 16, 0, 0)));
+    EXPECT_TRUE(p.contains(NetworkAddress(172, 31, 255, 255, 80)));
+    EXPECT_FALSE(p.contains(NetworkAddress(172, 32, 0, 0)));
+    EXPECT_FALSE(p.contains(*NetworkAddress::fromIPString("::ffff:172.16.0.1", 0, false)));
+    EXPECT_EQ(p.last(), NetworkAddress(172, 31, 255, 255));
+
+    auto const v6 = prefix("fe80::/10");
+    EXPECT_TRUE(v6.contains(*NetworkAddress::fromIPString("febf::1", 0, false)));
+    EXPECT_FALSE(v6.contains(*NetworkAddress::fromIPString("fec0::1", 0, false)));
+    EXPECT_EQ(v6.last().toString(), "febf:ffff:ffff:ffff:ffff:ffff:ffff:ffff");
+
+    EXPECT_LT(prefix("10.0.0.0/8"), prefix("10.0.0.0/16"));
+    EXPECT_EQ(prefix("10.9.0.0/8"), prefix("10.0.0.0/8"));
+}
+
+// Test plain, strided and indexed traversal
+TEST(NetworkPrefixTest, IteratesAddresses) {
+    auto const range = prefix("192.168.0.252/30").addresses();
+    ASSERT_EQ(range.size(), 4u);
+    EXPECT_EQ(collect(range), (std::vector<std::string>{"192.168.0.252", "192.168.0.253", "192.168.0.254", "192.168.0.255"}));
+    EXPECT_EQ(collect(range.strided(3)), (std::vector<std::string>{"192.168.0.252", "192.168.0.255"}));
+    EXPECT_EQ(range[2].toString(), "192.168.0.254");
+
+    // crossing octet boundaries in IPv6
+    auto const v6 = AddressRange(*NetworkAddress::fromIPString("2001:db8::fffe", 0, false),
+                                 *NetworkAddress::fromIPString("2001:db8::1:1", 0, false));
+    EXPECT_EQ(collect(v6), (std::vector<std::string>{"2001:db8::fffe", "2001:db8::ffff", "2001:db8::1:0", "2001:db8::1:1"}));
+
+    EXPECT_TRUE(AddressRange(NetworkAddress(10, 0, 0, 2), NetworkAddress(10, 0, 0, 1)).empty());
+    EXPECT_EQ(prefix("::/0").addresses().size(), ~AddressRange::Index(0));
+    EXPECT_EQ(prefix("2001:db8::/64").addresses().strided(AddressRange::Index(1) << 32).size(), AddressRange::Index(1) << 32);
+}
+
+// Test that shuffling and sharding visit every address exactly once
+TEST(NetworkPrefixTest, ShuffleAndShardArePermutations) {
+    auto const range = prefix("10.20.0.0/22").addresses().strided(3).shuffled(42);
+    ASSERT_EQ(range.size(), 342u);
+
+    auto const ordered = collect(prefix("10.20.0.0/22").addresses().strided(3));
+    auto const shuffled = collect(range);
+    EXPECT_NE(ordered, shuffled);
+    EXPECT_EQ(std::set<std::string>(ordered.begin(), ordered.end()), std::set<std::string>(shuffled.begin(), shuffled.end()));
+
+    std::vector<std::string> sharded;
+    for (AddressRange::Index i = 0; i < 5; ++i) {
+        auto const part = collect(range.shard(i, 5));
+        EXPECT_GE(part.size(), 68u);
+        EXPECT_LE(part.size(), 69u);
+        sharded.insert(sharded.end(), part.begin(), part.end());
+    }
+
+    EXPECT_EQ(sharded, shuffled);
+}
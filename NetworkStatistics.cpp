@@ -0,0 +1,190 @@
+//
+//  NetworkStatistics.cpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "Instrumentation.hpp"
+#include "NetworkStatistics.hpp"
+
+#if CXXNETADDR_ENABLE_STATS
+namespace
+{
+using namespace instrumentation;
+
+//===============================================================
+// All live threads' counters plus the sum of all exited threads.
+// The mutex is only taken when a thread first uses the library, when it
+// exits and when taking a snapshot - never on the instrumented paths.
+struct Registry
+{
+    std::mutex lock;
+    std::vector<ThreadCounters*> live;
+    NetworkStatistics::Snapshot retired;
+   #if CXXNETADDR_ENABLE_HISTOGRAMS
+    std::array<LatencyHistogram, static_cast<std::size_t>(NetworkStatistics::Api::count)> retiredLatencies;
+   #endif
+
+    static Registry& get() {
+        // leaked deliberately: threads may exit after static destruction
+        static auto* registry = new Registry;
+        return *registry;
+    }
+};
+
+void accumulate(NetworkStatistics::Snapshot& dst, ThreadCounters const& src) noexcept {
+    for (std::size_t i = 0; i < dst.apis.size(); ++i) {
+        dst.apis[i].calls       += src.calls[i].load(std::memory_order_relaxed);
+        dst.apis[i].nanoseconds += src.nanoseconds[i].load(std::memory_order_relaxed);
+    }
+
+    for (std::size_t i = 0; i < dst.syscalls.size(); ++i) {
+        dst.syscalls[i] += src.syscalls[i].load(std::memory_order_relaxed);
+    }
+}
+
+#if CXXNETADDR_ENABLE_HISTOGRAMS
+void accumulate(LatencyHistogram& dst, ThreadCounters const& src, std::size_t api) noexcept {
+    for (std::size_t i = 0; i < LatencyHistogram::kNumBuckets; ++i) {
+        if (auto const n = src.latencies[api][i].load(std::memory_order_relaxed); n != 0) {
+            dst.record(LatencyHistogram::bucketLowerBound(i), n);
+        }
+    }
+}
+#endif
+
+struct ThreadRegistration
+{
+    ThreadRegistration() {
+        auto& registry = Registry::get();
+        std::lock_guard guard(registry.lock);
+        registry.live.push_back(&counters);
+    }
+
+    ~ThreadRegistration() {
+        auto& registry = Registry::get();
+        std::lock_guard guard(registry.lock);
+        accumulate(registry.retired, counters);
+
+       #if CXXNETADDR_ENABLE_HISTOGRAMS
+        for (std::size_t api = 0; api < registry.retiredLatencies.size(); ++api) {
+            accumulate(registry.retiredLatencies[api], counters, api);
+        }
+       #endif
+
+        registry.live.erase(std::find(registry.live.begin(), registry.live.end(), &counters));
+    }
+
+    ThreadCounters counters;
+};
+}
+
+instrumentation::ThreadCounters& instrumentation::threadCounters() noexcept {
+    thread_local ThreadRegistration registration;
+    return registration.counters;
+}
+#endif
+
+#if CXXNETADDR_ENABLE_USDT
+//===============================================================
+// The tracepoints' semaphores: incremented by tracers when attaching
+#define CXXNETADDR_PROBE_SEMAPHORE(name) \
+    __extension__ unsigned short cxxnetaddr_##name##_semaphore __attribute__((section(".probes"))) = 0
+
+extern "C" {
+CXXNETADDR_PROBE_SEMAPHORE(getifaddrs);
+CXXNETADDR_PROBE_SEMAPHORE(if_nametoindex);
+CXXNETADDR_PROBE_SEMAPHORE(if_indextoname);
+CXXNETADDR_PROBE_SEMAPHORE(parse);
+CXXNETADDR_PROBE_SEMAPHORE(format);
+}
+#endif
+
+//===============================================================
+NetworkStatistics::Snapshot NetworkStatistics::Snapshot::operator-(Snapshot const& earlier) const noexcept {
+    auto result = *this;
+
+    for (std::size_t i = 0; i < apis.size(); ++i) {
+        result.apis[i].calls       -= earlier.apis[i].calls;
+        result.apis[i].nanoseconds -= earlier.apis[i].nanoseconds;
+    }
+
+    for (std::size_t i = 0; i < syscalls.size(); ++i) {
+        result.syscalls[i] -= earlier.syscalls[i];
+    }
+
+    return result;
+}
+
+NetworkStatistics::Snapshot NetworkStatistics::snapshot() {
+    Snapshot result;
+
+   #if CXXNETADDR_ENABLE_STATS
+    auto& registry = Registry::get();
+    std::lock_guard guard(registry.lock);
+    result = registry.retired;
+
+    for (auto const* counters : registry.live) {
+        accumulate(result, *counters);
+    }
+   #endif
+
+    return result;
+}
+
+LatencyHistogram NetworkStatistics::latency([[maybe_unused]] Api api) {
+    LatencyHistogram result;
+
+   #if CXXNETADDR_ENABLE_HISTOGRAMS
+    auto const index = static_cast<std::size_t>(api);
+    auto& registry = Registry::get();
+    std::lock_guard guard(registry.lock);
+    result = registry.retiredLatencies[index];
+
+    for (auto const* counters : registry.live) {
+        accumulate(result, *counters, index);
+    }
+   #endif
+
+    return result;
+}
+
+char const* NetworkStatistics::name(Api api) noexcept {
+    switch (api) {
+    case Api::interfaceGetAll:       return "interface_get_all";
+    case Api::interfaceGetType:      return "interface_get_type";
+    case Api::interfaceGetIPAddress: return "interface_get_ip_address";
+    case Api::interfaceGetAddresses: return "interface_get_addresses";
+    case Api::interfaceFromString:   return "interface_from_string";
+    case Api::interfaceFromIndex:    return "interface_from_index";
+    case Api::interfaceGetIndex:     return "interface_get_index";
+    case Api::addressFromIPString:   return "address_from_ip_string";
+    case Api::addressFromMACString:  return "address_from_mac_string";
+    case Api::addressToChars:        return "address_to_chars";
+    default: break;
+    }
+
+    return "unknown";
+}
+
+char const* NetworkStatistics::name(Syscall syscall) noexcept {
+    switch (syscall) {
+    case Syscall::getifaddrs:    return "getifaddrs";
+    case Syscall::ifNameToIndex: return "if_nametoindex";
+    case Syscall::ifIndexToName: return "if_indextoname";
+    case Syscall::socket:        return "socket";
+    case Syscall::ioctl:         return "ioctl";
+    default: break;
+    }
+
+    return "unknown";
+}
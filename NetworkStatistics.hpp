@@ -0,0 +1,138 @@
+//
+//  NetworkStatistics.hpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "LatencyHistogram.hpp"
+
+#ifndef CXXNETADDR_ENABLE_STATS
+ #define CXXNETADDR_ENABLE_STATS 0
+#endif
+
+#ifndef CXXNETADDR_ENABLE_HISTOGRAMS
+ #define CXXNETADDR_ENABLE_HISTOGRAMS 0
+#endif
+
+#if CXXNETADDR_ENABLE_HISTOGRAMS && ! CXXNETADDR_ENABLE_STATS
+ #error "CXXNETADDR_ENABLE_HISTOGRAMS requires CXXNETADDR_ENABLE_STATS"
+#endif
+
+/**
+ * @class NetworkStatistics
+ * @brief Call counts, syscall counts and cumulative time spent in the
+ *        library's APIs.
+ *
+ * Statistics are only collected if the library is built with the CMake
+ * option CXXNETADDR_ENABLE_STATS. Otherwise all counters stay zero and
+ * the instrumentation compiles to nothing.
+ *
+ * Each thread increments its own relaxed counters; snapshot() sums the
+ * counters of all threads, including threads which have already exited.
+ *
+ * With the CMake option CXXNETADDR_ENABLE_HISTOGRAMS (which implies
+ * CXXNETADDR_ENABLE_STATS) the duration of every call is additionally
+ * recorded in a per-thread LatencyHistogram per API, exposing the tail
+ * latencies which the cumulative times hide.
+ */
+class NetworkStatistics
+{
+public:
+    /** True if the library was built with statistics enabled. */
+    static constexpr bool enabled = (CXXNETADDR_ENABLE_STATS != 0);
+
+    /** True if the library was built with latency histograms enabled. */
+    static constexpr bool histogramsEnabled = (CXXNETADDR_ENABLE_HISTOGRAMS != 0);
+
+    //===============================================================
+    /**
+     * @enum Api
+     * @brief The instrumented APIs.
+     */
+    enum class Api : std::size_t
+    {
+        interfaceGetAll,       /**< NetworkInterface::getAllInterfaces and forEachInterface */
+        interfaceGetType,      /**< NetworkInterface::getType */
+        interfaceGetIPAddress, /**< NetworkInterface::getIPAddress */
+        interfaceGetAddresses, /**< Address enumeration: NetworkInterface::getAddresses, forEachAddress, findAddress, getIPAddress and getMACAddress */
+        interfaceFromString,   /**< NetworkInterface::fromString */
+        interfaceFromIndex,    /**< NetworkInterface::fromIntfIndex */
+        interfaceGetIndex,     /**< NetworkInterface::getIndex */
+        addressFromIPString,   /**< NetworkAddress::fromIPString */
+        addressFromMACString,  /**< NetworkAddress::fromMACString */
+        addressToChars,        /**< NetworkAddress::toChars and toString */
+        count
+    };
+
+    /**
+     * @enum Syscall
+     * @brief The expensive system and C library calls made by the library.
+     */
+    enum class Syscall : std::size_t
+    {
+        getifaddrs,
+        ifNameToIndex,
+        ifIndexToName,
+        socket,
+        ioctl,
+        count
+    };
+
+    struct ApiStats
+    {
+        std::uint64_t calls = 0;
+        std::uint64_t nanoseconds = 0;
+    };
+
+    /** A point-in-time copy of all counters. */
+    struct Snapshot
+    {
+        std::array<ApiStats, static_cast<std::size_t>(Api::count)> apis = {};
+        std::array<std::uint64_t, static_cast<std::size_t>(Syscall::count)> syscalls = {};
+
+        ApiStats const& operator[](Api api) const noexcept { return apis[static_cast<std::size_t>(api)]; }
+        std::uint64_t operator[](Syscall syscall) const noexcept { return syscalls[static_cast<std::size_t>(syscall)]; }
+
+        /** The counters accumulated between an earlier snapshot and this one. */
+        Snapshot operator-(Snapshot const& earlier) const noexcept;
+    };
+
+    //===============================================================
+    /**
+     * @brief Sums the counters of all threads.
+     *
+     * @return The current statistics.
+     */
+    static Snapshot snapshot();
+
+    /**
+     * @brief Merges the latency histograms of an API of all threads.
+     *
+     * Histograms of two calls can be subtracted to get the latencies
+     * recorded in between.
+     *
+     * @param api The API.
+     * @return The durations of all calls in nanoseconds (empty if
+     *         histograms are disabled).
+     */
+    static LatencyHistogram latency(Api api);
+
+    /**
+     * @brief Gets a stable name for an API, e.g. for exporting metrics.
+     */
+    static char const* name(Api api) noexcept;
+
+    /**
+     * @brief Gets a stable name for a syscall, e.g. for exporting metrics.
+     */
+    static char const* name(Syscall syscall) noexcept;
+};
@@ -0,0 +1,82 @@
+//
+//  NetworkStatistics_test.cpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+#include <gtest/gtest.h>
+#include <set>
+#include <string>
+#include <thread>
+
+#include "NetworkInterface.hpp"
+#include "NetworkStatistics.hpp"
+
+using Api = NetworkStatistics::Api;
+using Syscall = NetworkStatistics::Syscall;
+
+// Test that every counter has a distinct name for exporting
+TEST(NetworkStatisticsTest, NamesAreUnique) {
+    std::set<std::string> names;
+
+    for (std::size_t i = 0; i < static_cast<std::size_t>(Api::count); ++i) {
+        names.insert(NetworkStatistics::name(static_cast<Api>(i)));
+    }
+
+    for (std::size_t i = 0; i < static_cast<std::size_t>(Syscall::count); ++i) {
+        names.insert(NetworkStatistics::name(static_cast<Syscall>(i)));
+    }
+
+    EXPECT_EQ(names.size(), static_cast<std::size_t>(Api::count) + static_cast<std::size_t>(Syscall::count));
+    EXPECT_EQ(names.count("unknown"), 0u);
+}
+
+// Test that API calls and syscalls are counted (or nothing if disabled)
+TEST(NetworkStatisticsTest, CountsCallsAndSyscalls) {
+    auto const before = NetworkStatistics::snapshot();
+
+    for (int i = 0; i < 3; ++i) {
+        (void) NetworkAddress::fromIPString("192.168.0.1:80");
+    }
+
+    (void) NetworkAddress(10, 0, 0, 1).toString();
+    (void) NetworkInterface::getAllInterfaces();
+    (void) NetworkInterface::fromString("lo");
+
+    auto const diff = NetworkStatistics::snapshot() - before;
+
+    if constexpr (! NetworkStatistics::enabled) {
+        EXPECT_EQ(diff[Api::addressFromIPString].calls, 0u);
+        EXPECT_EQ(NetworkStatistics::snapshot()[Syscall::getifaddrs], 0u);
+        return;
+    }
+
+    EXPECT_EQ(diff[Api::addressFromIPString].calls, 3u);
+    EXPECT_GT(diff[Api::addressFromIPString].nanoseconds, 0u);
+    EXPECT_EQ(diff[Api::addressToChars].calls, 1u);
+    EXPECT_EQ(diff[Api::interfaceGetAll].calls, 1u);
+    EXPECT_EQ(diff[Api::interfaceFromString].calls, 1u);
+    EXPECT_EQ(diff[Syscall::getifaddrs], 1u);
+    EXPECT_GE(diff[Syscall::ifNameToIndex], 1u);
+}
+
+// Test that the counters of exited threads are kept
+TEST(NetworkStatisticsTest, AggregatesExitedThreads) {
+    if constexpr (! NetworkStatistics::enabled) {
+        GTEST_SKIP() << "library built without CXXNETADDR_ENABLE_STATS";
+    }
+
+    auto const before = NetworkStatistics::snapshot();
+
+    std::thread([] {
+        for (int i = 0; i < 100; ++i) {
+            (void) NetworkAddress::fromMACString("00:1A:2B:3C:4D:5E");
+        }
+    }).join();
+
+    EXPECT_EQ((NetworkStatistics::snapshot() - before)[Api::addressFromMACString].calls, 100u);
+}
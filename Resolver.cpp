@@ -0,0 +1,784 @@
+//
+//  Resolver.cpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+
+#if __linux__
+ #include <sys/inotify.h>
+#endif
+
+#include "CxxUtilities.hpp"
+#include "Resolver.hpp"
+
+namespace
+{
+//===============================================================
+// DNS wire format (RFC 1035)
+constexpr std::uint16_t kTypeA    = 1;
+constexpr std::uint16_t kTypeAAAA = 28;
+constexpr std::uint16_t kClassIN  = 1;
+
+constexpr std::uint16_t kFlagResponse  = 0x8000;
+constexpr std::uint16_t kFlagTruncated = 0x0200;
+
+constexpr std::uint8_t kRcodeNoError  = 0;
+constexpr std::uint8_t kRcodeNXDomain = 3;
+
+constexpr std::size_t kHeaderSize = 12;
+constexpr std::size_t kMaxPacketSize = 1500;
+constexpr std::size_t kMaxNameLength = 255;
+constexpr std::size_t kNumCacheShards = 16;
+
+std::string toLower(std::string_view str) {
+    std::string result(str);
+    std::transform(result.begin(), result.end(), result.begin(), [] (unsigned char c) {
+        return static_cast<char>((c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c);
+    });
+
+    // a fully qualified name with a trailing dot is the same name
+    if (result.size() > 1 && result.back() == '.') {
+        result.pop_back();
+    }
+
+    return result;
+}
+
+void put16(std::vector<std::uint8_t>& packet, std::uint16_t value) {
+    packet.push_back(static_cast<std::uint8_t>(value >> 8));
+    packet.push_back(static_cast<std::uint8_t>(value & 0xff));
+}
+
+std::uint16_t get16(std::uint8_t const* p) { return static_cast<std::uint16_t>((p[0] << 8) | p[1]); }
+std::uint32_t get32(std::uint8_t const* p) { return (std::uint32_t(get16(p)) << 16) | get16(p + 2); }
+
+std::optional<std::vector<std::uint8_t>> encodeQuery(std::uint16_t id, std::string const& name, std::uint16_t qtype) {
+    if (name.empty() || name.size() > kMaxNameLength) {
+        return {};
+    }
+
+    std::vector<std::uint8_t> packet;
+    packet.reserve(kHeaderSize + name.size() + 6);
+
+    put16(packet, id);
+    put16(packet, 0x0100); // standard query, recursion desired
+    put16(packet, 1);      // qdcount
+    put16(packet, 0);
+    put16(packet, 0);
+    put16(packet, 0);
+
+    for (std::size_t start = 0; start < name.size();) {
+        auto end = name.find('.', start);
+        end = (end == std::string::npos ? name.size() : end);
+
+        auto const len = end - start;
+        if (len == 0 || len > 63) {
+            return {};
+        }
+
+        packet.push_back(static_cast<std::uint8_t>(len));
+        packet.insert(packet.end(), name.begin() + static_cast<std::ptrdiff_t>(start), name.begin() + static_cast<std::ptrdiff_t>(end));
+        start = end + 1;
+    }
+
+    packet.push_back(0);
+    put16(packet, qtype);
+    put16(packet, kClassIN);
+
+    return packet;
+}
+
+// Reads a (possibly compressed) domain name starting at offset. Returns the
+// offset just past the name in the original position of the packet.
+std::optional<std::size_t> readName(std::span<std::uint8_t const> packet, std::size_t offset, std::string* name) {
+    std::optional<std::size_t> end;
+
+    // bound the number of pointers we follow to guard against loops
+    for (int hops = 0; hops < 64; ++hops) {
+        if (offset >= packet.size()) {
+            return {};
+        }
+
+        auto const len = packet[offset];
+
+        if ((len & 0xc0) == 0xc0) {
+            if (offset + 1 >= packet.size()) {
+                return {};
+            }
+
+            if (! end) {
+                end = offset + 2;
+            }
+
+            offset = static_cast<std::size_t>(((len & 0x3f) << 8) | packet[offset + 1]);
+            continue;
+        }
+
+        if (len == 0) {
+            return end ? *end : offset + 1;
+        }
+
+        if (offset + 1 + len > packet.size()) {
+            return {};
+        }
+
+        if (name != nullptr) {
+            if (! name->empty()) {
+                name->push_back('.');
+            }
+
+            name->append(reinterpret_cast<char const*>(packet.data() + offset + 1), len);
+        }
+
+        offset += 1u + len;
+    }
+
+    return {};
+}
+
+struct Reply
+{
+    std::uint16_t id;
+    std::uint8_t rcode;
+    bool truncated;
+    std::string qname;
+    std::uint16_t qtype;
+    std::vector<NetworkAddress> addresses;
+    std::uint32_t ttl;
+};
+
+std::optional<Reply> parseReply(std::span<std::uint8_t const> packet) {
+    if (packet.size() < kHeaderSize) {
+        return {};
+    }
+
+    Reply reply = {};
+    reply.id = get16(packet.data());
+    reply.ttl = std::numeric_limits<std::uint32_t>::max();
+
+    auto const flags = get16(packet.data() + 2);
+    auto const qdcount = get16(packet.data() + 4);
+    auto const ancount = get16(packet.data() + 6);
+
+    if ((flags & kFlagResponse) == 0 || qdcount != 1) {
+        return {};
+    }
+
+    reply.rcode = static_cast<std::uint8_t>(flags & 0x000f);
+    reply.truncated = (flags & kFlagTruncated) != 0;
+
+    auto offset = readName(packet, kHeaderSize, &reply.qname);
+    if (! offset || *offset + 4 > packet.size()) {
+        return {};
+    }
+
+    reply.qname = toLower(reply.qname);
+    reply.qtype = get16(packet.data() + *offset);
+    *offset += 4;
+
+    for (std::uint16_t i = 0; i < ancount; ++i) {
+        offset = readName(packet, *offset, nullptr);
+
+        if (! offset || *offset + 10 > packet.size()) {
+            return {};
+        }
+
+        auto const* rr = packet.data() + *offset;
+        auto const type = get16(rr);
+        auto const cls = get16(rr + 2);
+        auto const ttl = get32(rr + 4);
+        auto const rdlength = get16(rr + 8);
+        auto const* rdata = rr + 10;
+
+        *offset += 10u + rdlength;
+        if (*offset > packet.size()) {
+            return {};
+        }
+
+        if (cls != kClassIN || type != reply.qtype) {
+            // CNAMEs are followed by the server; we only need the final records
+            continue;
+        }
+
+        if (type == kTypeA && rdlength == 4) {
+            reply.addresses.emplace_back(std::span<std::uint8_t const, 4>(rdata, 4));
+        } else if (type == kTypeAAAA && rdlength == 16) {
+            std::array<std::uint16_t, 8> words;
+            for (std::size_t w = 0; w < words.size(); ++w) {
+                words[w] = get16(rdata + 2 * w);
+            }
+
+            reply.addresses.emplace_back(words);
+        } else {
+            continue;
+        }
+
+        reply.ttl = std::min(reply.ttl, ttl);
+    }
+
+    return reply;
+}
+
+//===============================================================
+bool matchesFamily(NetworkAddress const& addr, NetworkAddress::Family family) {
+    return family == NetworkAddress::Family::unspecified || addr.family() == family;
+}
+
+std::shared_future<std::vector<NetworkAddress>> readyFuture(std::vector<NetworkAddress> addresses) {
+    std::promise<std::vector<NetworkAddress>> promise;
+    promise.set_value(std::move(addresses));
+    return promise.get_future().share();
+}
+
+std::vector<NetworkAddress> readNameServers() {
+    std::vector<NetworkAddress> result;
+    std::ifstream file("/etc/resolv.conf");
+
+    for (std::string line; std::getline(file, line);) {
+        std::istringstream ss(line);
+        std::string keyword, server;
+
+        if (ss >> keyword >> server && keyword == "nameserver") {
+            if (auto addr = NetworkAddress::fromIPString(server, 53, false); addr.has_value()) {
+                result.emplace_back(*addr);
+            }
+        }
+    }
+
+    return result;
+}
+
+int makeNonBlocking(int fd) {
+    if (fd >= 0) {
+        ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+        ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+    }
+
+    return fd;
+}
+}
+
+//===============================================================
+struct Resolver::Impl
+{
+    using Clock = std::chrono::steady_clock;
+    using Result = std::vector<NetworkAddress>;
+    using HostsMap = std::unordered_map<std::string, Result>;
+
+    struct CacheEntry
+    {
+        Result addresses;
+        Clock::time_point expiry;
+    };
+
+    struct Shard
+    {
+        std::mutex mutex;
+        std::unordered_map<std::string, CacheEntry> entries;
+    };
+
+    struct Lookup
+    {
+        std::string key;
+        std::string name;
+        NetworkAddress::Family family;
+        std::promise<Result> promise;
+        Result addresses = {};
+        std::uint32_t ttl = std::numeric_limits<std::uint32_t>::max();
+        unsigned pending = 0;
+        bool failed = false;
+    };
+
+    struct Query
+    {
+        std::shared_ptr<Lookup> lookup;
+        std::uint16_t qtype;
+        std::vector<std::uint8_t> packet;
+        std::size_t tries;
+        Clock::time_point deadline;
+    };
+
+    //===============================================================
+    Impl(Options opts) : options(std::move(opts)) {
+        if (options.servers.empty()) {
+            options.servers = readNameServers();
+        }
+
+        for (auto& server : options.servers) {
+            if (server.port() == 0) {
+                server = server.withPort(53);
+            }
+        }
+
+        loadHosts();
+
+        int fds[2];
+        if (::pipe(fds) == 0) {
+            wakeRead = makeNonBlocking(fds[0]);
+            wakeWrite = makeNonBlocking(fds[1]);
+        }
+
+       #if __linux__
+        if (! options.hostsFile.empty()) {
+            auto const slash = options.hostsFile.rfind('/');
+            auto const dir = (slash == std::string::npos ? std::string(".") : options.hostsFile.substr(0, std::max<std::size_t>(slash, 1)));
+            hostsBasename = (slash == std::string::npos ? options.hostsFile : options.hostsFile.substr(slash + 1));
+
+            inotifyFd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+            if (inotifyFd >= 0 && ::inotify_add_watch(inotifyFd, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE) < 0) {
+                ::close(inotifyFd);
+                inotifyFd = -1;
+            }
+        }
+       #endif
+
+        worker = std::thread([this] { run(); });
+    }
+
+    ~Impl() {
+        shouldExit = true;
+        wake();
+        worker.join();
+
+        for (auto fd : {wakeRead, wakeWrite, sock4, sock6, inotifyFd}) {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+        }
+    }
+
+    //===============================================================
+    std::shared_future<Result> resolve(std::string const& hostname, NetworkAddress::Family family) {
+        if (auto literal = NetworkAddress::fromIPString(hostname, 0, false); literal.has_value()) {
+            return readyFuture(matchesFamily(*literal, family) ? Result {*literal} : Result {});
+        }
+
+        auto const name = toLower(hostname);
+
+        if (auto fromHosts = lookupHosts(name, family); ! fromHosts.empty()) {
+            return readyFuture(std::move(fromHosts));
+        }
+
+        auto key = name + '/' + std::to_string(static_cast<int>(family));
+
+        if (auto cached = lookupCache(key); cached.has_value()) {
+            return readyFuture(std::move(*cached));
+        }
+
+        if (options.servers.empty() || name.size() > kMaxNameLength) {
+            return readyFuture({});
+        }
+
+        std::lock_guard<std::mutex> lock(inflightMutex);
+
+        if (auto it = inflight.find(key); it != inflight.end()) {
+            return it->second;
+        }
+
+        auto lookup = std::make_shared<Lookup>();
+        lookup->key = key;
+        lookup->name = name;
+        lookup->family = family;
+
+        auto future = lookup->promise.get_future().share();
+        inflight.emplace(std::move(key), future);
+
+        {
+            std::lock_guard<std::mutex> queueLock(queueMutex);
+            queue.emplace_back(std::move(lookup));
+        }
+
+        wake();
+        return future;
+    }
+
+    void flush() {
+        for (auto& shard : cache) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.entries.clear();
+        }
+    }
+
+private:
+    //===============================================================
+    Shard& shardFor(std::string const& key) { return cache[std::hash<std::string>()(key) % cache.size()]; }
+
+    std::optional<Result> lookupCache(std::string const& key) {
+        auto& shard = shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        if (auto it = shard.entries.find(key); it != shard.entries.end()) {
+            if (it->second.expiry > Clock::now()) {
+                return it->second.addresses;
+            }
+
+            shard.entries.erase(it);
+        }
+
+        return {};
+    }
+
+    void insertCache(std::string const& key, Result const& addresses, std::chrono::seconds ttl) {
+        auto& shard = shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.entries.insert_or_assign(key, CacheEntry {addresses, Clock::now() + ttl});
+    }
+
+    //===============================================================
+    Result lookupHosts(std::string const& name, NetworkAddress::Family family) const {
+        std::shared_lock<std::shared_mutex> lock(hostsMutex);
+        Result result;
+
+        if (auto it = hosts.find(name); it != hosts.end()) {
+            std::copy_if(it->second.begin(), it->second.end(), std::back_inserter(result), [family] (auto const& addr) {
+                return matchesFamily(addr, family);
+            });
+        }
+
+        return result;
+    }
+
+    void loadHosts() {
+        HostsMap parsed;
+
+        if (! options.hostsFile.empty()) {
+            std::ifstream file(options.hostsFile);
+
+            for (std::string line; std::getline(file, line);) {
+                line = line.substr(0, line.find('#'));
+
+                std::istringstream ss(line);
+                std::string ip;
+
+                if (! (ss >> ip)) {
+                    continue;
+                }
+
+                auto const addr = NetworkAddress::fromIPString(ip, 0, false);
+
+                if (! addr.has_value()) {
+                    continue;
+                }
+
+                for (std::string name; ss >> name;) {
+                    auto& entry = parsed[toLower(name)];
+
+                    if (std::find(entry.begin(), entry.end(), *addr) == entry.end()) {
+                        entry.emplace_back(*addr);
+                    }
+                }
+            }
+        }
+
+        std::unique_lock<std::shared_mutex> lock(hostsMutex);
+        hosts = std::move(parsed);
+    }
+
+    void handleHostsChange() {
+       #if __linux__
+        alignas(::inotify_event) char buffer[4096];
+        auto changed = false;
+
+        for (ssize_t n; (n = ::read(inotifyFd, buffer, sizeof(buffer))) > 0;) {
+            for (ssize_t pos = 0; pos < n;) {
+                auto const* event = reinterpret_cast<::inotify_event const*>(buffer + pos);
+                changed |= (event->len > 0 && hostsBasename == event->name);
+                pos += static_cast<ssize_t>(sizeof(::inotify_event) + event->len);
+            }
+        }
+
+        if (changed) {
+            loadHosts();
+        }
+       #endif
+    }
+
+    //===============================================================
+    void wake() {
+        char const c = 0;
+        [[maybe_unused]] auto _ = ::write(wakeWrite, &c, 1);
+    }
+
+    int socketFor(NetworkAddress const& server) {
+        auto& fd = (server.family() == NetworkAddress::Family::ipv6 ? sock6 : sock4);
+
+        if (fd < 0) {
+            fd = makeNonBlocking(::socket(server.posixFamily(), SOCK_DGRAM, 0));
+        }
+
+        return fd;
+    }
+
+    std::uint16_t nextId() {
+        std::uint16_t id;
+
+        do {
+            id = static_cast<std::uint16_t>(rng());
+        } while (outstanding.contains(id));
+
+        return id;
+    }
+
+    void send(std::uint16_t id, Query& query) {
+        auto const& server = options.servers[query.tries % options.servers.size()];
+        query.deadline = Clock::now() + options.timeout;
+        ++query.tries;
+
+        query.packet[0] = static_cast<std::uint8_t>(id >> 8);
+        query.packet[1] = static_cast<std::uint8_t>(id & 0xff);
+
+        if (auto const fd = socketFor(server); fd >= 0) {
+            // a failing send is treated like a timeout
+            ::sendto(fd, query.packet.data(), query.packet.size(), 0, &server.socket(), server.socketLength());
+        }
+    }
+
+    void start(std::shared_ptr<Lookup> lookup) {
+        auto const wantsV4 = lookup->family != NetworkAddress::Family::ipv6;
+        auto const wantsV6 = lookup->family != NetworkAddress::Family::ipv4;
+
+        for (auto qtype : {kTypeA, kTypeAAAA}) {
+            if ((qtype == kTypeA && ! wantsV4) || (qtype == kTypeAAAA && ! wantsV6)) {
+                continue;
+            }
+
+            auto packet = encodeQuery(0, lookup->name, qtype);
+            if (! packet) {
+                continue;
+            }
+
+            auto const id = nextId();
+            auto [it, _] = outstanding.emplace(id, Query {lookup, qtype, std::move(*packet), 0, {}});
+            ++lookup->pending;
+            send(id, it->second);
+        }
+
+        if (lookup->pending == 0) {
+            finish(*lookup);
+        }
+    }
+
+    void complete(Lookup& lookup) {
+        if (--lookup.pending == 0) {
+            finish(lookup);
+        }
+    }
+
+    void finish(Lookup& lookup) {
+        if (! lookup.failed) {
+            auto const ttl = lookup.addresses.empty() ? options.negativeTTL
+                                                      : std::min(std::chrono::seconds(lookup.ttl), options.maxTTL);
+            insertCache(lookup.key, lookup.addresses, ttl);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(inflightMutex);
+            inflight.erase(lookup.key);
+        }
+
+        lookup.promise.set_value(std::move(lookup.addresses));
+    }
+
+    void receive(int fd) {
+        std::array<std::uint8_t, kMaxPacketSize> buffer;
+
+        ::sockaddr_storage from;
+        ::socklen_t fromLength = sizeof(from);
+
+        for (ssize_t n; (n = ::recvfrom(fd, buffer.data(), buffer.size(), 0, reinterpret_cast<::sockaddr*>(&from), &fromLength)) > 0;
+             fromLength = sizeof(from)) {
+            auto const reply = parseReply(std::span<std::uint8_t const>(buffer.data(), static_cast<std::size_t>(n)));
+            if (! reply) {
+                continue;
+            }
+
+            auto it = outstanding.find(reply->id);
+            if (it == outstanding.end() || it->second.qtype != reply->qtype || it->second.lookup->name != reply->qname) {
+                continue;
+            }
+
+            auto& query = it->second;
+
+            // only accept replies from the server the query was last sent to
+            auto const& server = options.servers[(query.tries - 1) % options.servers.size()];
+            if (NetworkAddress::fromPOSIXSocketAddress(*reinterpret_cast<::sockaddr const*>(&from), fromLength) != server) {
+                continue;
+            }
+
+            if (reply->rcode != kRcodeNoError && reply->rcode != kRcodeNXDomain) {
+                // SERVFAIL, REFUSED etc.: move on to the next server immediately
+                query.deadline = Clock::time_point();
+                continue;
+            }
+
+            auto lookup = std::move(query.lookup);
+            outstanding.erase(it);
+
+            // there is no TCP fallback: fail instead of using a partial answer
+            if (reply->truncated) {
+                lookup->failed = true;
+                complete(*lookup);
+                continue;
+            }
+
+            lookup->addresses.insert(lookup->addresses.end(), reply->addresses.begin(), reply->addresses.end());
+            if (! reply->addresses.empty()) {
+                lookup->ttl = std::min(lookup->ttl, reply->ttl);
+            }
+
+            complete(*lookup);
+        }
+    }
+
+    void handleTimeouts() {
+        auto const now = Clock::now();
+        auto const maxTries = options.servers.size() * std::max(options.attempts, 1u);
+
+        for (auto it = outstanding.begin(); it != outstanding.end();) {
+            auto& query = it->second;
+
+            if (query.deadline > now) {
+                ++it;
+                continue;
+            }
+
+            if (query.tries < maxTries) {
+                send(it->first, query);
+                ++it;
+                continue;
+            }
+
+            auto lookup = std::move(query.lookup);
+            it = outstanding.erase(it);
+
+            lookup->failed = true;
+            complete(*lookup);
+        }
+    }
+
+    int pollTimeout() const {
+        if (outstanding.empty()) {
+            return -1;
+        }
+
+        auto const next = std::min_element(outstanding.begin(), outstanding.end(), [] (auto const& a, auto const& b) {
+            return a.second.deadline < b.second.deadline;
+        })->second.deadline;
+
+        auto const ms = std::chrono::ceil<std::chrono::milliseconds>(next - Clock::now()).count();
+        return static_cast<int>(std::clamp<decltype(ms)>(ms, 0, std::numeric_limits<int>::max()));
+    }
+
+    void run() {
+        while (! shouldExit) {
+            std::array<::pollfd, 4> pfds = {{{wakeRead, POLLIN, 0}, {sock4, POLLIN, 0}, {sock6, POLLIN, 0}, {inotifyFd, POLLIN, 0}}};
+            ::poll(pfds.data(), pfds.size(), pollTimeout());
+
+            if ((pfds[0].revents & POLLIN) != 0) {
+                char drain[64];
+                while (::read(wakeRead, drain, sizeof(drain)) > 0) {}
+            }
+
+            if ((pfds[3].revents & POLLIN) != 0) {
+                handleHostsChange();
+            }
+
+            for (auto const& pfd : {pfds[1], pfds[2]}) {
+                if ((pfd.revents & POLLIN) != 0) {
+                    receive(pfd.fd);
+                }
+            }
+
+            std::vector<std::shared_ptr<Lookup>> started;
+            {
+                std::lock_guard<std::mutex> lock(queueMutex);
+                std::swap(started, queue);
+            }
+
+            for (auto& lookup : started) {
+                start(std::move(lookup));
+            }
+
+            handleTimeouts();
+        }
+
+        // fail everything that is still pending
+        for (auto& [_, query] : outstanding) {
+            if (query.lookup->pending > 0) {
+                query.lookup->pending = 1;
+                query.lookup->failed = true;
+                complete(*query.lookup);
+            }
+        }
+
+        // finish() takes inflightMutex, which resolve() takes before queueMutex
+        std::vector<std::shared_ptr<Lookup>> unstarted;
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            std::swap(unstarted, queue);
+        }
+
+        for (auto& lookup : unstarted) {
+            lookup->failed = true;
+            finish(*lookup);
+        }
+    }
+
+    //===============================================================
+    Options options;
+
+    mutable std::shared_mutex hostsMutex;
+    HostsMap hosts;
+    std::string hostsBasename;
+
+    std::array<Shard, kNumCacheShards> cache;
+
+    std::mutex inflightMutex;
+    std::unordered_map<std::string, std::shared_future<Result>> inflight;
+
+    std::mutex queueMutex;
+    std::vector<std::shared_ptr<Lookup>> queue;
+
+    // only accessed by the worker thread
+    std::unordered_map<std::uint16_t, Query> outstanding;
+    std::mt19937 rng = std::mt19937(std::random_device()());
+
+    int wakeRead = -1, wakeWrite = -1, sock4 = -1, sock6 = -1, inotifyFd = -1;
+    std::atomic<bool> shouldExit = false;
+    std::thread worker;
+};
+
+//===============================================================
+Resolver::Resolver() : Resolver(Options()) {}
+Resolver::Resolver(Options options) : impl(std::make_unique<Impl>(std::move(options))) {}
+Resolver::~Resolver() = default;
+
+std::shared_future<std::vector<NetworkAddress>> Resolver::resolve(std::string const& hostname, NetworkAddress::Family family) {
+    return impl->resolve(hostname, family);
+}
+
+void Resolver::flush() { impl->flush(); }
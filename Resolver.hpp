@@ -0,0 +1,107 @@
+//
+//  Resolver.hpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+#pragma once
+#include <chrono>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "NetworkAddress.hpp"
+
+/**
+ * @class Resolver
+ * @brief Asynchronous, in-process hostname resolver.
+ *
+ * Hostnames are looked up in the hosts file first and then via UDP DNS
+ * queries to the configured name servers. Results are kept in a sharded
+ * TTL cache (including negative results) and concurrent lookups for the
+ * same name and family are coalesced into a single set of DNS queries.
+ *
+ * All network I/O happens on a single background thread owned by the
+ * Resolver. The hosts file is parsed once and re-read when it changes
+ * (Linux only, via inotify).
+ */
+class Resolver
+{
+public:
+    //===============================================================
+    /**
+     * @struct Options
+     * @brief Configuration of a Resolver.
+     */
+    struct Options
+    {
+        /** Name servers to query. If empty, the nameserver entries of
+            /etc/resolv.conf are used. A port of zero means port 53. */
+        std::vector<NetworkAddress> servers = {};
+
+        /** Path to the hosts file. An empty path disables the hosts lookup. */
+        std::string hostsFile = "/etc/hosts";
+
+        /** Time to wait for a reply before trying the next server. */
+        std::chrono::milliseconds timeout = std::chrono::milliseconds(2000);
+
+        /** Number of times every server is tried. */
+        unsigned attempts = 2;
+
+        /** How long a name which does not exist is remembered. */
+        std::chrono::seconds negativeTTL = std::chrono::seconds(30);
+
+        /** Upper bound for TTLs received from name servers. */
+        std::chrono::seconds maxTTL = std::chrono::seconds(3600);
+    };
+
+    //===============================================================
+    /**
+     * @brief Creates a resolver using the system configuration.
+     */
+    Resolver();
+
+    /**
+     * @brief Creates a resolver with the given options.
+     *
+     * @param options The resolver configuration.
+     */
+    explicit Resolver(Options options);
+
+    ~Resolver();
+
+    //===============================================================
+    /**
+     * @brief Resolves a hostname asynchronously.
+     *
+     * IP address literals are returned immediately without any lookup. If
+     * the name cannot be resolved the resulting vector is empty. All
+     * returned addresses have a port of zero. DNS over TCP is not
+     * supported, so a truncated reply fails its query like a timeout.
+     *
+     * @param hostname The hostname to resolve.
+     * @param family Family::ipv4 or Family::ipv6 to restrict the lookup to
+     *        A or AAAA records. Family::unspecified queries both.
+     * @return A future to the resolved addresses.
+     */
+    std::shared_future<std::vector<NetworkAddress>> resolve(std::string const& hostname,
+                                                            NetworkAddress::Family family = NetworkAddress::Family::unspecified);
+
+    /**
+     * @brief Removes all entries from the cache.
+     */
+    void flush();
+
+    //===============================================================
+    Resolver(Resolver const&) = delete;
+    Resolver& operator=(Resolver const&) = delete;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl;
+};
@@ -0,0 +1,257 @@
+//
+//  Resolver_test.cpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <thread>
+
+#include <poll.h>
+#include <unistd.h>
+#include <netinet/in.h>
+
+#include "Resolver.hpp"
+
+namespace
+{
+// A minimal DNS server on the loopback interface answering A queries
+// from a fixed table and NXDOMAIN for everything else.
+class StubDNSServer
+{
+public:
+    StubDNSServer(std::map<std::string, NetworkAddress> _records, std::chrono::milliseconds _delay = {},
+                  bool replyFromOtherPort = false, bool _truncate = false)
+        : records(std::move(_records)), delay(_delay), truncate(_truncate) {
+        fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+        auto const bindAddr = NetworkAddress(127, 0, 0, 1);
+        ::bind(fd, &bindAddr.socket(), bindAddr.socketLength());
+
+        // replies sent from another socket, as a spoofing attacker would
+        if (replyFromOtherPort) {
+            replyFd = ::socket(AF_INET, SOCK_DGRAM, 0);
+            ::bind(replyFd, &bindAddr.socket(), bindAddr.socketLength());
+        }
+
+        ::sockaddr_storage local = {};
+        ::socklen_t len = sizeof(local);
+        ::getsockname(fd, reinterpret_cast<::sockaddr*>(&local), &len);
+        address = NetworkAddress::fromPOSIXSocketAddress(*reinterpret_cast<::sockaddr*>(&local), len);
+
+        thread = std::thread([this] { run(); });
+    }
+
+    ~StubDNSServer() {
+        shouldExit = true;
+        thread.join();
+        ::close(fd);
+
+        if (replyFd >= 0) {
+            ::close(replyFd);
+        }
+    }
+
+    NetworkAddress address;
+    std::atomic<int> queries = 0;
+
+private:
+    void run() {
+        while (! shouldExit) {
+            ::pollfd pfd = {fd, POLLIN, 0};
+            if (::poll(&pfd, 1, 10) <= 0) {
+                continue;
+            }
+
+            std::uint8_t packet[512];
+            ::sockaddr_storage from = {};
+            ::socklen_t fromlen = sizeof(from);
+            auto const n = ::recvfrom(fd, packet, sizeof(packet), 0, reinterpret_cast<::sockaddr*>(&from), &fromlen);
+
+            if (n < 17) {
+                continue;
+            }
+
+            ++queries;
+            std::this_thread::sleep_for(delay);
+
+            // decode the question name
+            std::string name;
+            std::size_t pos = 12;
+            while (pos < static_cast<std::size_t>(n) && packet[pos] != 0) {
+                if (! name.empty()) {
+                    name.push_back('.');
+                }
+
+                name.append(reinterpret_cast<char const*>(packet + pos + 1), packet[pos]);
+                pos += 1u + packet[pos];
+            }
+
+            auto const qtype = (packet[pos + 1] << 8) | packet[pos + 2];
+            auto const questionEnd = pos + 5;
+
+            std::vector<std::uint8_t> reply(packet, packet + questionEnd);
+            reply[2] = 0x81; reply[3] = 0x80; // response, recursion available
+            if (truncate) {
+                reply[2] |= 0x02;
+            }
+            reply[6] = reply[7] = reply[8] = reply[9] = reply[10] = reply[11] = 0;
+
+            if (auto it = records.find(name); it == records.end()) {
+                reply[3] |= 3; // NXDOMAIN
+            } else if (qtype == 1) {
+                reply[7] = 1;
+                auto const ip = it->second.get_sin_addr();
+                std::uint8_t const rr[] = {0xc0, 12, 0, 1, 0, 1, 0, 0, 0, 60, 0, 4};
+                reply.insert(reply.end(), std::begin(rr), std::end(rr));
+                reply.insert(reply.end(), reinterpret_cast<std::uint8_t const*>(&ip), reinterpret_cast<std::uint8_t const*>(&ip) + 4);
+            }
+
+            ::sendto(replyFd >= 0 ? replyFd : fd, reply.data(), reply.size(), 0, reinterpret_cast<::sockaddr*>(&from), fromlen);
+        }
+    }
+
+    std::map<std::string, NetworkAddress> records;
+    std::chrono::milliseconds delay;
+    bool truncate;
+    int fd = -1, replyFd = -1;
+    std::atomic<bool> shouldExit = false;
+    std::thread thread;
+};
+
+std::string writeHostsFile(std::string const& contents) {
+    static int counter = 0;
+    auto path = "/tmp/cxxnetaddr_hosts_" + std::to_string(::getpid()) + "_" + std::to_string(counter++);
+    std::ofstream(path) << contents;
+    return path;
+}
+}
+
+// Test that IP literals are returned without any lookup
+TEST(ResolverTest, ResolvesIPLiterals) {
+    Resolver resolver(Resolver::Options { .servers = {}, .hostsFile = {} });
+    auto const result = resolver.resolve("192.168.1.1").get();
+    ASSERT_EQ(result.size(), 1u);
+    EXPECT_EQ(result[0], NetworkAddress(192, 168, 1, 1));
+
+    EXPECT_TRUE(resolver.resolve("192.168.1.1", NetworkAddress::Family::ipv6).get().empty());
+}
+
+// Test that names from the hosts file are resolved
+TEST(ResolverTest, ResolvesFromHostsFile) {
+    auto const path = writeHostsFile("# comment\n10.0.0.1 myhost MyAlias\n::1 myhost\n");
+    StubDNSServer server({});
+    Resolver resolver(Resolver::Options { .servers = {server.address}, .hostsFile = path });
+
+    EXPECT_EQ(resolver.resolve("myhost").get().size(), 2u);
+    EXPECT_EQ(resolver.resolve("myalias", NetworkAddress::Family::ipv4).get(), std::vector<NetworkAddress> {NetworkAddress(10, 0, 0, 1)});
+    EXPECT_EQ(resolver.resolve("MYHOST", NetworkAddress::Family::ipv6).get().size(), 1u);
+    EXPECT_TRUE(resolver.resolve("unknown").get().empty());
+    EXPECT_EQ(server.queries, 2);
+
+    std::remove(path.c_str());
+}
+
+#if __linux__
+// Test that changes to the hosts file are picked up
+TEST(ResolverTest, ReloadsChangedHostsFile) {
+    auto const path = writeHostsFile("10.0.0.1 before\n");
+    StubDNSServer server({});
+    Resolver resolver(Resolver::Options { .servers = {server.address}, .hostsFile = path });
+    EXPECT_EQ(resolver.resolve("before").get().size(), 1u);
+
+    std::ofstream(path) << "10.0.0.2 after\n";
+
+    auto found = false;
+    for (int i = 0; i < 200 && ! found; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        found = resolver.resolve("after").get().size() == 1u;
+    }
+
+    EXPECT_TRUE(found);
+    std::remove(path.c_str());
+}
+#endif
+
+// Test resolving via DNS including the positive cache
+TEST(ResolverTest, ResolvesViaDNSAndCaches) {
+    StubDNSServer server({{"example.test", NetworkAddress(10, 1, 2, 3)}});
+    Resolver resolver(Resolver::Options { .servers = {server.address}, .hostsFile = {} });
+
+    auto const result = resolver.resolve("example.test", NetworkAddress::Family::ipv4).get();
+    ASSERT_EQ(result.size(), 1u);
+    EXPECT_EQ(result[0], NetworkAddress(10, 1, 2, 3));
+    EXPECT_EQ(server.queries, 1);
+
+    EXPECT_EQ(resolver.resolve("Example.Test.", NetworkAddress::Family::ipv4).get(), result);
+    EXPECT_EQ(server.queries, 1);
+
+    resolver.flush();
+    EXPECT_EQ(resolver.resolve("example.test", NetworkAddress::Family::ipv4).get(), result);
+    EXPECT_EQ(server.queries, 2);
+}
+
+// Test that non-existent names are cached as well
+TEST(ResolverTest, CachesNegativeResults) {
+    StubDNSServer server({});
+    Resolver resolver(Resolver::Options { .servers = {server.address}, .hostsFile = {} });
+
+    EXPECT_TRUE(resolver.resolve("nothing.test").get().empty());
+    EXPECT_EQ(server.queries, 2); // A and AAAA
+    EXPECT_TRUE(resolver.resolve("nothing.test").get().empty());
+    EXPECT_EQ(server.queries, 2);
+}
+
+// Test that concurrent identical lookups result in a single query
+TEST(ResolverTest, CoalescesConcurrentQueries) {
+    StubDNSServer server({{"slow.test", NetworkAddress(10, 9, 8, 7)}}, std::chrono::milliseconds(100));
+    Resolver resolver(Resolver::Options { .servers = {server.address}, .hostsFile = {} });
+
+    std::vector<std::shared_future<std::vector<NetworkAddress>>> futures;
+    for (int i = 0; i < 16; ++i) {
+        futures.emplace_back(resolver.resolve("slow.test", NetworkAddress::Family::ipv4));
+    }
+
+    for (auto& f : futures) {
+        ASSERT_EQ(f.get().size(), 1u);
+        EXPECT_EQ(f.get()[0], NetworkAddress(10, 9, 8, 7));
+    }
+
+    EXPECT_EQ(server.queries, 1);
+}
+
+// Test that an unreachable server yields an empty result after the timeout
+TEST(ResolverTest, TimesOutWithoutReply) {
+    StubDNSServer server({}, std::chrono::milliseconds(500));
+    Resolver resolver(Resolver::Options { .servers = {server.address}, .hostsFile = {},
+                                          .timeout = std::chrono::milliseconds(50), .attempts = 1 });
+
+    EXPECT_TRUE(resolver.resolve("late.test", NetworkAddress::Family::ipv4).get().empty());
+}
+
+// Test that replies from other addresses than the queried server are ignored
+TEST(ResolverTest, IgnoresRepliesFromOtherAddresses) {
+    StubDNSServer server({{"spoofed.test", NetworkAddress(10, 6, 6, 6)}}, {}, true);
+    Resolver resolver(Resolver::Options { .servers = {server.address}, .hostsFile = {},
+                                          .timeout = std::chrono::milliseconds(100), .attempts = 1 });
+
+    EXPECT_TRUE(resolver.resolve("spoofed.test", NetworkAddress::Family::ipv4).get().empty());
+    EXPECT_EQ(server.queries, 1);
+}
+
+// Test that truncated replies fail the lookup and are not cached
+TEST(ResolverTest, FailsOnTruncatedReply) {
+    StubDNSServer server({{"big.test", NetworkAddress(10, 7, 7, 7)}}, {}, false, true);
+    Resolver resolver(Resolver::Options { .servers = {server.address}, .hostsFile = {} });
+
+    EXPECT_TRUE(resolver.resolve("big.test", NetworkAddress::Family::ipv4).get().empty());
+    EXPECT_TRUE(resolver.resolve("big.test", NetworkAddress::Family::ipv4).get().empty());
+    EXPECT_EQ(server.queries, 2);
+}
@@ -0,0 +1,476 @@
+//
+//  SourceNat.cpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+#include "AddressLog.hpp"
+#include "ExpiringAddressMap.hpp"
+#include "SourceNat.hpp"
+
+namespace
+{
+// the fields of a CompactAddress identifying an endpoint
+struct Endpoint
+{
+    std::array<std::uint8_t, 16> bytes = {};
+    std::uint32_t scopeId = 0;
+    std::uint16_t port = 0;
+    std::uint8_t family = 0;
+    std::uint8_t reserved = 0;
+
+    static Endpoint fromAddress(NetworkAddress const& addr, bool withPort) noexcept {
+        auto const compact = CompactAddress::fromAddress(addr);
+        return Endpoint { compact.bytes, compact.scopeId, withPort ? compact.port : std::uint16_t(0), compact.family, 0 };
+    }
+
+    NetworkAddress toAddress() const {
+        CompactAddress compact = {};
+        compact.bytes = bytes;
+        compact.scopeId = scopeId;
+        compact.port = port;
+        compact.family = family;
+        return compact.toAddress();
+    }
+
+    bool operator==(Endpoint const&) const = default;
+};
+
+// the internal endpoint and, with address-dependent mapping, the remote address
+struct Flow
+{
+    Endpoint internal;
+    Endpoint remote;
+
+    bool operator==(Flow const&) const = default;
+};
+
+static_assert(std::has_unique_object_representations_v<Flow>);
+
+struct FlowHash
+{
+    std::size_t operator()(Flow const& flow) const noexcept {
+        std::uint64_t words[sizeof(Flow) / sizeof(std::uint64_t)];
+        std::memcpy(words, &flow, sizeof(words));
+        std::uint64_t h = 0;
+
+        for (auto const word : words) {
+            h = (std::rotl(h, 27) ^ word) * 0x9e3779b97f4a7c15ull;
+        }
+
+        h = (h ^ (h >> 33)) * 0xff51afd7ed558ccdull;
+        return static_cast<std::size_t>(h ^ (h >> 33));
+    }
+};
+
+struct External
+{
+    std::uint32_t addressIndex;
+    std::uint16_t port;
+};
+
+struct Binding
+{
+    Flow flow;
+    std::uint32_t addressIndex = 0;
+    bool spilled = false;  // mapped by another shard than the flow's own
+};
+
+//===============================================================
+constexpr std::size_t kNotFound = SIZE_MAX;
+
+// the index of the first set bit at or after from
+std::size_t findSet(std::vector<std::uint64_t> const& bits, std::size_t from) noexcept {
+    for (auto word = from / 64; word < bits.size(); ++word) {
+        auto value = bits[word];
+
+        if (word == from / 64) {
+            value &= ~std::uint64_t(0) << (from % 64);
+        }
+
+        if (value != 0) {
+            return word * 64 + static_cast<std::size_t>(std::countr_zero(value));
+        }
+    }
+
+    return kNotFound;
+}
+
+// The free ports of a slice: a bit per port, and a summary bit per word of
+// ports that has a free port. Allocation continues after the last allocated
+// word and wraps around, so released ports are not reused right away.
+class PortBitmap
+{
+public:
+    PortBitmap(std::uint16_t first, std::size_t count)
+        : firstPort(first), ports((count + 63) / 64), summary((ports.size() + 63) / 64) {
+        for (std::size_t i = 0; i < count; ++i) {
+            ports[i / 64] |= std::uint64_t(1) << (i % 64);
+        }
+
+        for (std::size_t word = 0; word < ports.size(); ++word) {
+            summary[word / 64] |= std::uint64_t(1) << (word % 64);
+        }
+    }
+
+    std::optional<std::uint16_t> allocate() noexcept {
+        auto word = findSet(summary, cursor);
+
+        if (word == kNotFound) {
+            word = findSet(summary, 0);
+
+            if (word == kNotFound) {
+                return {};
+            }
+        }
+
+        auto& bits = ports[word];
+        auto const bit = static_cast<std::size_t>(std::countr_zero(bits));
+        bits &= bits - 1;
+
+        if (bits == 0) {
+            summary[word / 64] &= ~(std::uint64_t(1) << (word % 64));
+        }
+
+        cursor = word;
+        return static_cast<std::uint16_t>(firstPort + word * 64 + bit);
+    }
+
+    void free(std::uint16_t port) noexcept {
+        auto const i = static_cast<std::size_t>(port - firstPort);
+        ports[i / 64] |= std::uint64_t(1) << (i % 64);
+        summary[i / 4096] |= std::uint64_t(1) << ((i / 64) % 64);
+    }
+
+private:
+    std::uint16_t firstPort;
+    std::vector<std::uint64_t> ports, summary;
+    std::size_t cursor = 0;
+};
+
+bool isIP(NetworkAddress const& addr) noexcept {
+    return addr.family() == NetworkAddress::Family::ipv4 || addr.family() == NetworkAddress::Family::ipv6;
+}
+}
+
+//===============================================================
+struct SourceNat::Shard
+{
+    Shard(SourceNat& owner, std::uint16_t firstPort, std::size_t ports)
+        : nat(owner),
+          timers(std::max(std::size_t(1), ports * owner.externals.size())),
+          bitmaps(owner.externals.size(), PortBitmap(firstPort, ports)) {}
+
+    // the external endpoint of the flow's mapping, which is refreshed
+    std::optional<NetworkAddress> refresh(Flow const& flow) {
+        auto const it = forward.find(flow);
+
+        if (it == forward.end()) {
+            return {};
+        }
+
+        auto external = nat.externals[it->second.addressIndex].withPort(it->second.port);
+        timers.refresh(external, nat.config.timeout);
+        return external;
+    }
+
+    // maps the flow to a free port of the external address
+    std::optional<NetworkAddress> map(Flow const& flow, std::uint32_t addressIndex, bool spilled) {
+        auto const port = bitmaps[addressIndex].allocate();
+
+        if (! port) {
+            return {};
+        }
+
+        auto external = nat.externals[addressIndex].withPort(*port);
+        timers.insert(external, Binding { flow, addressIndex, spilled }, nat.config.timeout);
+        forward.emplace(flow, External { addressIndex, *port });
+        ++stats.created;
+
+        if (spilled) {
+            nat.spilled.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        return external;
+    }
+
+    bool release(Flow const& flow) {
+        auto const it = forward.find(flow);
+
+        if (it == forward.end()) {
+            return false;
+        }
+
+        auto const external = nat.externals[it->second.addressIndex].withPort(it->second.port);
+        auto const binding = *timers.find(external);
+        timers.erase(external);
+        unmap(binding, external.port());
+        return true;
+    }
+
+    void unmap(Binding const& binding, std::uint16_t port) {
+        forward.erase(binding.flow);
+        bitmaps[binding.addressIndex].free(port);
+
+        if (binding.spilled) {
+            nat.spilled.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    std::size_t advance(Ticks now) {
+        if (now <= timers.now()) {
+            return 0;
+        }
+
+        auto const expired = timers.advance(now, [this] (std::span<ExpiringAddressMap<Binding>::Expired> batch) {
+            for (auto const& e : batch) {
+                unmap(e.value, e.address.port);
+            }
+        });
+
+        stats.expired += expired;
+        return expired;
+    }
+
+    SourceNat& nat;
+    std::mutex lock;
+    ExpiringAddressMap<Binding> timers;  // keyed by the external endpoint
+    std::unordered_map<Flow, External, FlowHash> forward;
+    std::vector<PortBitmap> bitmaps;     // of each external address
+    Stats stats;
+};
+
+//===============================================================
+SourceNat::SourceNat(std::vector<NetworkAddress> const& externalAddresses)
+    : SourceNat(externalAddresses, Options()) {}
+
+SourceNat::SourceNat(std::vector<NetworkAddress> const& externalAddresses, Options const& options)
+    : config(options) {
+    for (auto const family : {NetworkAddress::Family::ipv4, NetworkAddress::Family::ipv6}) {
+        for (auto const& addr : externalAddresses) {
+            if (addr.family() == family) {
+                externals.push_back(addr.withPort(0));
+            }
+        }
+    }
+
+    numIPv4 = static_cast<std::size_t>(std::count_if(externals.begin(), externals.end(),
+                                                     [] (auto const& addr) { return addr.family() == NetworkAddress::Family::ipv4; }));
+
+    config.lastPort = std::max(config.firstPort, config.lastPort);
+    auto const ports = static_cast<std::size_t>(config.lastPort - config.firstPort) + 1;
+    auto const numShards = std::clamp(config.shards, std::size_t(1), ports);
+    sliceSize = (ports + numShards - 1) / numShards;
+
+    for (std::size_t first = 0; first < ports; first += sliceSize) {
+        shards.push_back(std::make_unique<Shard>(*this, static_cast<std::uint16_t>(config.firstPort + first),
+                                                 std::min(sliceSize, ports - first)));
+    }
+}
+
+SourceNat::~SourceNat() = default;
+
+SourceNat::Shard* SourceNat::shardOfPort(std::uint16_t port) const noexcept {
+    if (port < config.firstPort || port > config.lastPort) {
+        return nullptr;
+    }
+
+    return shards[static_cast<std::size_t>(port - config.firstPort) / sliceSize].get();
+}
+
+//===============================================================
+std::optional<NetworkAddress> SourceNat::outbound(NetworkAddress const& internal, NetworkAddress const& remote, Ticks now) {
+    if (! isIP(internal)) {
+        return {};
+    }
+
+    Flow flow { Endpoint::fromAddress(internal, true), {} };
+
+    if (config.mapping == Mapping::addressDependent) {
+        flow.remote = Endpoint::fromAddress(remote, false);
+    }
+
+    // paired pooling: the same external address for all endpoints of a host
+    auto const isIPv4 = internal.family() == NetworkAddress::Family::ipv4;
+    auto const first = isIPv4 ? std::size_t(0) : numIPv4;
+    auto const count = isIPv4 ? numIPv4 : externals.size() - numIPv4;
+
+    if (count == 0) {
+        return {};
+    }
+
+    auto const addressIndex = static_cast<std::uint32_t>(first + FlowHash()(Flow { Endpoint::fromAddress(internal, false), {} }) % count);
+    auto const home = FlowHash()(flow) % shards.size();
+
+    {
+        auto& shard = *shards[home];
+        std::lock_guard guard(shard.lock);
+        shard.advance(now);
+
+        if (auto external = shard.refresh(flow)) {
+            return external;
+        }
+
+        // without spilled flows no other shard can have a mapping of the flow
+        if (spilled.load(std::memory_order_relaxed) == 0) {
+            if (auto external = shard.map(flow, addressIndex, false)) {
+                return external;
+            }
+        }
+    }
+
+    // Search all shards, starting with the flow's own. It stays locked so
+    // that no other thread maps the flow meanwhile; the other shards are
+    // locked one at a time, and only by the thread holding spillLock.
+    std::lock_guard spillGuard(spillLock);
+    std::lock_guard homeGuard(shards[home]->lock);
+
+    auto const forEachShard = [this, home, now] (auto&& fn) -> std::optional<NetworkAddress> {
+        for (std::size_t i = 0; i < shards.size(); ++i) {
+            auto& shard = *shards[(home + i) % shards.size()];
+            std::unique_lock guard(shard.lock, std::defer_lock);
+
+            if (i != 0) {
+                guard.lock();
+            }
+
+            shard.advance(now);
+
+            if (auto external = fn(shard, i != 0)) {
+                return external;
+            }
+        }
+
+        return {};
+    };
+
+    if (spilled.load(std::memory_order_relaxed) != 0) {
+        if (auto external = forEachShard([&flow] (Shard& shard, bool) { return shard.refresh(flow); })) {
+            return external;
+        }
+    }
+
+    if (auto external = forEachShard([&flow, addressIndex] (Shard& shard, bool spill) { return shard.map(flow, addressIndex, spill); })) {
+        return external;
+    }
+
+    ++shards[home]->stats.exhausted;
+    return {};
+}
+
+std::optional<NetworkAddress> SourceNat::inbound(NetworkAddress const& external, NetworkAddress const& remote, Ticks now) {
+    if (! isIP(external)) {
+        return {};
+    }
+
+    auto* shard = shardOfPort(external.port());
+
+    if (shard == nullptr) {
+        return {};
+    }
+
+    std::lock_guard guard(shard->lock);
+    shard->advance(now);
+    auto const* binding = shard->timers.find(external);
+
+    if (binding == nullptr) {
+        return {};
+    }
+
+    if (config.mapping == Mapping::addressDependent && binding->flow.remote != Endpoint::fromAddress(remote, false)) {
+        return {};
+    }
+
+    return binding->flow.internal.toAddress();
+}
+
+bool SourceNat::release(NetworkAddress const& internal, NetworkAddress const& remote) {
+    if (! isIP(internal)) {
+        return false;
+    }
+
+    Flow flow { Endpoint::fromAddress(internal, true), {} };
+
+    if (config.mapping == Mapping::addressDependent) {
+        flow.remote = Endpoint::fromAddress(remote, false);
+    }
+
+    auto const home = FlowHash()(flow) % shards.size();
+
+    {
+        auto& shard = *shards[home];
+        std::lock_guard guard(shard.lock);
+
+        if (shard.release(flow)) {
+            return true;
+        }
+
+        if (spilled.load(std::memory_order_relaxed) == 0) {
+            return false;
+        }
+    }
+
+    std::lock_guard spillGuard(spillLock);
+
+    for (std::size_t i = 1; i < shards.size(); ++i) {
+        auto& shard = *shards[(home + i) % shards.size()];
+        std::lock_guard guard(shard.lock);
+
+        if (shard.release(flow)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+std::size_t SourceNat::expire(Ticks now) {
+    std::size_t expired = 0;
+
+    for (auto const& shard : shards) {
+        std::lock_guard guard(shard->lock);
+        expired += shard->advance(now);
+    }
+
+    return expired;
+}
+
+//===============================================================
+std::size_t SourceNat::size() const {
+    std::size_t result = 0;
+
+    for (auto const& shard : shards) {
+        std::lock_guard guard(shard->lock);
+        result += shard->timers.size();
+    }
+
+    return result;
+}
+
+std::size_t SourceNat::capacity() const noexcept {
+    return (static_cast<std::size_t>(config.lastPort - config.firstPort) + 1) * externals.size();
+}
+
+SourceNat::Stats SourceNat::stats() const {
+    Stats result;
+
+    for (auto const& shard : shards) {
+        std::lock_guard guard(shard->lock);
+        result.created   += shard->stats.created;
+        result.expired   += shard->stats.expired;
+        result.exhausted += shard->stats.exhausted;
+    }
+
+    return result;
+}
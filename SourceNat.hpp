@@ -0,0 +1,169 @@
+//
+//  SourceNat.hpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "NetworkAddress.hpp"
+
+/**
+ * @class SourceNat
+ * @brief Maps internal endpoints to ports of external addresses, as a source NAT does.
+ *
+ * Mappings are created by outbound traffic and released when no outbound
+ * traffic refreshed them for a timeout (in ticks of the caller's choosing).
+ * With endpoint-independent mapping an internal endpoint keeps its external
+ * endpoint for all remote endpoints and accepts inbound traffic from any of
+ * them; with address-dependent mapping it gets one external endpoint per
+ * remote address, which only accepts inbound traffic from that address.
+ * An internal host always uses the same external address of its family
+ * ("paired" pooling).
+ *
+ * The engine is split into shards, each with its own lock, timers and a
+ * slice of the port range of every external address: outbound traffic
+ * selects the shard by the hash of its flow, inbound traffic by the slice
+ * of its external port. When the slice of a flow's shard has no free port
+ * left, the flow is mapped by another shard instead, so that every port
+ * can be used. Free ports are kept in bitmaps.
+ *
+ * All methods are thread-safe.
+ */
+class SourceNat
+{
+public:
+    using Ticks = std::uint64_t;
+
+    /** How mappings are shared between remote endpoints (RFC 4787). */
+    enum class Mapping
+    {
+        endpointIndependent,
+        addressDependent
+    };
+
+    /**
+     * @struct Options
+     * @brief The configuration of a SourceNat.
+     */
+    struct Options
+    {
+        Mapping mapping = Mapping::endpointIndependent;
+
+        /** The range of external ports, inclusive. */
+        std::uint16_t firstPort = 1024;
+        std::uint16_t lastPort = 65535;
+
+        /** The number of ticks without outbound traffic after which a mapping is released. */
+        Ticks timeout = 300000;
+
+        /** The number of independently locked shards. */
+        std::size_t shards = 16;
+    };
+
+    /**
+     * @struct Stats
+     * @brief Counters of the mappings.
+     */
+    struct Stats
+    {
+        std::uint64_t created = 0;
+        std::uint64_t expired = 0;
+
+        /** The number of mappings which could not be created as all ports were in use. */
+        std::uint64_t exhausted = 0;
+    };
+
+    //===============================================================
+    /**
+     * @brief Creates a NAT without mappings.
+     *
+     * @param externalAddresses The IPv4 and IPv6 addresses to map to; other
+     *        families and the ports of the addresses are ignored.
+     * @param options The configuration.
+     */
+    SourceNat(std::vector<NetworkAddress> const& externalAddresses, Options const& options);
+    explicit SourceNat(std::vector<NetworkAddress> const& externalAddresses);
+    ~SourceNat();
+
+    SourceNat(SourceNat const&) = delete;
+    SourceNat& operator=(SourceNat const&) = delete;
+
+    //===============================================================
+    /**
+     * @brief Maps outbound traffic, creating or refreshing its mapping.
+     *
+     * Expired mappings of the shard are released first.
+     *
+     * @param internal The internal source endpoint.
+     * @param remote The remote destination endpoint.
+     * @param now The current time.
+     * @return The external source endpoint, or nullopt if there is no external
+     *         address of the internal endpoint's family or all ports are in use.
+     */
+    std::optional<NetworkAddress> outbound(NetworkAddress const& internal, NetworkAddress const& remote, Ticks now);
+
+    /**
+     * @brief Maps inbound traffic to the internal endpoint.
+     *
+     * Expired mappings of the shard are released first, so inbound traffic
+     * never reaches an expired mapping even if expire() is not called.
+     *
+     * @param external The external destination endpoint.
+     * @param remote The remote source endpoint.
+     * @param now The current time.
+     * @return The internal endpoint, or nullopt if there is no mapping or
+     *         its filtering does not accept the remote endpoint.
+     */
+    std::optional<NetworkAddress> inbound(NetworkAddress const& external, NetworkAddress const& remote, Ticks now);
+
+    /**
+     * @brief Releases the mapping of outbound traffic before it expires.
+     *
+     * @return False if there is no such mapping.
+     */
+    bool release(NetworkAddress const& internal, NetworkAddress const& remote);
+
+    /**
+     * @brief Releases the expired mappings of all shards.
+     *
+     * @return The number of released mappings.
+     */
+    std::size_t expire(Ticks now);
+
+    //===============================================================
+    /** The number of mappings. */
+    std::size_t size() const;
+
+    /** The maximum number of mappings: the number of external ports. */
+    std::size_t capacity() const noexcept;
+
+    /** The sums of the counters of all shards. */
+    Stats stats() const;
+
+private:
+    struct Shard;
+
+    Shard* shardOfPort(std::uint16_t port) const noexcept;
+
+    std::vector<NetworkAddress> externals;  // the IPv4 addresses first
+    std::size_t numIPv4 = 0;
+    Options config;
+    std::size_t sliceSize;
+    std::vector<std::unique_ptr<Shard>> shards;
+
+    // held while locking a second shard; the number of flows not mapped by their own shard
+    std::mutex spillLock;
+    std::atomic<std::size_t> spilled = 0;
+};
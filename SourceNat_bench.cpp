@@ -0,0 +1,88 @@
+//
+//  SourceNat_bench.cpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <memory>
+#include <thread>
+
+#include "SourceNat.hpp"
+
+namespace
+{
+int const kMaxThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+// 1000 new mappings per tick and thread with a timeout of 16 ticks keep
+// 16k mappings per thread alive, well within the 2M ports of 32 addresses
+constexpr std::uint32_t kPerTick = 1000;
+
+std::unique_ptr<SourceNat> makeNat() {
+    std::vector<NetworkAddress> externals;
+
+    for (std::uint32_t i = 1; i <= 32; ++i) {
+        externals.emplace_back(0xcb007100 + i);  // 203.0.113.i
+    }
+
+    SourceNat::Options options;
+    options.timeout = 16;
+    return std::make_unique<SourceNat>(externals, options);
+}
+
+NetworkAddress const& remote() {
+    static auto const addr = *NetworkAddress::fromIPString("198.51.100.1:443");
+    return addr;
+}
+
+// a new internal endpoint for every mapping of a thread
+NetworkAddress internal(int thread, std::uint32_t i) {
+    return NetworkAddress(0x0a000000 + (static_cast<std::uint32_t>(thread) << 16) + ((i >> 16) & 0xffff),
+                          static_cast<std::uint16_t>(i));
+}
+
+std::unique_ptr<SourceNat> shared;
+}
+
+//===============================================================
+// Creating mappings while expired ones are released
+static void BM_SourceNatCreate(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        shared = makeNat();
+    }
+
+    std::uint32_t i = 0;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(shared->outbound(internal(state.thread_index(), i), remote(), i / kPerTick));
+        ++i;
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.counters["ops_per_thread"] = benchmark::Counter(static_cast<double>(state.iterations()),
+                                                          benchmark::Counter::kIsRate | benchmark::Counter::kAvgThreads);
+}
+BENCHMARK(BM_SourceNatCreate)->ThreadRange(1, kMaxThreads)->UseRealTime();
+
+// Outbound and inbound traffic of existing mappings
+static void BM_SourceNatLookup(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        shared = makeNat();
+    }
+
+    auto const source = internal(state.thread_index(), 0);
+    auto const external = *shared->outbound(source, remote(), 0);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(shared->outbound(source, remote(), 0));
+        benchmark::DoNotOptimize(shared->inbound(external, remote(), 0));
+    }
+
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_SourceNatLookup)->ThreadRange(1, kMaxThreads)->UseRealTime();
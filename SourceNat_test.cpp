@@ -0,0 +1,220 @@
+//
+//  SourceNat_test.cpp
+//  cxxnetaddr - https://github.com/hogliux/cxxnetaddr
+//
+//  Copyright © 2026 Fielding DSP GmbH, All rights reserved.
+//
+//  Fielding DSP GmbH
+//  Jägerstr. 36
+//  14467 Potsdam, Germany
+//
+#include <gtest/gtest.h>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "SourceNat.hpp"
+
+namespace
+{
+NetworkAddress addr(char const* str) {
+    return *NetworkAddress::fromIPString(str);
+}
+
+std::vector<NetworkAddress> const& externals() {
+    static std::vector<NetworkAddress> const result { addr("203.0.113.1"), addr("203.0.113.2"), addr("2001:db8::1") };
+    return result;
+}
+}
+
+// Test that an internal endpoint keeps its external endpoint for all remote endpoints
+TEST(SourceNatTest, EndpointIndependentMapping) {
+    SourceNat nat(externals());
+
+    auto const a = nat.outbound(addr("10.0.0.1:5000"), addr("198.51.100.1:80"), 0);
+    auto const b = nat.outbound(addr("10.0.0.1:5000"), addr("198.51.100.2:443"), 0);
+    auto const c = nat.outbound(addr("10.0.0.1:5001"), addr("198.51.100.1:80"), 0);
+
+    ASSERT_TRUE(a && b && c);
+    EXPECT_EQ(*a, *b);
+    EXPECT_NE(a->port(), c->port());
+    EXPECT_EQ(a->withPort(0), c->withPort(0));  // paired pooling
+    EXPECT_EQ(a->family(), NetworkAddress::Family::ipv4);
+    EXPECT_GE(a->port(), 1024);
+    EXPECT_EQ(nat.size(), 2u);
+
+    // inbound traffic from any remote endpoint
+    EXPECT_EQ(nat.inbound(*a, addr("192.0.2.7:9999"), 0), addr("10.0.0.1:5000"));
+    EXPECT_EQ(nat.inbound(*c, addr("198.51.100.1:80"), 0), addr("10.0.0.1:5001"));
+    EXPECT_FALSE(nat.inbound(a->withPort(80), addr("198.51.100.1:80"), 0).has_value());
+
+    auto const v6 = nat.outbound(addr("[fd00::1]:5000"), addr("[2001:db8::99]:80"), 0);
+    ASSERT_TRUE(v6);
+    EXPECT_EQ(v6->withPort(0), addr("2001:db8::1"));
+    EXPECT_EQ(nat.inbound(*v6, addr("[2001:db8::99]:80"), 0), addr("[fd00::1]:5000"));
+}
+
+// Test that an internal endpoint gets an external endpoint per remote address
+TEST(SourceNatTest, AddressDependentMapping) {
+    SourceNat::Options options;
+    options.mapping = SourceNat::Mapping::addressDependent;
+    SourceNat nat(externals(), options);
+
+    auto const a = nat.outbound(addr("10.0.0.1:5000"), addr("198.51.100.1:80"), 0);
+    auto const a2 = nat.outbound(addr("10.0.0.1:5000"), addr("198.51.100.1:8080"), 0);
+    auto const b = nat.outbound(addr("10.0.0.1:5000"), addr("198.51.100.2:80"), 0);
+
+    ASSERT_TRUE(a && a2 && b);
+    EXPECT_EQ(*a, *a2);
+    EXPECT_NE(*a, *b);
+    EXPECT_EQ(nat.size(), 2u);
+
+    EXPECT_EQ(nat.inbound(*a, addr("198.51.100.1:1234"), 0), addr("10.0.0.1:5000"));
+    EXPECT_FALSE(nat.inbound(*a, addr("198.51.100.2:80"), 0).has_value());
+
+    EXPECT_TRUE(nat.release(addr("10.0.0.1:5000"), addr("198.51.100.1:80")));
+    EXPECT_FALSE(nat.release(addr("10.0.0.1:5000"), addr("198.51.100.1:80")));
+    EXPECT_FALSE(nat.inbound(*a, addr("198.51.100.1:80"), 0).has_value());
+    EXPECT_EQ(nat.size(), 1u);
+}
+
+// Test that mappings are released after the timeout unless refreshed by outbound traffic
+TEST(SourceNatTest, ReleasesAfterTimeout) {
+    SourceNat::Options options;
+    options.timeout = 100;
+    SourceNat nat(externals(), options);
+
+    auto const a = nat.outbound(addr("10.0.0.1:5000"), addr("198.51.100.1:80"), 1000);
+    auto const b = nat.outbound(addr("10.0.0.2:5000"), addr("198.51.100.1:80"), 1000);
+    ASSERT_TRUE(a && b);
+
+    EXPECT_EQ(nat.outbound(addr("10.0.0.1:5000"), addr("198.51.100.1:80"), 1050), a);
+    EXPECT_EQ(nat.expire(1099), 0u);
+    EXPECT_EQ(nat.expire(1100), 1u);
+    EXPECT_FALSE(nat.inbound(*b, addr("198.51.100.1:80"), 1100).has_value());
+    EXPECT_EQ(nat.inbound(*a, addr("198.51.100.1:80"), 1100), addr("10.0.0.1:5000"));
+    EXPECT_EQ(nat.expire(1150), 1u);
+    EXPECT_EQ(nat.size(), 0u);
+
+    auto const stats = nat.stats();
+    EXPECT_EQ(stats.created, 2u);
+    EXPECT_EQ(stats.expired, 2u);
+}
+
+// Test that inbound traffic does not reach expired mappings without a call to expire()
+TEST(SourceNatTest, InboundReleasesExpiredMappings) {
+    SourceNat::Options options;
+    options.timeout = 100;
+    SourceNat nat(externals(), options);
+
+    auto const a = nat.outbound(addr("10.0.0.1:5000"), addr("198.51.100.1:80"), 1000);
+    ASSERT_TRUE(a);
+
+    EXPECT_EQ(nat.inbound(*a, addr("198.51.100.1:80"), 1099), addr("10.0.0.1:5000"));
+    EXPECT_FALSE(nat.inbound(*a, addr("198.51.100.1:80"), 1100).has_value());
+    EXPECT_EQ(nat.size(), 0u);
+    EXPECT_EQ(nat.stats().expired, 1u);
+}
+
+// Test that every port is handed out once and that released ports are reused
+TEST(SourceNatTest, ExhaustsPorts) {
+    SourceNat::Options options;
+    options.firstPort = 40000;
+    options.lastPort = 40009;
+    options.shards = 3;
+    SourceNat nat({addr("203.0.113.1")}, options);
+    EXPECT_EQ(nat.capacity(), 10u);
+
+    std::set<std::uint16_t> ports;
+    std::vector<NetworkAddress> mapped;
+
+    for (std::uint16_t i = 0; i < 200; ++i) {
+        auto const internal = NetworkAddress(0x0a000001, static_cast<std::uint16_t>(1000 + i));
+
+        if (auto const external = nat.outbound(internal, addr("198.51.100.1:80"), 0)) {
+            EXPECT_TRUE(ports.insert(external->port()).second);
+            EXPECT_GE(external->port(), 40000);
+            EXPECT_LE(external->port(), 40009);
+            mapped.push_back(internal);
+        }
+    }
+
+    EXPECT_EQ(ports.size(), 10u);
+    EXPECT_EQ(nat.stats().exhausted, 190u);
+    EXPECT_FALSE(nat.outbound(addr("[fd00::1]:5000"), addr("[2001:db8::99]:80"), 0).has_value());
+
+    EXPECT_TRUE(nat.release(mapped.front(), addr("198.51.100.1:80")));
+    EXPECT_TRUE(nat.outbound(mapped.front(), addr("198.51.100.1:80"), 0).has_value());
+}
+
+// Test that flows use the ports of other shards once the ports of their own shard are in use
+TEST(SourceNatTest, UsesAllPortsOfAllShards) {
+    SourceNat::Options options;
+    options.firstPort = 20000;
+    options.lastPort = 20999;
+    options.shards = 16;
+    SourceNat nat({addr("203.0.113.1")}, options);
+    ASSERT_EQ(nat.capacity(), 1000u);
+
+    std::set<NetworkAddress> unique;
+    std::vector<NetworkAddress> mapped;
+
+    for (std::uint16_t i = 0; i < 1000; ++i) {
+        auto const internal = NetworkAddress(0x0a000001, static_cast<std::uint16_t>(1000 + i));
+        auto const external = nat.outbound(internal, addr("198.51.100.1:80"), 0);
+        ASSERT_TRUE(external.has_value()) << i;
+        EXPECT_TRUE(unique.insert(*external).second);
+        mapped.push_back(*external);
+    }
+
+    EXPECT_FALSE(nat.outbound(addr("10.0.0.2:1000"), addr("198.51.100.1:80"), 0).has_value());
+    EXPECT_EQ(nat.stats().exhausted, 1u);
+    EXPECT_EQ(nat.size(), 1000u);
+
+    // existing mappings are found wherever they were made
+    for (std::uint16_t i = 0; i < 1000; ++i) {
+        auto const internal = NetworkAddress(0x0a000001, static_cast<std::uint16_t>(1000 + i));
+        EXPECT_EQ(nat.outbound(internal, addr("198.51.100.2:443"), 0), mapped[i]);
+        EXPECT_EQ(nat.inbound(mapped[i], addr("198.51.100.1:80"), 0), internal);
+    }
+
+    for (std::uint16_t i = 0; i < 1000; ++i) {
+        EXPECT_TRUE(nat.release(NetworkAddress(0x0a000001, static_cast<std::uint16_t>(1000 + i)), addr("198.51.100.1:80")));
+    }
+
+    EXPECT_EQ(nat.size(), 0u);
+    EXPECT_TRUE(nat.outbound(addr("10.0.0.2:1000"), addr("198.51.100.1:80"), 0).has_value());
+}
+
+// Test mapping from several threads at once
+TEST(SourceNatTest, ConcurrentMappings) {
+    SourceNat nat(externals());
+    constexpr std::uint32_t kThreads = 4, kPerThread = 2000;
+    std::vector<std::vector<NetworkAddress>> results(kThreads);
+    std::vector<std::thread> threads;
+
+    for (std::uint32_t t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&nat, &results, t] {
+            for (std::uint32_t i = 0; i < kPerThread; ++i) {
+                results[t].push_back(*nat.outbound(NetworkAddress(0x0a000000 + t, static_cast<std::uint16_t>(1024 + i)),
+                                                   addr("198.51.100.1:80"), 0));
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    std::set<NetworkAddress> unique;
+
+    for (std::uint32_t t = 0; t < kThreads; ++t) {
+        for (std::uint32_t i = 0; i < kPerThread; ++i) {
+            unique.insert(results[t][i]);
+            EXPECT_EQ(nat.inbound(results[t][i], addr("198.51.100.1:80"), 0), NetworkAddress(0x0a000000 + t, static_cast<std::uint16_t>(1024 + i)));
+        }
+    }
+
+    EXPECT_EQ(unique.size(), kThreads * kPerThread);
+    EXPECT_EQ(nat.size(), kThreads * kPerThread);
+}